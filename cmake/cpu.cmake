@@ -10,6 +10,7 @@ if (NOT CMAKE_SYSTEM_PROCESSOR)
 endif()
 
 include(CheckCXXCompilerFlag)
+include(CheckCXXSourceCompiles)
 
 if (CMAKE_CXX_COMPILER_ID MATCHES MSVC)
     set(VAES_SUPPORTED ON)
@@ -74,6 +75,18 @@ if (ARM_TARGET AND ARM_TARGET GREATER 6)
         else()
             set(ARM8_CXX_FLAGS "-march=armv8-a")
         endif()
+
+        if (WITH_SVE)
+            set(CMAKE_REQUIRED_FLAGS "-march=armv8.2-a+sve")
+            check_cxx_source_compiles("#include <arm_sve.h>\nint main() { return (int)svcntd(); }" XMRIG_ARM_SVE)
+            unset(CMAKE_REQUIRED_FLAGS)
+        else()
+            unset(XMRIG_ARM_SVE CACHE)
+        endif()
+
+        if (XMRIG_ARM_SVE)
+            add_definitions(-DXMRIG_ARM_SVE)
+        endif()
     endif()
 endif()
 
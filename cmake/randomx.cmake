@@ -20,10 +20,13 @@ if (WITH_RANDOMX)
         src/crypto/rx/Rx.h
         src/crypto/rx/RxAlgo.h
         src/crypto/rx/RxBasicStorage.h
+        src/crypto/rx/RxBuildStats.h
         src/crypto/rx/RxCache.h
         src/crypto/rx/RxConfig.h
         src/crypto/rx/RxDataset.h
+        src/crypto/rx/RxMemoryPlan.h
         src/crypto/rx/RxQueue.h
+        src/crypto/rx/RxScrubber.h
         src/crypto/rx/RxSeed.h
         src/crypto/rx/RxVm.h
     )
@@ -49,13 +52,24 @@ if (WITH_RANDOMX)
         src/crypto/rx/Rx.cpp
         src/crypto/rx/RxAlgo.cpp
         src/crypto/rx/RxBasicStorage.cpp
+        src/crypto/rx/RxBuildStats.cpp
         src/crypto/rx/RxCache.cpp
         src/crypto/rx/RxConfig.cpp
         src/crypto/rx/RxDataset.cpp
+        src/crypto/rx/RxMemoryPlan.cpp
         src/crypto/rx/RxQueue.cpp
+        src/crypto/rx/RxScrubber.cpp
         src/crypto/rx/RxVm.cpp
     )
 
+    if (WITH_VAES)
+        list(APPEND SOURCES_CRYPTO src/crypto/randomx/aes_hash_vaes.cpp)
+
+        if (CMAKE_C_COMPILER_ID MATCHES GNU OR CMAKE_C_COMPILER_ID MATCHES Clang)
+            set_source_files_properties(src/crypto/randomx/aes_hash_vaes.cpp PROPERTIES COMPILE_FLAGS "-mavx2 -mvaes")
+        endif()
+    endif()
+
     if (WITH_ASM AND CMAKE_C_COMPILER_ID MATCHES MSVC)
         enable_language(ASM_MASM)
         list(APPEND SOURCES_CRYPTO
@@ -80,6 +94,16 @@ if (WITH_RANDOMX)
         else()
             set_property(SOURCE src/crypto/randomx/jit_compiler_a64_static.S PROPERTY LANGUAGE C)
         endif()
+
+        if (XMRIG_ARM_SVE)
+            list(APPEND SOURCES_CRYPTO src/crypto/randomx/dataset_sve.cpp)
+
+            if (XMRIG_ARM_CRYPTO)
+                set_source_files_properties(src/crypto/randomx/dataset_sve.cpp PROPERTIES COMPILE_FLAGS "-march=armv8.2-a+sve+crypto")
+            else()
+                set_source_files_properties(src/crypto/randomx/dataset_sve.cpp PROPERTIES COMPILE_FLAGS "-march=armv8.2-a+sve")
+            endif()
+        endif()
     else()
         list(APPEND SOURCES_CRYPTO
              src/crypto/randomx/jit_compiler_fallback.cpp
@@ -151,6 +175,11 @@ if (WITH_RANDOMX)
         message("-- WITH_MSR=OFF")
     endif()
 
+    if (XMRIG_OS_LINUX)
+        list(APPEND HEADERS_CRYPTO src/crypto/rx/RxHandoff.h)
+        list(APPEND SOURCES_CRYPTO src/crypto/rx/RxHandoff_linux.cpp)
+    endif()
+
     if (WITH_PROFILING)
         add_definitions(/DXMRIG_FEATURE_PROFILING)
 
@@ -0,0 +1,93 @@
+#!/bin/bash
+# RandomX self-test of an aarch64 build under qemu-aarch64
+#
+# Soft AES is forced, so every software AES variant including NEON is compared with the reference code,
+# and the RandomX test vectors run on the variant that was picked. With "sve" the SVE dataset kernel is
+# forced too and the test runs at every SVE vector length from 128 to 2048 bits, the kernel must match
+# the scalar code and be used for the cache build at each of them.
+#
+# Usage: scripts/test_aarch64_qemu.sh path/to/xmrig [sve]
+
+set -e
+
+XMRIG=$1
+SVE=$2
+QEMU=${QEMU:-qemu-aarch64}
+TIMEOUT=${TIMEOUT:-900}
+PORT=${PORT:-18080}
+WORK=$(mktemp -d)
+
+if [ ! -x "$XMRIG" ]; then
+    echo "Usage: $0 path/to/xmrig [sve]"
+    exit 1
+fi
+
+trap 'rm -rf "$WORK"' EXIT
+
+cat > "$WORK/config.json" <<EOF
+{
+    "autosave": false,
+    "colors": false,
+    "http": { "enabled": true, "host": "127.0.0.1", "port": $PORT, "restricted": true },
+    "cpu": { "huge-pages": false, "hw-aes": false, "rx": [0] },
+    "randomx": { "mode": "light", "init-avx2": 1 },
+    "log-file": "$WORK/xmrig.log"
+}
+EOF
+
+# $1 - qemu CPU model, $2 - expected dataset init variant or empty
+run() {
+    echo "=== -cpu $1"
+
+    rm -f "$WORK/xmrig.log"
+    $QEMU -cpu "$1" "$XMRIG" -c "$WORK/config.json" --bench=1M --no-color > /dev/null 2>&1 &
+    local pid=$!
+    local result=""
+
+    for _ in $(seq 1 $((TIMEOUT / 5))); do
+        sleep 5
+
+        if ! kill -0 $pid 2> /dev/null; then
+            result="exited"
+            break
+        fi
+
+        if grep -q "self-test failed\|doesn't match" "$WORK/xmrig.log" 2> /dev/null; then
+            result="failed"
+            break
+        fi
+
+        if grep -q "READY threads" "$WORK/xmrig.log" 2> /dev/null; then
+            result="ok"
+            break
+        fi
+    done
+
+    if [ "$result" = "ok" ] && [ -n "$2" ]; then
+        local variant
+        variant=$(curl -s "http://127.0.0.1:$PORT/2/backends" | python3 -c 'import json, sys; print(json.load(sys.stdin)[0]["dataset-builds"][-1]["variant"])' || true)
+
+        if [ "$variant" != "$2" ]; then
+            echo "cache was built with \"$variant\", expected \"$2\""
+            result="failed"
+        fi
+    fi
+
+    kill $pid 2> /dev/null || true
+    wait $pid 2> /dev/null || true
+
+    cat "$WORK/xmrig.log"
+
+    if [ "$result" != "ok" ]; then
+        echo "=== -cpu $1: ${result:-timeout}"
+        exit 1
+    fi
+}
+
+if [ "$SVE" = "sve" ]; then
+    for bits in 128 256 512 1024 2048; do
+        run "max,sve-default-vector-length=$((bits / 8))" sve
+    done
+else
+    run "max,sve=off"
+fi
@@ -0,0 +1,121 @@
+#!/bin/bash
+# RandomX live upgrade (dataset handoff) test
+#
+# Starts a local fake stratum pool and two miner instances with the same --randomx-handoff socket.
+# The second instance must import the dataset from the first one instead of building it, the first
+# instance must exit after the handoff and the second one must keep mining.
+#
+# Usage: ./scripts/test_handoff.sh [path/to/xmrig]
+# Requires python3 and memory for one RandomX dataset and two caches, the dataset memory is shared by both instances.
+
+set -u
+
+XMRIG=${1:-./xmrig}
+PORT=${PORT:-13380}
+THREADS=${THREADS:-1}
+DIR=$(mktemp -d)
+SOCKET="$DIR/handoff.sock"
+PIDS=""
+
+cleanup() {
+    for pid in $PIDS; do
+        kill "$pid" 2>/dev/null
+    done
+
+    wait 2>/dev/null
+    rm -rf "$DIR"
+}
+
+trap cleanup EXIT
+
+if [ ! -x "$XMRIG" ]; then
+    echo "Error: xmrig binary not found at $XMRIG"
+    exit 1
+fi
+
+# wait_for FILE PATTERN SECONDS
+wait_for() {
+    for _ in $(seq "$3"); do
+        if grep -q "$2" "$1" 2>/dev/null; then
+            return 0
+        fi
+
+        sleep 1
+    done
+
+    return 1
+}
+
+fail() {
+    echo "FAIL: $1"
+    echo "--- first instance ---"
+    cat "$DIR/a.log"
+    echo "--- second instance ---"
+    cat "$DIR/b.log" 2>/dev/null
+    exit 1
+}
+
+cat > "$DIR/pool.py" << 'EOF'
+import json, socket, sys, threading
+
+BLOB = "0707f7a4f0d605b303260816ba3f10902e1a145ac5fad3aa3af6ea44c11869dc4f853f002b2eea0000000077b206a02ca5b1d4ce6bbfdf0acac38bded34d2dcdeef95cd20cefc12f61d56101"
+JOB  = {"blob": BLOB, "job_id": "1", "target": "ffffff00", "algo": "rx/0", "height": 1000, "seed_hash": "00" * 31 + "01"}
+
+def handle(conn):
+    f = conn.makefile("rwb")
+
+    def send(obj):
+        f.write((json.dumps(obj) + "\n").encode())
+        f.flush()
+
+    for line in f:
+        msg = json.loads(line)
+        if msg.get("method") == "login":
+            send({"id": msg["id"], "jsonrpc": "2.0", "error": None, "result": {"id": "1", "job": JOB, "status": "OK"}})
+        elif msg.get("method") in ("submit", "keepalived"):
+            send({"id": msg["id"], "jsonrpc": "2.0", "error": None, "result": {"status": "OK"}})
+
+s = socket.socket()
+s.setsockopt(socket.SOL_SOCKET, socket.SO_REUSEADDR, 1)
+s.bind(("127.0.0.1", int(sys.argv[1])))
+s.listen(4)
+
+while True:
+    conn, _ = s.accept()
+    threading.Thread(target=handle, args=(conn,), daemon=True).start()
+EOF
+
+python3 "$DIR/pool.py" "$PORT" &
+PIDS="$PIDS $!"
+sleep 1
+
+ARGS="-o 127.0.0.1:$PORT -u x --threads=$THREADS --no-color --randomx-handoff=$SOCKET --randomx-mode=fast"
+
+echo "1. Starting the first instance and building the dataset..."
+"$XMRIG" $ARGS -l "$DIR/a.log" > /dev/null 2>&1 &
+A=$!
+PIDS="$PIDS $A"
+
+wait_for "$DIR/a.log" "dataset ready" 600 || fail "first instance didn't build the dataset"
+wait_for "$DIR/a.log" "accepted" 300 || fail "first instance didn't find a share"
+
+echo "2. Starting the second instance..."
+"$XMRIG" $ARGS -l "$DIR/b.log" > /dev/null 2>&1 &
+B=$!
+PIDS="$PIDS $B"
+
+wait_for "$DIR/b.log" "dataset received from running instance" 120 || fail "second instance didn't receive the dataset"
+
+for _ in $(seq 30); do
+    kill -0 "$A" 2>/dev/null || break
+    sleep 1
+done
+
+kill -0 "$A" 2>/dev/null && fail "first instance is still running"
+grep -q "dataset handed off" "$DIR/a.log" || fail "first instance exited without a handoff"
+
+wait_for "$DIR/b.log" "accepted" 300 || fail "second instance didn't find a share"
+
+echo ""
+grep "dataset received" "$DIR/b.log"
+echo "PASS"
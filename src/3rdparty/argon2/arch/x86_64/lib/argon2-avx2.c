@@ -204,6 +204,59 @@ static void fill_block(__m256i *s, const block *ref_block, block *next_block,
     }
 }
 
+static void fill_block_x2(__m256i *s0, const block *ref0, block *next0,
+                          __m256i *s1, const block *ref1, block *next1,
+                          int with_xor)
+{
+    __m256i XY0[ARGON2_HWORDS_IN_BLOCK], XY1[ARGON2_HWORDS_IN_BLOCK];
+    unsigned int i;
+
+    if (with_xor) {
+        for (i = 0; i < ARGON2_HWORDS_IN_BLOCK; i++) {
+            s0[i] = _mm256_xor_si256(
+                s0[i], _mm256_loadu_si256((const __m256i *)ref0->v + i));
+            s1[i] = _mm256_xor_si256(
+                s1[i], _mm256_loadu_si256((const __m256i *)ref1->v + i));
+            XY0[i] = _mm256_xor_si256(
+                s0[i], _mm256_loadu_si256((const __m256i *)next0->v + i));
+            XY1[i] = _mm256_xor_si256(
+                s1[i], _mm256_loadu_si256((const __m256i *)next1->v + i));
+        }
+    } else {
+        for (i = 0; i < ARGON2_HWORDS_IN_BLOCK; i++) {
+            XY0[i] = s0[i] = _mm256_xor_si256(
+                s0[i], _mm256_loadu_si256((const __m256i *)ref0->v + i));
+            XY1[i] = s1[i] = _mm256_xor_si256(
+                s1[i], _mm256_loadu_si256((const __m256i *)ref1->v + i));
+        }
+    }
+
+    for (i = 0; i < 4; ++i) {
+        BLAKE2_ROUND1(
+            s0[8 * i + 0], s0[8 * i + 1], s0[8 * i + 2], s0[8 * i + 3],
+            s0[8 * i + 4], s0[8 * i + 5], s0[8 * i + 6], s0[8 * i + 7]);
+        BLAKE2_ROUND1(
+            s1[8 * i + 0], s1[8 * i + 1], s1[8 * i + 2], s1[8 * i + 3],
+            s1[8 * i + 4], s1[8 * i + 5], s1[8 * i + 6], s1[8 * i + 7]);
+    }
+
+    for (i = 0; i < 4; ++i) {
+        BLAKE2_ROUND2(
+            s0[4 * 0 + i], s0[4 * 1 + i], s0[4 * 2 + i], s0[4 * 3 + i],
+            s0[4 * 4 + i], s0[4 * 5 + i], s0[4 * 6 + i], s0[4 * 7 + i]);
+        BLAKE2_ROUND2(
+            s1[4 * 0 + i], s1[4 * 1 + i], s1[4 * 2 + i], s1[4 * 3 + i],
+            s1[4 * 4 + i], s1[4 * 5 + i], s1[4 * 6 + i], s1[4 * 7 + i]);
+    }
+
+    for (i = 0; i < ARGON2_HWORDS_IN_BLOCK; i++) {
+        s0[i] = _mm256_xor_si256(s0[i], XY0[i]);
+        s1[i] = _mm256_xor_si256(s1[i], XY1[i]);
+        _mm256_storeu_si256((__m256i *)next0->v + i, s0[i]);
+        _mm256_storeu_si256((__m256i *)next1->v + i, s1[i]);
+    }
+}
+
 static void next_addresses(block *address_block, block *input_block)
 {
     /*Temporary zero-initialized blocks*/
@@ -323,6 +376,15 @@ void xmrig_ar2_fill_segment_avx2(const argon2_instance_t *instance, argon2_posit
     }
 }
 
+#define ARGON2_X2_VEC  __m256i
+#define ARGON2_X2_VECS ARGON2_HWORDS_IN_BLOCK
+#include "argon2-template-x2.h"
+
+void xmrig_ar2_fill_segment_x2_avx2(const argon2_instance_t *a, const argon2_instance_t *b, argon2_position_t position)
+{
+    fill_segment_x2(a, b, position);
+}
+
 
 extern int cpu_flags_has_avx2(void);
 int xmrig_ar2_check_avx2(void) { return cpu_flags_has_avx2(); }
@@ -330,6 +392,7 @@ int xmrig_ar2_check_avx2(void) { return cpu_flags_has_avx2(); }
 #else
 
 void xmrig_ar2_fill_segment_avx2(const argon2_instance_t *instance, argon2_position_t position) {}
+void xmrig_ar2_fill_segment_x2_avx2(const argon2_instance_t *a, const argon2_instance_t *b, argon2_position_t position) {}
 int xmrig_ar2_check_avx2(void) { return 0; }
 
 #endif
@@ -189,6 +189,59 @@ static void fill_block(__m512i *s, const block *ref_block, block *next_block,
     }
 }
 
+static void fill_block_x2(__m512i *s0, const block *ref0, block *next0,
+                          __m512i *s1, const block *ref1, block *next1,
+                          int with_xor)
+{
+    __m512i XY0[ARGON2_VECS_IN_BLOCK], XY1[ARGON2_VECS_IN_BLOCK];
+    unsigned int i;
+
+    if (with_xor) {
+        for (i = 0; i < ARGON2_VECS_IN_BLOCK; i++) {
+            s0[i] = _mm512_xor_si512(
+                s0[i], _mm512_loadu_si512((const __m512i *)ref0->v + i));
+            s1[i] = _mm512_xor_si512(
+                s1[i], _mm512_loadu_si512((const __m512i *)ref1->v + i));
+            XY0[i] = _mm512_xor_si512(
+                s0[i], _mm512_loadu_si512((const __m512i *)next0->v + i));
+            XY1[i] = _mm512_xor_si512(
+                s1[i], _mm512_loadu_si512((const __m512i *)next1->v + i));
+        }
+    } else {
+        for (i = 0; i < ARGON2_VECS_IN_BLOCK; i++) {
+            XY0[i] = s0[i] = _mm512_xor_si512(
+                s0[i], _mm512_loadu_si512((const __m512i *)ref0->v + i));
+            XY1[i] = s1[i] = _mm512_xor_si512(
+                s1[i], _mm512_loadu_si512((const __m512i *)ref1->v + i));
+        }
+    }
+
+    for (i = 0; i < 2; ++i) {
+        BLAKE2_ROUND1(
+            s0[8 * i + 0], s0[8 * i + 1], s0[8 * i + 2], s0[8 * i + 3],
+            s0[8 * i + 4], s0[8 * i + 5], s0[8 * i + 6], s0[8 * i + 7]);
+        BLAKE2_ROUND1(
+            s1[8 * i + 0], s1[8 * i + 1], s1[8 * i + 2], s1[8 * i + 3],
+            s1[8 * i + 4], s1[8 * i + 5], s1[8 * i + 6], s1[8 * i + 7]);
+    }
+
+    for (i = 0; i < 2; ++i) {
+        BLAKE2_ROUND2(
+            s0[2 * 0 + i], s0[2 * 1 + i], s0[2 * 2 + i], s0[2 * 3 + i],
+            s0[2 * 4 + i], s0[2 * 5 + i], s0[2 * 6 + i], s0[2 * 7 + i]);
+        BLAKE2_ROUND2(
+            s1[2 * 0 + i], s1[2 * 1 + i], s1[2 * 2 + i], s1[2 * 3 + i],
+            s1[2 * 4 + i], s1[2 * 5 + i], s1[2 * 6 + i], s1[2 * 7 + i]);
+    }
+
+    for (i = 0; i < ARGON2_VECS_IN_BLOCK; i++) {
+        s0[i] = _mm512_xor_si512(s0[i], XY0[i]);
+        s1[i] = _mm512_xor_si512(s1[i], XY1[i]);
+        _mm512_storeu_si512((__m512i *)next0->v + i, s0[i]);
+        _mm512_storeu_si512((__m512i *)next1->v + i, s1[i]);
+    }
+}
+
 static void next_addresses(block *address_block, block *input_block)
 {
     /*Temporary zero-initialized blocks*/
@@ -307,6 +360,14 @@ void xmrig_ar2_fill_segment_avx512f(const argon2_instance_t *instance, argon2_po
         }
     }
 }
+#define ARGON2_X2_VEC  __m512i
+#define ARGON2_X2_VECS ARGON2_VECS_IN_BLOCK
+#include "argon2-template-x2.h"
+
+void xmrig_ar2_fill_segment_x2_avx512f(const argon2_instance_t *a, const argon2_instance_t *b, argon2_position_t position)
+{
+    fill_segment_x2(a, b, position);
+}
 
 extern int cpu_flags_has_avx512f(void);
 int xmrig_ar2_check_avx512f(void) { return cpu_flags_has_avx512f(); }
@@ -314,6 +375,7 @@ int xmrig_ar2_check_avx512f(void) { return cpu_flags_has_avx512f(); }
 #else
 
 void xmrig_ar2_fill_segment_avx512f(const argon2_instance_t *instance, argon2_position_t position) {}
+void xmrig_ar2_fill_segment_x2_avx512f(const argon2_instance_t *a, const argon2_instance_t *b, argon2_position_t position) {}
 int xmrig_ar2_check_avx512f(void) { return 0; }
 
 #endif
@@ -0,0 +1,115 @@
+#include <string.h>
+
+#include "core.h"
+
+/*
+ * Fills the same segment of two independent instances at once.
+ *
+ * Both instances must have the same geometry (memory_blocks, passes, lanes,
+ * type and version), so the block offsets and data-independent addresses are
+ * shared and only the reference blocks differ. The includer provides
+ * ARGON2_X2_VEC, ARGON2_X2_VECS, next_addresses() and fill_block_x2(), which
+ * runs the two BLAKE2 permutations interleaved to hide their latency.
+ */
+static void fill_segment_x2(const argon2_instance_t *a, const argon2_instance_t *b,
+                            argon2_position_t position)
+{
+    const argon2_instance_t *instances[2] = { a, b };
+    block *ref_block[2], *curr_block[2];
+    block address_block, input_block;
+    uint64_t pseudo_rand, ref_index, ref_lane;
+    uint32_t prev_offset, curr_offset;
+    uint32_t starting_index, i, k;
+    ARGON2_X2_VEC state[2][ARGON2_X2_VECS];
+    int data_independent_addressing, with_xor;
+
+    data_independent_addressing = (a->type == Argon2_i) ||
+            (a->type == Argon2_id && (position.pass == 0) &&
+             (position.slice < ARGON2_SYNC_POINTS / 2));
+
+    if (data_independent_addressing) {
+        init_block_value(&input_block, 0);
+
+        input_block.v[0] = position.pass;
+        input_block.v[1] = position.lane;
+        input_block.v[2] = position.slice;
+        input_block.v[3] = a->memory_blocks;
+        input_block.v[4] = a->passes;
+        input_block.v[5] = a->type;
+    }
+
+    starting_index = 0;
+
+    if ((0 == position.pass) && (0 == position.slice)) {
+        starting_index = 2; /* we have already generated the first two blocks */
+
+        /* Don't forget to generate the first block of addresses: */
+        if (data_independent_addressing) {
+            next_addresses(&address_block, &input_block);
+        }
+    }
+
+    /* version 1.2.1 and earlier: overwrite, not XOR */
+    with_xor = !(0 == position.pass || ARGON2_VERSION_10 == a->version);
+
+    /* Offset of the current block */
+    curr_offset = position.lane * a->lane_length +
+                  position.slice * a->segment_length + starting_index;
+
+    if (0 == curr_offset % a->lane_length) {
+        /* Last block in this lane */
+        prev_offset = curr_offset + a->lane_length - 1;
+    } else {
+        /* Previous block */
+        prev_offset = curr_offset - 1;
+    }
+
+    for (k = 0; k < 2; ++k) {
+        memcpy(state[k], ((instances[k]->memory + prev_offset)->v), ARGON2_BLOCK_SIZE);
+    }
+
+    for (i = starting_index; i < a->segment_length;
+         ++i, ++curr_offset, ++prev_offset) {
+        /*1.1 Rotating prev_offset if needed */
+        if (curr_offset % a->lane_length == 1) {
+            prev_offset = curr_offset - 1;
+        }
+
+        if (data_independent_addressing && i % ARGON2_ADDRESSES_IN_BLOCK == 0) {
+            next_addresses(&address_block, &input_block);
+        }
+
+        position.index = i;
+
+        for (k = 0; k < 2; ++k) {
+            const argon2_instance_t *instance = instances[k];
+
+            /* 1.2.1 Taking pseudo-random value from the previous block */
+            if (data_independent_addressing) {
+                pseudo_rand = address_block.v[i % ARGON2_ADDRESSES_IN_BLOCK];
+            } else {
+                pseudo_rand = instance->memory[prev_offset].v[0];
+            }
+
+            /* 1.2.2 Computing the lane of the reference block */
+            ref_lane = ((pseudo_rand >> 32)) % instance->lanes;
+
+            if ((position.pass == 0) && (position.slice == 0)) {
+                /* Can not reference other lanes yet */
+                ref_lane = position.lane;
+            }
+
+            /* 1.2.3 Computing the number of possible reference block within the
+             * lane.
+             */
+            ref_index = xmrig_ar2_index_alpha(instance, &position, pseudo_rand & 0xFFFFFFFF, ref_lane == position.lane);
+
+            ref_block[k]  = instance->memory + instance->lane_length * ref_lane + ref_index;
+            curr_block[k] = instance->memory + curr_offset;
+        }
+
+        /* 2 Creating two new blocks */
+        fill_block_x2(state[0], ref_block[0], curr_block[0],
+                      state[1], ref_block[1], curr_block[1], with_xor);
+    }
+}
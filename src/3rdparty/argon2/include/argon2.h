@@ -316,6 +316,21 @@ ARGON2_PUBLIC int argon2id_hash_raw_ex(const uint32_t t_cost,
                                        const size_t hashlen,
                                        void *memory);
 
+/* maximum number of hashes computed at once by argon2id_hash_raw_ex_multi: */
+#define ARGON2_MAX_MULTI 8
+
+/**
+ * Hashes @count independent single-lane inputs with the same parameters at
+ * once, interleaving them two at a time when the selected implementation
+ * supports it. Each input needs its own preallocated memory of m_cost KiB.
+ */
+ARGON2_PUBLIC int argon2id_hash_raw_ex_multi(const uint32_t t_cost,
+                                             const uint32_t m_cost,
+                                             const void *const *pwd, const size_t pwdlen,
+                                             const void *const *salt, const size_t saltlen,
+                                             void *const *hash, const size_t hashlen,
+                                             void *const *memory, const size_t count);
+
 /* generic function underlying the above ones */
 ARGON2_PUBLIC int argon2_hash(const uint32_t t_cost, const uint32_t m_cost,
                               const uint32_t parallelism, const void *pwd,
@@ -458,6 +473,14 @@ ARGON2_PUBLIC size_t argon2_memory_size(uint32_t m_cost, uint32_t parallelism);
 ARGON2_PUBLIC int argon2_ctx_mem(argon2_context *context, argon2_type type,
                                  void *memory, size_t memory_size);
 
+/**
+ * Same as argon2_ctx_mem, but for @count independent single-lane contexts
+ * with the same parameters, each with its own preallocated memory
+ */
+ARGON2_PUBLIC int argon2_ctx_mem_multi(argon2_context *contexts, argon2_type type,
+                                       void *const *memory, size_t memory_size,
+                                       size_t count);
+
 #if defined(__cplusplus)
 }
 #endif
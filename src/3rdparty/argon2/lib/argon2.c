@@ -54,12 +54,12 @@ size_t argon2_memory_size(uint32_t m_cost, uint32_t parallelism) {
     return memory_blocks * ARGON2_BLOCK_SIZE;
 }
 
-int argon2_ctx_mem(argon2_context *context, argon2_type type, void *memory,
-                   size_t memory_size) {
+static int argon2_init_instance(argon2_context *context, argon2_type type,
+                                void *memory, size_t memory_size,
+                                argon2_instance_t *instance) {
     /* 1. Validate all inputs */
     int result = xmrig_ar2_validate_inputs(context);
     uint32_t memory_blocks, segment_length;
-    argon2_instance_t instance;
 
     if (ARGON2_OK != result) {
         return result;
@@ -79,26 +79,32 @@ int argon2_ctx_mem(argon2_context *context, argon2_type type, void *memory,
         return ARGON2_MEMORY_ALLOCATION_ERROR;
     }
 
-    instance.version = context->version;
-    instance.memory = (block *)memory;
-    instance.passes = context->t_cost;
-    instance.memory_blocks = memory_blocks;
-    instance.segment_length = segment_length;
-    instance.lane_length = segment_length * ARGON2_SYNC_POINTS;
-    instance.lanes = context->lanes;
-    instance.threads = context->threads;
-    instance.type = type;
-    instance.print_internals = !!(context->flags & ARGON2_FLAG_GENKAT);
-    instance.keep_memory = memory != NULL;
-
-    if (instance.threads > instance.lanes) {
-        instance.threads = instance.lanes;
+    instance->version = context->version;
+    instance->memory = (block *)memory;
+    instance->passes = context->t_cost;
+    instance->memory_blocks = memory_blocks;
+    instance->segment_length = segment_length;
+    instance->lane_length = segment_length * ARGON2_SYNC_POINTS;
+    instance->lanes = context->lanes;
+    instance->threads = context->threads;
+    instance->type = type;
+    instance->print_internals = !!(context->flags & ARGON2_FLAG_GENKAT);
+    instance->keep_memory = memory != NULL;
+
+    if (instance->threads > instance->lanes) {
+        instance->threads = instance->lanes;
     }
 
     /* 3. Initialization: Hashing inputs, allocating memory, filling first
      * blocks
      */
-    result = xmrig_ar2_initialize(&instance, context);
+    return xmrig_ar2_initialize(instance, context);
+}
+
+int argon2_ctx_mem(argon2_context *context, argon2_type type, void *memory,
+                   size_t memory_size) {
+    argon2_instance_t instance;
+    int result = argon2_init_instance(context, type, memory, memory_size, &instance);
 
     if (ARGON2_OK != result) {
         return result;
@@ -116,6 +122,40 @@ int argon2_ctx_mem(argon2_context *context, argon2_type type, void *memory,
     return ARGON2_OK;
 }
 
+int argon2_ctx_mem_multi(argon2_context *contexts, argon2_type type,
+                         void *const *memory, size_t memory_size,
+                         size_t count) {
+    argon2_instance_t instances[ARGON2_MAX_MULTI];
+    size_t i;
+    int result;
+
+    if (count == 0 || count > ARGON2_MAX_MULTI) {
+        return ARGON2_INCORRECT_PARAMETER;
+    }
+
+    for (i = 0; i < count; ++i) {
+        if (memory[i] == NULL) {
+            return ARGON2_MEMORY_ALLOCATION_ERROR;
+        }
+
+        result = argon2_init_instance(&contexts[i], type, memory[i], memory_size, &instances[i]);
+        if (ARGON2_OK != result) {
+            return result;
+        }
+    }
+
+    result = xmrig_ar2_fill_memory_blocks_multi(instances, count);
+    if (ARGON2_OK != result) {
+        return result;
+    }
+
+    for (i = 0; i < count; ++i) {
+        xmrig_ar2_finalize(&contexts[i], &instances[i]);
+    }
+
+    return ARGON2_OK;
+}
+
 int argon2_ctx(argon2_context *context, argon2_type type) {
     return argon2_ctx_mem(context, type, NULL, 0);
 }
@@ -287,6 +327,44 @@ int argon2id_hash_raw_ex(const uint32_t t_cost, const uint32_t m_cost,
     return argon2_ctx_mem(&context, Argon2_id, memory, m_cost * 1024);
 }
 
+int argon2id_hash_raw_ex_multi(const uint32_t t_cost, const uint32_t m_cost,
+                               const void *const *pwd, const size_t pwdlen,
+                               const void *const *salt, const size_t saltlen,
+                               void *const *hash, const size_t hashlen,
+                               void *const *memory, const size_t count) {
+    argon2_context contexts[ARGON2_MAX_MULTI];
+    size_t i;
+
+    if (count == 0 || count > ARGON2_MAX_MULTI) {
+        return ARGON2_INCORRECT_PARAMETER;
+    }
+
+    for (i = 0; i < count; ++i) {
+        argon2_context *context = &contexts[i];
+
+        context->out = (uint8_t *)hash[i];
+        context->outlen = (uint32_t)hashlen;
+        context->pwd = CONST_CAST(uint8_t *)pwd[i];
+        context->pwdlen = (uint32_t)pwdlen;
+        context->salt = CONST_CAST(uint8_t *)salt[i];
+        context->saltlen = (uint32_t)saltlen;
+        context->secret = NULL;
+        context->secretlen = 0;
+        context->ad = NULL;
+        context->adlen = 0;
+        context->t_cost = t_cost;
+        context->m_cost = m_cost;
+        context->lanes = 1;
+        context->threads = 1;
+        context->allocate_cbk = NULL;
+        context->free_cbk = NULL;
+        context->flags = ARGON2_DEFAULT_FLAGS;
+        context->version = ARGON2_VERSION_NUMBER;
+    }
+
+    return argon2_ctx_mem_multi(contexts, Argon2_id, memory, m_cost * 1024, count);
+}
+
 static int argon2_compare(const uint8_t *b1, const uint8_t *b2, size_t len) {
     size_t i;
     uint8_t d = 0U;
@@ -271,6 +271,36 @@ int xmrig_ar2_fill_memory_blocks(argon2_instance_t *instance) {
     return fill_memory_blocks_st(instance);
 }
 
+int xmrig_ar2_fill_memory_blocks_multi(argon2_instance_t *instances, size_t count) {
+    uint32_t r, s;
+    size_t i;
+
+    for (i = 0; i < count; ++i) {
+        if (instances[i].lanes != 1 ||
+            instances[i].memory_blocks != instances[0].memory_blocks ||
+            instances[i].passes != instances[0].passes ||
+            instances[i].type != instances[0].type ||
+            instances[i].version != instances[0].version) {
+            return ARGON2_INCORRECT_PARAMETER;
+        }
+    }
+
+    for (r = 0; r < instances[0].passes; ++r) {
+        for (s = 0; s < ARGON2_SYNC_POINTS; ++s) {
+            argon2_position_t position = { r, 0, (uint8_t)s, 0 };
+
+            for (i = 0; i + 1 < count; i += 2) {
+                xmrig_ar2_fill_segment_x2(&instances[i], &instances[i + 1], position);
+            }
+
+            if (i < count) {
+                xmrig_ar2_fill_segment(&instances[i], position);
+            }
+        }
+    }
+    return ARGON2_OK;
+}
+
 int xmrig_ar2_validate_inputs(const argon2_context *context) {
     if (NULL == context) {
         return ARGON2_INCORRECT_PARAMETER;
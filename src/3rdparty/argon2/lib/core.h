@@ -209,6 +209,15 @@ void xmrig_ar2_finalize(const argon2_context *context, argon2_instance_t *instan
  */
 void xmrig_ar2_fill_segment(const argon2_instance_t *instance, argon2_position_t position);
 
+/*
+ * Same as xmrig_ar2_fill_segment, but fills the segment of two independent
+ * instances with the same parameters at once
+ * @param a Pointer to the first instance
+ * @param b Pointer to the second instance
+ * @param position Current position
+ */
+void xmrig_ar2_fill_segment_x2(const argon2_instance_t *a, const argon2_instance_t *b, argon2_position_t position);
+
 /*
  * Function that fills the entire memory t_cost times based on the first two
  * blocks in each lane
@@ -217,4 +226,13 @@ void xmrig_ar2_fill_segment(const argon2_instance_t *instance, argon2_position_t
  */
 int xmrig_ar2_fill_memory_blocks(argon2_instance_t *instance);
 
+/*
+ * Function that fills the memory of several independent single-lane instances
+ * with the same parameters, two instances at a time
+ * @param instances Array of @count instances
+ * @param count Number of instances
+ * @return ARGON2_OK if successful
+ */
+int xmrig_ar2_fill_memory_blocks_multi(argon2_instance_t *instances, size_t count);
+
 #endif
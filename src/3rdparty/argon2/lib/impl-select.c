@@ -17,7 +17,7 @@ extern uint64_t uv_hrtime(void);
 #endif
 
 
-static argon2_impl selected_argon_impl = { "default", NULL, fill_segment_default };
+static argon2_impl selected_argon_impl = { "default", NULL, fill_segment_default, NULL };
 
 
 /* the benchmark routine is not thread-safe, so we can use a global var here: */
@@ -92,6 +92,18 @@ void xmrig_ar2_fill_segment(const argon2_instance_t *instance, argon2_position_t
 }
 
 
+void xmrig_ar2_fill_segment_x2(const argon2_instance_t *a, const argon2_instance_t *b, argon2_position_t position)
+{
+    if (selected_argon_impl.fill_segment_x2 != NULL) {
+        selected_argon_impl.fill_segment_x2(a, b, position);
+        return;
+    }
+
+    selected_argon_impl.fill_segment(a, position);
+    selected_argon_impl.fill_segment(b, position);
+}
+
+
 const char *argon2_get_impl_name()
 {
     return selected_argon_impl.name;
@@ -8,6 +8,9 @@ typedef struct Argon2_impl {
     int (*check)(void);
     void (*fill_segment)(const argon2_instance_t *instance,
                          argon2_position_t position);
+    void (*fill_segment_x2)(const argon2_instance_t *a,
+                            const argon2_instance_t *b,
+                            argon2_position_t position); /* optional */
 } argon2_impl;
 
 typedef struct Argon2_impl_list {
@@ -40,6 +40,11 @@
 #include "version.h"
 
 
+#if defined(XMRIG_ALGO_RANDOMX) && defined(XMRIG_OS_LINUX)
+#   include "crypto/rx/RxHandoff.h"
+#endif
+
+
 xmrig::App::App(Process *process)
 {
     m_controller = std::make_shared<Controller>(process);
@@ -67,6 +72,11 @@ int xmrig::App::exec()
 
     m_signals = std::make_shared<Signals>(this);
 
+#   if defined(XMRIG_ALGO_RANDOMX) && defined(XMRIG_OS_LINUX)
+    // A new instance took over the dataset (live upgrade), shut down the same way as on SIGTERM.
+    RxHandoff::setExitCallback([this]() { close(); });
+#   endif
+
     rc = m_controller->init();
     if (rc != 0) {
         return rc;
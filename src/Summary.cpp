@@ -108,6 +108,18 @@ static void print_cpu(const Config *)
                info->threads(),
                info->nodes()
                );
+
+    for (const auto &kind : info->kinds()) {
+        Log::print(WHITE_BOLD("   %-13s") "%s" CYAN_BOLD(" %zu") "C" BLACK_BOLD("/") CYAN_BOLD("%zu") "T" BLACK_BOLD(" score:") WHITE_BOLD("%.2f") BLACK_BOLD(" measured:") WHITE_BOLD("%zu") "%s",
+                   "",
+                   kind.type,
+                   kind.cores,
+                   kind.threads,
+                   kind.score,
+                   kind.measured.size(),
+                   !kind.mining ? YELLOW(" unused") : (!kind.ghostrider ? YELLOW(" unused for gr") : "")
+                   );
+    }
 #   else
     Log::print(WHITE_BOLD("   %-13s") BLACK_BOLD("threads:") CYAN_BOLD("%zu"), "", info->threads());
 #   endif
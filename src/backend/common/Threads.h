@@ -60,6 +60,13 @@ public:
         return count;
     }
 
+    inline size_t replace(const char *profile, T &&threads)
+    {
+        m_profiles.erase(profile);
+
+        return move(profile, std::move(threads));
+    }
+
     const T &get(const String &profileName) const;
     size_t read(const rapidjson::Value &value);
     String profileName(const Algorithm &algorithm, bool strict = false) const;
@@ -22,10 +22,21 @@
 #include "crypto/common/VirtualMemory.h"
 
 
+#ifdef XMRIG_OS_LINUX
+#   include <sys/syscall.h>
+#   include <unistd.h>
+#endif
+
+
 xmrig::Worker::Worker(size_t id, int64_t affinity, int priority) :
     m_affinity(affinity),
     m_id(id)
 {
+    // Workers are created on their own thread.
+#   ifdef XMRIG_OS_LINUX
+    m_tid = static_cast<int64_t>(syscall(SYS_gettid));
+#   endif
+
     m_node = VirtualMemory::bindToNUMANode(affinity);
 
     Platform::trySetThreadAffinity(affinity);
@@ -21,6 +21,10 @@
 
 
 #include "backend/common/interfaces/IWorker.h"
+#include "base/tools/Parking.h"
+
+
+#include <atomic>
 
 
 namespace xmrig {
@@ -31,9 +35,12 @@ class Worker : public IWorker
 public:
     Worker(size_t id, int64_t affinity, int priority);
 
+    inline int64_t tid() const override                     { return m_tid; }
     size_t threads() const override                         { return 1; }
+    void setParked(bool parked) override                    { if (m_parked.exchange(parked, std::memory_order_relaxed) && !parked) { Parking::wake(); } }
 
 protected:
+    inline bool isParked() const                            { return m_parked.load(std::memory_order_relaxed); }
     inline int64_t affinity() const                         { return m_affinity; }
     inline size_t id() const override                       { return m_id; }
     inline uint32_t node() const                            { return m_node; }
@@ -41,8 +48,10 @@ protected:
     uint64_t m_count                = 0;
 
 private:
+    std::atomic<bool> m_parked{ false };
     const int64_t m_affinity;
     const size_t m_id;
+    int64_t m_tid                   = -1;
     uint32_t m_node                 = 0;
 };
 
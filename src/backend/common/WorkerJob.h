@@ -41,12 +41,34 @@ template<size_t N>
 class WorkerJob
 {
 public:
+    inline bool isExhausted() const         { return Nonce::isExhausted(index()); }
     inline const Job &currentJob() const    { return m_jobs[index()]; }
     inline uint32_t *nonce(size_t i = 0)    { return reinterpret_cast<uint32_t*>(blob() + (i * currentJob().size()) + nonceOffset()); }
+    inline uint32_t reserveCount() const    { return m_reserveCount[index()]; }
     inline uint64_t sequence() const        { return m_sequence; }
     inline uint8_t *blob()                  { return m_blobs[index()]; }
     inline uint8_t index() const            { return m_index; }
 
+    // Nonces reserved for the current job but not hashed yet, lost if the job is abandoned.
+    inline uint64_t unused() const          { return unused(index()); }
+
+    // Nonces lost for good by switching to the job: the slot being left is abandoned, except the user slot left for a donation,
+    // it keeps its reservation and is resumed afterwards unless the donation ends with a different user job.
+    inline uint64_t abandoned(const Job &job) const
+    {
+        if (currentJob() == job || !currentJob().isValid() || (index() == 0 && job.index() == 1)) {
+            return 0;
+        }
+
+        uint64_t count = unused();
+
+        if (index() == 1 && job.index() == 0 && job != m_jobs[0] && m_jobs[0].isValid()) {
+            count += unused(0);
+        }
+
+        return count;
+    }
+
 
     inline void add(const Job &job, uint32_t reserveCount, Nonce::Backend backend)
     {
@@ -92,6 +114,13 @@ public:
 private:
     inline uint64_t nonceMask() const     { return m_nonce_mask[index()]; }
 
+    inline uint64_t unused(uint8_t slot) const
+    {
+        const uint32_t count = m_reserveCount[slot];
+
+        return count ? static_cast<uint64_t>(count - (m_rounds[slot] & (count - 1))) * N : 0;
+    }
+
     inline void save(const Job &job, uint32_t reserveCount, Nonce::Backend backend)
     {
         m_index           = job.index();
@@ -99,6 +128,7 @@ private:
         m_jobs[index()]   = job;
         m_rounds[index()] = 0;
         m_nonce_mask[index()] = job.nonceMask();
+        m_reserveCount[index()] = reserveCount;
 
         m_jobs[index()].setBackend(backend);
 
@@ -109,10 +139,11 @@ private:
     }
 
 
-    alignas(8) uint8_t m_blobs[2][Job::kMaxBlobSize * N]{};
-    Job m_jobs[2];
-    uint32_t m_rounds[2] = { 0, 0 };
-    uint64_t m_nonce_mask[2] = { 0, 0 };
+    alignas(8) uint8_t m_blobs[3][Job::kMaxBlobSize * N]{};
+    Job m_jobs[3];
+    uint32_t m_rounds[3] = { 0, 0, 0 };
+    uint32_t m_reserveCount[3] = { 0, 0, 0 };
+    uint64_t m_nonce_mask[3] = { 0, 0, 0 };
     uint64_t m_sequence  = 0;
     uint8_t m_index      = 0;
 };
@@ -155,6 +186,7 @@ inline void xmrig::WorkerJob<1>::save(const Job &job, uint32_t reserveCount, Non
     m_jobs[index()]   = job;
     m_rounds[index()] = 0;
     m_nonce_mask[index()] = job.nonceMask();
+    m_reserveCount[index()] = reserveCount;
 
     m_jobs[index()].setBackend(backend);
 
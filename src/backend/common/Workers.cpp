@@ -52,6 +52,7 @@ public:
     ~WorkersPrivate()   = default;
 
     IBackend *backend   = nullptr;
+    Nonce::Backend nonce = Nonce::CPU;
     std::shared_ptr<Benchmark> benchmark;
     std::shared_ptr<Hashrate> hashrate;
 };
@@ -64,7 +65,7 @@ template<class T>
 xmrig::Workers<T>::Workers() :
     d_ptr(new WorkersPrivate())
 {
-
+    d_ptr->nonce = T::backend();
 }
 
 
@@ -121,6 +122,20 @@ const xmrig::Hashrate *xmrig::Workers<T>::hashrate() const
 }
 
 
+template<class T>
+std::vector<int64_t> xmrig::Workers<T>::tids() const
+{
+    std::vector<int64_t> out;
+    out.reserve(m_workers.size());
+
+    for (const Thread<T> *handle : m_workers) {
+        out.emplace_back(handle->worker() ? handle->worker()->tid() : -1);
+    }
+
+    return out;
+}
+
+
 template<class T>
 void xmrig::Workers<T>::setBackend(IBackend *backend)
 {
@@ -128,11 +143,29 @@ void xmrig::Workers<T>::setBackend(IBackend *backend)
 }
 
 
+template<class T>
+void xmrig::Workers<T>::setNonce(Nonce::Backend nonce)
+{
+    d_ptr->nonce = nonce;
+}
+
+
+template<class T>
+void xmrig::Workers<T>::setActive(size_t count)
+{
+    for (size_t i = 0; i < m_workers.size(); ++i) {
+        if (m_workers[i]->worker()) {
+            m_workers[i]->worker()->setParked(i >= count);
+        }
+    }
+}
+
+
 template<class T>
 void xmrig::Workers<T>::stop()
 {
 #   ifdef XMRIG_MINER_PROJECT
-    Nonce::stop(T::backend());
+    Nonce::stop(d_ptr->nonce);
 #   endif
 
     for (Thread<T> *worker : m_workers) {
@@ -142,7 +175,7 @@ void xmrig::Workers<T>::stop()
     m_workers.clear();
 
 #   ifdef XMRIG_MINER_PROJECT
-    Nonce::touch(T::backend());
+    Nonce::touch(d_ptr->nonce);
 #   endif
 
     d_ptr->hashrate.reset();
@@ -208,7 +241,7 @@ void xmrig::Workers<T>::start(const std::vector<T> &data, bool /*sleep*/)
     d_ptr->hashrate = std::make_shared<Hashrate>(m_workers.size());
 
 #   ifdef XMRIG_MINER_PROJECT
-    Nonce::touch(T::backend());
+    Nonce::touch(d_ptr->nonce);
 #   endif
 
     for (auto worker : m_workers) {
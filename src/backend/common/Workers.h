@@ -58,8 +58,11 @@ public:
 
     bool tick(uint64_t ticks);
     const Hashrate *hashrate() const;
+    std::vector<int64_t> tids() const;
     void jobEarlyNotification(const Job &job);
     void setBackend(IBackend *backend);
+    void setNonce(Nonce::Backend nonce);
+    void setActive(size_t count);
     void stop();
 
 #   ifdef XMRIG_FEATURE_BENCHMARK
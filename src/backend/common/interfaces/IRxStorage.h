@@ -21,6 +21,7 @@
 #define XMRIG_IRXSTORAGE_H
 
 
+#include "3rdparty/rapidjson/fwd.h"
 #include "base/tools/Object.h"
 #include "crypto/common/HugePagesInfo.h"
 #include "crypto/rx/RxConfig.h"
@@ -49,6 +50,7 @@ public:
     virtual bool isAllocated() const                                                                                            = 0;
     virtual HugePagesInfo hugePages() const                                                                                     = 0;
     virtual RxDataset *dataset(const Job &job, uint32_t nodeId) const                                                           = 0;
+    virtual rapidjson::Value toJSON(rapidjson::Document &doc) const                                                             = 0;
     virtual void init(const RxSeed &seed, uint32_t threads, bool hugePages, bool oneGbPages, RxConfig::Mode mode, int priority) = 0;
 };
 
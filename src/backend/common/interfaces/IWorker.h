@@ -44,11 +44,13 @@ public:
 
     virtual bool selfTest()                                                                         = 0;
     virtual const VirtualMemory *memory() const                                                     = 0;
+    virtual int64_t tid() const                                                                     = 0;
     virtual size_t id() const                                                                       = 0;
     virtual size_t intensity() const                                                                = 0;
     virtual size_t threads() const                                                                  = 0;
     virtual void hashrateData(uint64_t &hashCount, uint64_t &timeStamp, uint64_t &rawHashes) const  = 0;
     virtual void jobEarlyNotification(const Job &job)                                               = 0;
+    virtual void setParked(bool parked)                                                             = 0;
     virtual void start()                                                                            = 0;
 };
 
@@ -26,6 +26,9 @@
 #include "backend/common/Tags.h"
 #include "backend/common/Workers.h"
 #include "backend/cpu/Cpu.h"
+#include "backend/cpu/CpuCoSchedule.h"
+#include "backend/cpu/CpuSchedMonitor.h"
+#include "backend/cpu/CpuThreadTuner.h"
 #include "base/io/log/Log.h"
 #include "base/io/log/Tags.h"
 #include "base/net/stratum/Job.h"
@@ -33,6 +36,7 @@
 #include "base/tools/String.h"
 #include "core/config/Config.h"
 #include "core/Controller.h"
+#include "core/Miner.h"
 #include "crypto/common/VirtualMemory.h"
 #include "crypto/rx/Rx.h"
 #include "crypto/rx/RxDataset.h"
@@ -48,6 +52,13 @@
 #endif
 
 
+#ifdef XMRIG_ALGO_RANDOMX
+#   include "crypto/randomx/aes_hash.hpp"
+#   include "crypto/rx/RxBuildStats.h"
+#   include "crypto/rx/RxScrubber.h"
+#endif
+
+
 #ifdef XMRIG_FEATURE_BENCHMARK
 #   include "backend/common/benchmark/Benchmark.h"
 #   include "backend/common/benchmark/BenchState.h"
@@ -63,6 +74,10 @@ extern template class Threads<CpuThreads>;
 static const String kType   = "cpu";
 static std::mutex mutex;
 
+#ifdef XMRIG_FEATURE_HWLOC
+static constexpr uint64_t kKindSampleTicks = 120;  // one minute, matches Hashrate::MediumInterval
+#endif
+
 
 struct CpuLaunchStatus
 {
@@ -139,13 +154,14 @@ private:
 class CpuBackendPrivate
 {
 public:
-    inline explicit CpuBackendPrivate(Controller *controller) : controller(controller)   {}
+    inline CpuBackendPrivate(Controller *controller, bool coSchedule) : coSchedule(coSchedule), controller(controller)  {}
 
 
     inline void start()
     {
-        LOG_INFO("%s use profile " BLUE_BG(WHITE_BOLD_S " %s ") WHITE_BOLD_S " (" CYAN_BOLD("%zu") WHITE_BOLD(" thread%s)") " scratchpad " CYAN_BOLD("%zu KB"),
+        LOG_INFO("%s %suse profile " BLUE_BG(WHITE_BOLD_S " %s ") WHITE_BOLD_S " (" CYAN_BOLD("%zu") WHITE_BOLD(" thread%s)") " scratchpad " CYAN_BOLD("%zu KB"),
                  Tags::cpu(),
+                 coSchedule ? MAGENTA_BOLD("co-schedule ") : "",
                  profileName.data(),
                  threads.size(),
                  threads.size() > 1 ? "s" : "",
@@ -153,6 +169,8 @@ public:
                  );
 
         status.start(threads, algo.l3());
+        tuner.reset(threads.size());
+        sched.reset();
 
 #       ifdef XMRIG_FEATURE_BENCHMARK
         workers.start(threads, benchmark);
@@ -162,6 +180,43 @@ public:
     }
 
 
+    std::vector<int64_t> affinities() const
+    {
+        std::vector<int64_t> out;
+        out.reserve(threads.size());
+
+        for (const auto &data : threads) {
+            out.emplace_back(data.affinity);
+        }
+
+        return out;
+    }
+
+
+#   ifdef XMRIG_FEATURE_HWLOC
+    // Per thread hashrate of the running algorithm grouped by CPU kind, replaces the startup probe in auto-configuration
+    void sampleKinds() const
+    {
+        const Hashrate *hashrate = workers.hashrate();
+        if (coSchedule || !hashrate || Cpu::info()->kinds().size() < 2) {
+            return;
+        }
+
+        std::vector<std::pair<int64_t, double>> samples;
+        samples.reserve(threads.size());
+
+        for (size_t i = 0; i < threads.size(); ++i) {
+            const auto value = hashrate->calc(i, Hashrate::MediumInterval);
+            if (value.first) {
+                samples.emplace_back(threads[i].affinity, value.second);
+            }
+        }
+
+        Cpu::info()->setKindHashrate(algo, samples);
+    }
+#   endif
+
+
     size_t ways() const
     {
         std::lock_guard<std::mutex> lock(mutex);
@@ -202,8 +257,11 @@ public:
 
 
     Algorithm algo;
+    bool coSchedule;
     Controller *controller;
     CpuLaunchStatus status;
+    CpuSchedMonitor sched;
+    CpuThreadTuner tuner;
     std::vector<CpuLaunchData> threads;
     String profileName;
     Workers<CpuLaunchData> workers;
@@ -241,10 +299,14 @@ const char *xmrig::cpu_tag()
 }
 
 
-xmrig::CpuBackend::CpuBackend(Controller *controller) :
-    d_ptr(new CpuBackendPrivate(controller))
+xmrig::CpuBackend::CpuBackend(Controller *controller, bool coSchedule) :
+    d_ptr(new CpuBackendPrivate(controller, coSchedule))
 {
     d_ptr->workers.setBackend(this);
+
+    if (coSchedule) {
+        d_ptr->workers.setNonce(Nonce::CPU_CO);
+    }
 }
 
 
@@ -262,12 +324,27 @@ bool xmrig::CpuBackend::isEnabled() const
 
 bool xmrig::CpuBackend::isEnabled(const Algorithm &algorithm) const
 {
-    return !d_ptr->controller->config()->cpu().threads().get(algorithm).isEmpty();
+    // The co-scheduled partition only mines jobs from "co-schedule" pools, it doesn't add algorithms to the miner.
+    return !d_ptr->coSchedule && !d_ptr->controller->config()->cpu().threads().get(algorithm).isEmpty();
 }
 
 
 bool xmrig::CpuBackend::tick(uint64_t ticks)
 {
+    if (!d_ptr->threads.empty()) {
+        d_ptr->sched.tick(d_ptr->workers.tids(), d_ptr->affinities());
+
+#       ifdef XMRIG_ALGO_RANDOMX
+        d_ptr->tuner.tick(d_ptr->workers, d_ptr->algo, d_ptr->controller->config()->rx().autoThreads(), d_ptr->sched.contention());
+#       endif
+
+#       ifdef XMRIG_FEATURE_HWLOC
+        if (ticks && (ticks % kKindSampleTicks) == 0) {
+            d_ptr->sampleKinds();
+        }
+#       endif
+    }
+
     return d_ptr->workers.tick(ticks);
 }
 
@@ -340,6 +417,7 @@ void xmrig::CpuBackend::printHashrate(bool details)
 
 void xmrig::CpuBackend::printHealth()
 {
+    d_ptr->sched.print(d_ptr->affinities());
 }
 
 
@@ -349,18 +427,27 @@ void xmrig::CpuBackend::setJob(const Job &job)
         return stop();
     }
 
-    const auto &cpu = d_ptr->controller->config()->cpu();
+    const auto &cpu   = d_ptr->controller->config()->cpu();
+    const auto *miner = d_ptr->controller->miner();
+    const Job coJob   = miner->coJob();
+
+    if (d_ptr->coSchedule && !coJob.isValid()) {
+        return stop();
+    }
+
+    const Algorithm algorithm = d_ptr->coSchedule ? coJob.algorithm() : job.algorithm();
+    const size_t limit        = coJob.isValid() ? CpuCoSchedule::threads(cpu) : 0;
 
-    auto threads = cpu.get(d_ptr->controller->miner(), job.algorithm());
+    auto threads = d_ptr->coSchedule ? cpu.getCoSchedule(miner, algorithm, job.algorithm(), limit) : cpu.get(miner, algorithm, limit);
     if (!d_ptr->threads.empty() && d_ptr->threads.size() == threads.size() && std::equal(d_ptr->threads.begin(), d_ptr->threads.end(), threads.begin())) {
         return;
     }
 
-    d_ptr->algo         = job.algorithm();
-    d_ptr->profileName  = cpu.threads().profileName(job.algorithm());
+    d_ptr->algo         = algorithm;
+    d_ptr->profileName  = cpu.threads().profileName(algorithm);
 
     if (d_ptr->profileName.isNull() || threads.empty()) {
-        LOG_WARN("%s " RED_BOLD("disabled") YELLOW(" (no suitable configuration found)"), Tags::cpu());
+        LOG_WARN("%s %s" RED_BOLD("disabled") YELLOW(" (no suitable configuration found)"), Tags::cpu(), d_ptr->coSchedule ? MAGENTA_BOLD("co-schedule ") : "");
 
         return stop();
     }
@@ -419,6 +506,7 @@ rapidjson::Value xmrig::CpuBackend::toJSON(rapidjson::Document &doc) const
     Value out(kObjectType);
     out.AddMember("type",       type().toJSON(), allocator);
     out.AddMember("enabled",    isEnabled(), allocator);
+    out.AddMember("co-schedule", d_ptr->coSchedule, allocator);
     out.AddMember("algo",       d_ptr->algo.toJSON(), allocator);
     out.AddMember("profile",    profileName().toJSON(), allocator);
     out.AddMember("hw-aes",     cpu.isHwAES(), allocator);
@@ -436,6 +524,23 @@ rapidjson::Value xmrig::CpuBackend::toJSON(rapidjson::Document &doc) const
     out.AddMember("argon2-impl", argon2::Impl::name().toJSON(), allocator);
 #   endif
 
+#   ifdef XMRIG_ALGO_RANDOMX
+    out.AddMember("soft-aes", cpu.isHwAES() ? Value(kNullType) : Value(StringRef(GetSoftAESImplName())), allocator);
+    out.AddMember("dataset-scrub", RxScrubber::toJSON(doc), allocator);
+    out.AddMember("numa", Rx::toJSON(doc), allocator);
+    out.AddMember("dataset-builds", RxBuildStats::toJSON(doc), allocator);
+
+    const auto jit = VirtualMemory::jitStats();
+    Value jitMemory(kObjectType);
+    jitMemory.AddMember("regions",  static_cast<uint64_t>(jit.regions), allocator);
+    jitMemory.AddMember("shared",   static_cast<uint64_t>(jit.shared), allocator);
+    jitMemory.AddMember("arenas",   static_cast<uint64_t>(jit.arenas), allocator);
+    jitMemory.AddMember("bytes",    static_cast<uint64_t>(jit.bytes), allocator);
+
+    out.AddMember("jit-memory", jitMemory, allocator);
+    out.AddMember("auto-threads", d_ptr->tuner.toJSON(doc), allocator);
+#   endif
+
     out.AddMember("hugepages", d_ptr->hugePages(2, doc), allocator);
     out.AddMember("memory",    static_cast<uint64_t>(d_ptr->algo.isValid() ? (d_ptr->ways() * d_ptr->algo.l3()) : 0), allocator);
 
@@ -453,7 +558,9 @@ rapidjson::Value xmrig::CpuBackend::toJSON(rapidjson::Document &doc) const
         thread.AddMember("intensity",   data.intensity, allocator);
         thread.AddMember("affinity",    data.affinity, allocator);
         thread.AddMember("av",          data.av(), allocator);
+        thread.AddMember("variant",     StringRef(CpuThread::variantName(data.variant)), allocator);
         thread.AddMember("hashrate",    hashrate()->toJSON(i, doc), allocator);
+        thread.AddMember("sched",       d_ptr->sched.toJSON(i, doc), allocator);
 
         i++;
         threads.PushBack(thread, allocator);
@@ -467,7 +574,7 @@ rapidjson::Value xmrig::CpuBackend::toJSON(rapidjson::Document &doc) const
 
 void xmrig::CpuBackend::handleRequest(IApiRequest &request)
 {
-    if (request.type() == IApiRequest::REQ_SUMMARY) {
+    if (request.type() == IApiRequest::REQ_SUMMARY && !d_ptr->coSchedule) {
         request.reply().AddMember("hugepages", d_ptr->hugePages(request.version(), request.doc()), request.doc().GetAllocator());
     }
 }
@@ -40,7 +40,7 @@ class CpuBackend : public IBackend
 public:
     XMRIG_DISABLE_COPY_MOVE_DEFAULT(CpuBackend)
 
-    CpuBackend(Controller *controller);
+    CpuBackend(Controller *controller, bool coSchedule = false);
     ~CpuBackend() override;
 
 protected:
@@ -0,0 +1,304 @@
+/* XMRig
+ * Copyright (c) 2018-2024 SChernykh   <https://github.com/SChernykh>
+ * Copyright (c) 2016-2024 XMRig       <https://github.com/xmrig>, <support@xmrig.com>
+ *
+ *   This program is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "backend/cpu/CpuCoSchedule.h"
+#include "3rdparty/rapidjson/document.h"
+#include "backend/cpu/Cpu.h"
+#include "backend/cpu/CpuConfig.h"
+#include "base/io/log/Log.h"
+#include "base/io/log/Tags.h"
+#include "base/kernel/Platform.h"
+#include "base/net/stratum/Pools.h"
+#include "base/tools/Chrono.h"
+
+
+#ifdef XMRIG_ALGO_RANDOMX
+#   include "crypto/rx/RxMemoryPlan.h"
+#endif
+
+
+#include <algorithm>
+#include <atomic>
+#include <mutex>
+#include <new>
+#include <thread>
+#include <utility>
+#include <uv.h>
+
+
+namespace xmrig {
+
+
+constexpr size_t oneMiB         = 1024 * 1024;
+constexpr size_t kMinProbeSize  = 64 * oneMiB;
+constexpr size_t kMaxProbeSize  = 512 * oneMiB;
+constexpr uint64_t kProbeTime   = 100;  // ms per measured thread count
+constexpr double kSaturation    = 0.9;  // fraction of the peak throughput where adding threads stops paying off
+
+static std::atomic<size_t> probed{ 0 };
+static std::atomic<uint64_t> sink{ 0 };
+static std::mutex mutex;
+static std::vector<std::pair<size_t, double> > samples;
+
+
+static uint64_t availableMemory()
+{
+#   ifdef XMRIG_ALGO_RANDOMX
+    return RxMemoryPlan::available();
+#   else
+    return uv_get_free_memory();
+#   endif
+}
+
+
+static void run(const std::vector<int64_t> &affinities)
+{
+    const uint64_t ts   = Chrono::steadyMSecs();
+    const size_t result = CpuCoSchedule::probe(affinities);
+
+    if (result == 0) {
+        probed = affinities.size();
+
+        LOG_WARN("%s " WHITE_BOLD("co-schedule") YELLOW(" not enough free memory for the probe, set \"co-schedule\" in \"cpu\" to split the CPU manually"), Tags::cpu());
+
+        return;
+    }
+
+    LOG_INFO("%s " WHITE_BOLD("co-schedule") " memory throughput saturates at %s%zu/%zu" CLEAR " threads" BLACK_BOLD(" (%" PRIu64 " ms)"),
+             Tags::cpu(),
+             result < affinities.size() ? CYAN_BOLD_S : YELLOW_BOLD_S,
+             result,
+             affinities.size(),
+             Chrono::steadyMSecs() - ts
+             );
+
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+
+        if (!samples.empty()) {
+            Log::print(WHITE_BOLD_S "| THREADS |     MB/s |");
+
+            for (const auto &sample : samples) {
+                Log::print("| %7zu | %8.0f |", sample.first, sample.second);
+            }
+        }
+    }
+
+    if (result >= affinities.size()) {
+        LOG_WARN("%s " WHITE_BOLD("co-schedule") YELLOW(" no spare cores, set \"co-schedule\" in \"cpu\" to split them manually"), Tags::cpu());
+    }
+
+    probed = result;
+}
+
+
+// Random 64-byte reads from a buffer larger than L3, the addresses don't depend on loaded data so every
+// thread keeps many misses in flight like RandomX dataset reads. Returns MB/s for all threads together.
+static double measure(const uint64_t *memory, size_t size, const std::vector<int64_t> &affinities, size_t count)
+{
+    std::atomic<int> state{ 0 };
+    std::atomic<uint64_t> reads{ 0 };
+    std::vector<std::thread> threads;
+    threads.reserve(count);
+
+    const uint64_t mask = size / 64 - 1;
+
+    for (size_t i = 0; i < count; ++i) {
+        const int64_t affinity = i < affinities.size() ? affinities[i] : -1;
+
+        threads.emplace_back([&state, &reads, memory, mask, affinity, i]() {
+            if (affinity >= 0) {
+                Platform::setThreadAffinity(static_cast<uint64_t>(affinity));
+            }
+
+            uint64_t x[8];
+            for (size_t j = 0; j < 8; ++j) {
+                x[j] = 0x9E3779B97F4A7C15ULL * (i * 8 + j + 1);
+            }
+
+            uint64_t sum = 0;
+            uint64_t n   = 0;
+
+            while (state.load(std::memory_order_acquire) == 0) {
+                std::this_thread::yield();
+            }
+
+            while (state.load(std::memory_order_relaxed) == 1) {
+                for (size_t k = 0; k < 64; ++k) {
+                    for (size_t j = 0; j < 8; ++j) {
+                        x[j] ^= x[j] << 13;
+                        x[j] ^= x[j] >> 7;
+                        x[j] ^= x[j] << 17;
+
+                        sum += memory[(x[j] & mask) * 8];
+                    }
+                }
+
+                n += 64 * 8;
+            }
+
+            reads.fetch_add(n, std::memory_order_relaxed);
+            sink.fetch_xor(sum, std::memory_order_relaxed);
+        });
+    }
+
+    // Let the threads start and pin themselves before the window opens.
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+
+    const double ts = Chrono::highResolutionMSecs();
+    state.store(1, std::memory_order_release);
+    std::this_thread::sleep_for(std::chrono::milliseconds(kProbeTime));
+    state.store(2, std::memory_order_release);
+    const double elapsed = Chrono::highResolutionMSecs() - ts;
+
+    for (auto &thread : threads) {
+        thread.join();
+    }
+
+    return elapsed > 0.0 ? static_cast<double>(reads.load() * 64) / (elapsed / 1000.0) / oneMiB : 0.0;
+}
+
+
+} // namespace xmrig
+
+
+rapidjson::Value xmrig::CpuCoSchedule::toJSON(rapidjson::Document &doc)
+{
+    using namespace rapidjson;
+    auto &allocator = doc.GetAllocator();
+
+    Value out(kObjectType);
+    out.AddMember("saturation", static_cast<uint64_t>(probed.load()), allocator);
+
+    Value probe(kArrayType);
+
+    std::lock_guard<std::mutex> lock(mutex);
+
+    for (const auto &sample : samples) {
+        Value item(kArrayType);
+        item.PushBack(static_cast<uint64_t>(sample.first), allocator);
+        item.PushBack(static_cast<uint64_t>(sample.second), allocator);
+
+        probe.PushBack(item, allocator);
+    }
+
+    out.AddMember("probe", probe, allocator);
+
+    return out;
+}
+
+
+size_t xmrig::CpuCoSchedule::probe(const std::vector<int64_t> &affinities)
+{
+    const size_t total = affinities.size();
+    if (total < 2) {
+        return total;
+    }
+
+    const size_t target = std::min(std::max(Cpu::info()->L3() * 4, kMinProbeSize), kMaxProbeSize);
+    size_t size         = kMinProbeSize;
+
+    while (size < target) {
+        size *= 2;
+    }
+
+    // The buffer is freed before the dataset is allocated, but it must not push the system into swap
+    // either, keep half of the available memory free and give up below the minimum size.
+    const uint64_t available = availableMemory();
+
+    while (size > kMinProbeSize && size > available / 2) {
+        size /= 2;
+    }
+
+    if (size > available / 2) {
+        return 0;
+    }
+
+    // Written once so every page is really backed by memory, not by the shared zero page.
+    std::vector<uint64_t> memory;
+
+    try {
+        memory.resize(size / sizeof(uint64_t));
+    } catch (const std::bad_alloc &) {
+        return 0;
+    }
+
+    for (size_t i = 0; i < memory.size(); ++i) {
+        memory[i] = i;
+    }
+
+    std::vector<std::pair<size_t, double> > results;
+
+    const size_t step = std::max<size_t>(total / 8, 1);
+    double peak       = 0.0;
+
+    for (size_t count = 1;; count = std::min(count + step, total)) {
+        const double rate = measure(memory.data(), size, affinities, count);
+
+        results.emplace_back(count, rate);
+        peak = std::max(peak, rate);
+
+        if (count == total) {
+            break;
+        }
+    }
+
+    size_t saturation = total;
+
+    for (const auto &sample : results) {
+        if (sample.second >= peak * kSaturation) {
+            saturation = sample.first;
+            break;
+        }
+    }
+
+    std::lock_guard<std::mutex> lock(mutex);
+    samples = std::move(results);
+
+    return saturation;
+}
+
+
+size_t xmrig::CpuCoSchedule::threads(const CpuConfig &config)
+{
+    return config.coSchedule() > 0 ? static_cast<size_t>(config.coSchedule()) : probed.load();
+}
+
+
+void xmrig::CpuCoSchedule::init(const CpuConfig &config, const Pools &pools)
+{
+    if (!config.isEnabled() || pools.coActive() == 0 || config.coSchedule() > 0) {
+        return;
+    }
+
+    std::vector<int64_t> affinities;
+    const auto &threads = config.threads().get(Algorithm::RX_0);
+
+    if (!threads.isEmpty()) {
+        for (const auto &thread : threads.data()) {
+            affinities.emplace_back(thread.affinity());
+        }
+    }
+    else {
+        affinities.resize(Cpu::info()->threads(), -1);
+    }
+
+    // About a second of measurements, before the network is up and any worker or dataset thread exists,
+    // so nothing else competes for memory bandwidth.
+    run(affinities);
+}
@@ -0,0 +1,60 @@
+/* XMRig
+ * Copyright (c) 2018-2024 SChernykh   <https://github.com/SChernykh>
+ * Copyright (c) 2016-2024 XMRig       <https://github.com/xmrig>, <support@xmrig.com>
+ *
+ *   This program is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef XMRIG_CPUCOSCHEDULE_H
+#define XMRIG_CPUCOSCHEDULE_H
+
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+
+#include "3rdparty/rapidjson/fwd.h"
+
+
+namespace xmrig
+{
+
+
+class CpuConfig;
+class Pools;
+
+
+/**
+ * Core partitioning for co-scheduling: the primary (memory-bound) job keeps the threads that still add
+ * memory throughput, the job from "co-schedule" pools runs on the remaining cores.
+ *
+ * The split comes from "cpu"/"co-schedule" or, when it is auto (-1), from a startup probe that measures
+ * random 64-byte read throughput with a growing number of threads and stops where it saturates.
+ * The probe runs at startup before any worker exists, when there is not enough free memory for it the CPU is not split.
+ */
+class CpuCoSchedule
+{
+public:
+    static rapidjson::Value toJSON(rapidjson::Document &doc);
+    static size_t probe(const std::vector<int64_t> &affinities);
+    static size_t threads(const CpuConfig &config);
+    static void init(const CpuConfig &config, const Pools &pools);
+};
+
+
+} /* namespace xmrig */
+
+
+#endif /* XMRIG_CPUCOSCHEDULE_H */
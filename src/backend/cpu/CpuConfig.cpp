@@ -22,11 +22,23 @@
 #include "backend/cpu/Cpu.h"
 #include "base/io/json/Json.h"
 
+
+#if defined(XMRIG_ALGO_GHOSTRIDER) || defined(XMRIG_FEATURE_HWLOC)
+#   include "base/kernel/Process.h"
+#endif
+
+#ifdef XMRIG_ALGO_RANDOMX
+#   include "crypto/rx/RxMemoryPlan.h"
+#endif
+
+
 #include <algorithm>
+#include <set>
 
 
 namespace xmrig {
 
+const char *CpuConfig::kCoSchedule          = "co-schedule";
 const char *CpuConfig::kEnabled             = "enabled";
 const char *CpuConfig::kField               = "cpu";
 const char *CpuConfig::kHugePages           = "huge-pages";
@@ -45,6 +57,19 @@ const char *CpuConfig::kAsm                 = "asm";
 const char *CpuConfig::kArgon2Impl          = "argon2-impl";
 #endif
 
+#ifdef XMRIG_ALGO_GHOSTRIDER
+const char *CpuConfig::kGhostRiderTune      = "gr-tune";
+const char *CpuConfig::kGhostRiderTuneCache = "gr-tune-cache";
+#endif
+
+#ifdef XMRIG_FEATURE_HWLOC
+const char *CpuConfig::kKinds               = "kinds";
+
+static const char *kKindGhostRider          = "ghostrider";
+static const char *kKindIntensity           = "intensity";
+static const char *kKindMining              = "mining";
+#endif
+
 
 extern template class Threads<CpuThreads>;
 
@@ -57,6 +82,18 @@ bool xmrig::CpuConfig::isHwAES() const
 }
 
 
+#ifdef XMRIG_ALGO_GHOSTRIDER
+xmrig::String xmrig::CpuConfig::grTuneCache() const
+{
+    if (!m_grTuneCache) {
+        return {};
+    }
+
+    return m_grTuneCachePath.isNull() ? Process::location(Process::DataLocation, "ghostrider-tune.json") : m_grTuneCachePath;
+}
+#endif
+
+
 rapidjson::Value xmrig::CpuConfig::toJSON(rapidjson::Document &doc) const
 {
     using namespace rapidjson;
@@ -71,6 +108,7 @@ rapidjson::Value xmrig::CpuConfig::toJSON(rapidjson::Document &doc) const
     obj.AddMember(StringRef(kPriority),     priority() != -1 ? Value(priority()) : Value(kNullType), allocator);
     obj.AddMember(StringRef(kMemoryPool),   m_memoryPool < 1 ? Value(m_memoryPool < 0) : Value(m_memoryPool), allocator);
     obj.AddMember(StringRef(kYield),        m_yield, allocator);
+    obj.AddMember(StringRef(kCoSchedule),   m_coSchedule, allocator);
 
     if (m_threads.isEmpty()) {
         obj.AddMember(StringRef(kMaxThreadsHint), m_limit, allocator);
@@ -84,6 +122,31 @@ rapidjson::Value xmrig::CpuConfig::toJSON(rapidjson::Document &doc) const
     obj.AddMember(StringRef(kArgon2Impl), m_argon2Impl.toJSON(), allocator);
 #   endif
 
+#   ifdef XMRIG_ALGO_GHOSTRIDER
+    if (m_grTune.empty()) {
+        obj.AddMember(StringRef(kGhostRiderTune), Value(kNullType), allocator);
+    }
+    else {
+        Value tune(kObjectType);
+        for (const auto &kv : m_grTune) {
+            tune.AddMember(kv.first.toJSON(doc), kv.second.toJSON(doc), allocator);
+        }
+
+        obj.AddMember(StringRef(kGhostRiderTune), tune, allocator);
+    }
+
+    obj.AddMember(StringRef(kGhostRiderTuneCache), m_grTuneCache && !m_grTuneCachePath.isNull() ? m_grTuneCachePath.toJSON(doc) : Value(m_grTuneCache), allocator);
+#   endif
+
+#   ifdef XMRIG_FEATURE_HWLOC
+    Value kinds(kObjectType);
+    kinds.AddMember(StringRef(kKindMining),     m_kinds.mining, allocator);
+    kinds.AddMember(StringRef(kKindGhostRider), m_kinds.ghostrider, allocator);
+    kinds.AddMember(StringRef(kKindIntensity),  m_kinds.intensity, allocator);
+
+    obj.AddMember(StringRef(kKinds), kinds, allocator);
+#   endif
+
     m_threads.toJSON(obj, doc);
 
     return obj;
@@ -96,34 +159,73 @@ size_t xmrig::CpuConfig::memPoolSize() const
 }
 
 
-std::vector<xmrig::CpuLaunchData> xmrig::CpuConfig::get(const Miner *miner, const Algorithm &algorithm) const
+std::vector<xmrig::CpuLaunchData> xmrig::CpuConfig::get(const Miner *miner, const Algorithm &algorithm, size_t limit) const
 {
     if (algorithm.family() == Algorithm::KAWPOW) {
         return {};
     }
 
-    std::vector<CpuLaunchData> out;
     const auto &threads = m_threads.get(algorithm);
 
     if (threads.isEmpty()) {
-        return out;
+        return {};
     }
 
-    const size_t count = threads.count();
-    out.reserve(count);
+    size_t count = threads.count();
 
-    std::vector<int64_t> affinities;
-    affinities.reserve(count);
+#   ifdef XMRIG_ALGO_RANDOMX
+    if (RxMemoryPlan::threads(algorithm)) {
+        count = std::min(count, RxMemoryPlan::threads(algorithm));
+    }
+#   endif
 
-    for (const auto& thread : threads.data()) {
-        affinities.emplace_back(thread.affinity());
+    if (limit) {
+        count = std::min(count, limit);
+    }
+
+    return get(miner, algorithm, std::vector<CpuThread>(threads.data().begin(), threads.data().begin() + count), false);
+}
+
+
+std::vector<xmrig::CpuLaunchData> xmrig::CpuConfig::getCoSchedule(const Miner *miner, const Algorithm &algorithm, const Algorithm &primary, size_t limit) const
+{
+    if (algorithm.family() == Algorithm::KAWPOW || algorithm.family() == Algorithm::RANDOM_X) {
+        return {};
     }
 
+    const auto &threads = m_threads.get(algorithm);
+
+    if (threads.isEmpty()) {
+        return {};
+    }
+
+    // The co-scheduled job takes the threads whose cores are not used by the primary partition.
+    const auto busy = primary.isValid() ? get(miner, primary, limit) : std::vector<CpuLaunchData>();
+    std::set<int64_t> affinities;
+    bool unpinned = false;
+
+    for (const auto &data : busy) {
+        affinities.insert(data.affinity);
+        unpinned |= data.affinity < 0;
+    }
+
+    std::vector<CpuThread> out;
+
     for (const auto &thread : threads.data()) {
-        out.emplace_back(miner, algorithm, *this, thread, count, affinities);
+        if (thread.affinity() < 0 || affinities.count(thread.affinity()) == 0) {
+            unpinned |= thread.affinity() < 0;
+            out.emplace_back(thread);
+        }
     }
 
-    return out;
+    // Threads without affinity can't be matched to cores, keep the total within the hardware thread count.
+    if (unpinned) {
+        const size_t spare = Cpu::info()->threads() > busy.size() ? Cpu::info()->threads() - busy.size() : 0;
+
+        out.resize(std::min(out.size(), spare));
+    }
+
+    return get(miner, algorithm, out, true);
 }
 
 
@@ -134,6 +236,7 @@ void xmrig::CpuConfig::read(const rapidjson::Value &value)
         m_hugePagesJit = Json::getBool(value, kHugePagesJit, m_hugePagesJit);
         m_limit        = Json::getUint(value, kMaxThreadsHint, m_limit);
         m_yield        = Json::getBool(value, kYield, m_yield);
+        m_coSchedule   = Json::getInt(value, kCoSchedule, m_coSchedule);
 
         setAesMode(Json::getValue(value, kHwAes));
         setHugePages(Json::getValue(value, kHugePages));
@@ -148,6 +251,15 @@ void xmrig::CpuConfig::read(const rapidjson::Value &value)
         m_argon2Impl = Json::getString(value, kArgon2Impl);
 #       endif
 
+#       ifdef XMRIG_ALGO_GHOSTRIDER
+        setGhostRiderTune(Json::getValue(value, kGhostRiderTune));
+        setGhostRiderTuneCache(Json::getValue(value, kGhostRiderTuneCache));
+#       endif
+
+#       ifdef XMRIG_FEATURE_HWLOC
+        setKinds(Json::getValue(value, kKinds));
+#       endif
+
         m_threads.read(value);
 
         generate();
@@ -181,6 +293,32 @@ void xmrig::CpuConfig::generate()
     count += xmrig::generate<Algorithm::GHOSTRIDER>(m_threads, m_limit);
 
     m_shouldSave |= count > 0;
+
+#   ifdef XMRIG_FEATURE_HWLOC
+    if (count) {
+        Cpu::info()->saveKinds();
+    }
+#   endif
+}
+
+
+std::vector<xmrig::CpuLaunchData> xmrig::CpuConfig::get(const Miner *miner, const Algorithm &algorithm, const std::vector<CpuThread> &threads, bool coSchedule) const
+{
+    std::vector<CpuLaunchData> out;
+    out.reserve(threads.size());
+
+    std::vector<int64_t> affinities;
+    affinities.reserve(threads.size());
+
+    for (const auto &thread : threads) {
+        affinities.emplace_back(thread.affinity());
+    }
+
+    for (const auto &thread : threads) {
+        out.emplace_back(miner, algorithm, *this, thread, threads.size(), affinities, coSchedule);
+    }
+
+    return out;
 }
 
 
@@ -195,6 +333,41 @@ void xmrig::CpuConfig::setAesMode(const rapidjson::Value &value)
 }
 
 
+#ifdef XMRIG_ALGO_GHOSTRIDER
+void xmrig::CpuConfig::setGhostRiderTune(const rapidjson::Value &value)
+{
+    m_grTune.clear();
+
+    if (!value.IsObject()) {
+        return;
+    }
+
+    for (auto &member : value.GetObject()) {
+        if (member.value.IsString()) {
+            m_grTune.insert({ member.name.GetString(), member.value.GetString() });
+        }
+    }
+}
+
+
+void xmrig::CpuConfig::setGhostRiderTuneCache(const rapidjson::Value &value)
+{
+    m_grTuneCachePath = nullptr;
+
+    if (value.IsBool()) {
+        m_grTuneCache = value.GetBool();
+    }
+    else if (value.IsString() && value.GetStringLength() > 0) {
+        m_grTuneCache     = true;
+        m_grTuneCachePath = value.GetString();
+    }
+    else {
+        m_grTuneCache = false;
+    }
+}
+#endif
+
+
 void xmrig::CpuConfig::setHugePages(const rapidjson::Value &value)
 {
     if (value.IsBool()) {
@@ -208,6 +381,26 @@ void xmrig::CpuConfig::setHugePages(const rapidjson::Value &value)
 }
 
 
+#ifdef XMRIG_FEATURE_HWLOC
+void xmrig::CpuConfig::setKinds(const rapidjson::Value &value)
+{
+    auto score = [&value](const char *key, double defaultValue) {
+        const double v = Json::getDouble(value, key, defaultValue);
+        return (v >= 0.0 && v <= 1.0) ? v : defaultValue;
+    };
+
+    const ICpuInfo::KindThresholds defaults;
+
+    m_kinds.ghostrider = score(kKindGhostRider, defaults.ghostrider);
+    m_kinds.intensity  = score(kKindIntensity, defaults.intensity);
+    m_kinds.mining     = score(kKindMining, defaults.mining);
+
+    Cpu::info()->setKindThresholds(m_kinds);
+    Cpu::info()->loadKinds(Process::location(Process::DataLocation, "cpu-kinds.json"));
+}
+#endif
+
+
 void xmrig::CpuConfig::setMemoryPool(const rapidjson::Value &value)
 {
     if (value.IsBool()) {
@@ -23,9 +23,13 @@
 #include "backend/common/Threads.h"
 #include "backend/cpu/CpuLaunchData.h"
 #include "backend/cpu/CpuThreads.h"
+#include "backend/cpu/interfaces/ICpuInfo.h"
 #include "crypto/common/Assembly.h"
 
 
+#include <map>
+
+
 namespace xmrig {
 
 
@@ -38,6 +42,7 @@ public:
         AES_SOFT
     };
 
+    static const char *kCoSchedule;
     static const char *kEnabled;
     static const char *kField;
     static const char *kHugePages;
@@ -56,12 +61,22 @@ public:
     static const char *kArgon2Impl;
 #   endif
 
+#   ifdef XMRIG_ALGO_GHOSTRIDER
+    static const char *kGhostRiderTune;
+    static const char *kGhostRiderTuneCache;
+#   endif
+
+#   ifdef XMRIG_FEATURE_HWLOC
+    static const char *kKinds;
+#   endif
+
     CpuConfig() = default;
 
     bool isHwAES() const;
     rapidjson::Value toJSON(rapidjson::Document &doc) const;
     size_t memPoolSize() const;
-    std::vector<CpuLaunchData> get(const Miner *miner, const Algorithm &algorithm) const;
+    std::vector<CpuLaunchData> get(const Miner *miner, const Algorithm &algorithm, size_t limit = 0) const;
+    std::vector<CpuLaunchData> getCoSchedule(const Miner *miner, const Algorithm &algorithm, const Algorithm &primary, size_t limit) const;
     void read(const rapidjson::Value &value);
 
     inline bool isEnabled() const                       { return m_enabled; }
@@ -71,34 +86,58 @@ public:
     inline bool isYield() const                         { return m_yield; }
     inline const Assembly &assembly() const             { return m_assembly; }
     inline const String &argon2Impl() const             { return m_argon2Impl; }
+    inline const std::map<String, String> &grTune() const { return m_grTune; }
     inline const Threads<CpuThreads> &threads() const   { return m_threads; }
+    inline int coSchedule() const                       { return m_coSchedule; }
     inline int priority() const                         { return m_priority; }
     inline size_t hugePageSize() const                  { return m_hugePageSize * 1024U; }
     inline uint32_t limit() const                       { return m_limit; }
 
+#   ifdef XMRIG_ALGO_GHOSTRIDER
+    String grTuneCache() const;
+#   endif
+
 private:
     constexpr static size_t kDefaultHugePageSizeKb  = 2048U;
     constexpr static size_t kOneGbPageSizeKb        = 1048576U;
 
+    std::vector<CpuLaunchData> get(const Miner *miner, const Algorithm &algorithm, const std::vector<CpuThread> &threads, bool coSchedule) const;
     void generate();
     void setAesMode(const rapidjson::Value &value);
     void setHugePages(const rapidjson::Value &value);
     void setMemoryPool(const rapidjson::Value &value);
 
+#   ifdef XMRIG_FEATURE_HWLOC
+    void setKinds(const rapidjson::Value &value);
+#   endif
+
+#   ifdef XMRIG_ALGO_GHOSTRIDER
+    void setGhostRiderTune(const rapidjson::Value &value);
+    void setGhostRiderTuneCache(const rapidjson::Value &value);
+#   endif
+
     inline void setPriority(int priority)   { m_priority = (priority >= -1 && priority <= 5) ? priority : -1; }
 
     AesMode m_aes           = AES_AUTO;
     Assembly m_assembly;
     bool m_enabled          = true;
+    bool m_grTuneCache      = false;
     bool m_hugePagesJit     = false;
     bool m_shouldSave       = false;
     bool m_yield            = true;
+    int m_coSchedule        = -1;
     int m_memoryPool        = 0;
     int m_priority          = -1;
     size_t m_hugePageSize   = kDefaultHugePageSizeKb;
+    std::map<String, String> m_grTune;
     String m_argon2Impl;
+    String m_grTuneCachePath;
     Threads<CpuThreads> m_threads;
     uint32_t m_limit        = 100;
+
+#   ifdef XMRIG_FEATURE_HWLOC
+    ICpuInfo::KindThresholds m_kinds;
+#   endif
 };
 
 
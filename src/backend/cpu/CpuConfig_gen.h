@@ -30,11 +30,32 @@ namespace xmrig {
 
 static inline size_t generate(const char *key, Threads<CpuThreads> &threads, const Algorithm &algorithm, uint32_t limit)
 {
+#   ifdef XMRIG_FEATURE_HWLOC
+    // Hybrid CPUs: a profile generated by an earlier run follows the measured speed of the CPU kinds,
+    // a profile which differs from what was generated was written by the user and is kept
+    if (threads.has(key) && Cpu::info()->isGenerated(key, threads.get(String(key)))) {
+        auto plan = Cpu::info()->threads(algorithm, limit);
+        if (plan == threads.get(String(key))) {
+            return 0;
+        }
+
+        Cpu::info()->setGenerated(key, plan);
+
+        return threads.replace(key, std::move(plan));
+    }
+#   endif
+
     if (threads.isExist(algorithm) || threads.has(key)) {
         return 0;
     }
 
-    return threads.move(key, Cpu::info()->threads(algorithm, limit));
+    auto plan = Cpu::info()->threads(algorithm, limit);
+
+#   ifdef XMRIG_FEATURE_HWLOC
+    Cpu::info()->setGenerated(key, plan);
+#   endif
+
+    return threads.move(key, std::move(plan));
 }
 
 
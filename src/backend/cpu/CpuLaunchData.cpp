@@ -32,12 +32,14 @@
 #include <algorithm>
 
 
-xmrig::CpuLaunchData::CpuLaunchData(const Miner *miner, const Algorithm &algorithm, const CpuConfig &config, const CpuThread &thread, size_t threads, const std::vector<int64_t>& affinities) :
+xmrig::CpuLaunchData::CpuLaunchData(const Miner *miner, const Algorithm &algorithm, const CpuConfig &config, const CpuThread &thread, size_t threads, const std::vector<int64_t>& affinities, bool coSchedule) :
     algorithm(algorithm),
     assembly(config.assembly()),
+    coSchedule(coSchedule),
     hugePages(config.isHugePages()),
-    hwAES(config.isHwAES()),
+    hwAES(config.isHwAES() && thread.variant() != CpuThread::SoftAesVariant),
     yield(config.isYield()),
+    variant(thread.variant()),
     priority(config.priority()),
     affinity(thread.affinity()),
     miner(miner),
@@ -52,9 +54,11 @@ bool xmrig::CpuLaunchData::isEqual(const CpuLaunchData &other) const
 {
     return (algorithm.l3()      == other.algorithm.l3()
             && assembly         == other.assembly
+            && coSchedule       == other.coSchedule
             && hugePages        == other.hugePages
             && hwAES            == other.hwAES
             && intensity        == other.intensity
+            && variant          == other.variant
             && priority         == other.priority
             && affinity         == other.affinity
             );
@@ -27,6 +27,7 @@
 #define XMRIG_CPULAUNCHDATA_H
 
 
+#include "backend/cpu/CpuThread.h"
 #include "base/crypto/Algorithm.h"
 #include "crypto/cn/CnHash.h"
 #include "crypto/common/Assembly.h"
@@ -37,20 +38,21 @@ namespace xmrig {
 
 
 class CpuConfig;
-class CpuThread;
 class Miner;
 
 
 class CpuLaunchData
 {
 public:
-    CpuLaunchData(const Miner *miner, const Algorithm &algorithm, const CpuConfig &config, const CpuThread &thread, size_t threads, const std::vector<int64_t>& affinities);
+    CpuLaunchData(const Miner *miner, const Algorithm &algorithm, const CpuConfig &config, const CpuThread &thread, size_t threads, const std::vector<int64_t>& affinities, bool coSchedule = false);
 
     bool isEqual(const CpuLaunchData &other) const;
     CnHash::AlgoVariant av() const;
 
     inline constexpr static Nonce::Backend backend()            { return Nonce::CPU; }
 
+    inline Nonce::Backend nonce() const                         { return coSchedule ? Nonce::CPU_CO : Nonce::CPU; }
+
     inline bool operator!=(const CpuLaunchData &other) const    { return !isEqual(other); }
     inline bool operator==(const CpuLaunchData &other) const    { return isEqual(other); }
 
@@ -58,9 +60,11 @@ public:
 
     const Algorithm algorithm;
     const Assembly assembly;
+    const bool coSchedule;
     const bool hugePages;
     const bool hwAES;
     const bool yield;
+    const CpuThread::Variant variant;
     const int priority;
     const int64_t affinity;
     const Miner *miner;
@@ -0,0 +1,275 @@
+/* XMRig
+ * Copyright (c) 2018-2024 SChernykh   <https://github.com/SChernykh>
+ * Copyright (c) 2016-2024 XMRig       <https://github.com/xmrig>, <support@xmrig.com>
+ *
+ *   This program is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "backend/cpu/CpuSchedMonitor.h"
+#include "3rdparty/rapidjson/document.h"
+#include "base/io/log/Log.h"
+#include "base/io/log/Tags.h"
+#include "base/tools/Chrono.h"
+
+
+#include <cinttypes>
+#include <cstdio>
+#include <cstring>
+#include <map>
+
+
+namespace xmrig {
+
+
+constexpr uint64_t kInterval    = 5000; // ms between samples
+constexpr double kAlert         = 20.0; // % of wall time waiting for a CPU (run queue wait + steal)
+
+
+#ifdef XMRIG_OS_LINUX
+using CpuTimes = std::map<int64_t, std::pair<uint64_t, uint64_t> >;
+
+
+// Steal and total jiffies for every CPU, the "cpu" line without a number is stored as -1.
+static void readStat(CpuTimes &out)
+{
+    FILE *fp = fopen("/proc/stat", "r");
+    if (!fp) {
+        return;
+    }
+
+    char line[512];
+
+    while (fgets(line, sizeof(line), fp)) {
+        if (strncmp(line, "cpu", 3) != 0) {
+            break;
+        }
+
+        int64_t cpu     = -1;
+        const char *p   = line + 3;
+
+        if (*p != ' ') {
+            char *end = nullptr;
+            cpu       = strtoll(p, &end, 10);
+            p         = end;
+        }
+
+        uint64_t fields[8] = {};
+        if (sscanf(p, "%" SCNu64 " %" SCNu64 " %" SCNu64 " %" SCNu64 " %" SCNu64 " %" SCNu64 " %" SCNu64 " %" SCNu64,
+                   fields, fields + 1, fields + 2, fields + 3, fields + 4, fields + 5, fields + 6, fields + 7) < 8) {
+            continue;
+        }
+
+        uint64_t total = 0;
+        for (uint64_t value : fields) {
+            total += value;
+        }
+
+        out[cpu] = { fields[7], total };
+    }
+
+    fclose(fp);
+}
+
+
+static bool readTask(int64_t tid, uint64_t &run, uint64_t &wait, uint64_t &voluntary, uint64_t &involuntary)
+{
+    char path[64];
+    snprintf(path, sizeof(path), "/proc/self/task/%" PRId64 "/schedstat", tid);
+
+    FILE *fp = fopen(path, "r");
+    if (!fp) {
+        return false;
+    }
+
+    const bool ok = fscanf(fp, "%" SCNu64 " %" SCNu64, &run, &wait) == 2;
+    fclose(fp);
+
+    if (!ok) {
+        return false;
+    }
+
+    snprintf(path, sizeof(path), "/proc/self/task/%" PRId64 "/status", tid);
+
+    fp = fopen(path, "r");
+    if (!fp) {
+        return false;
+    }
+
+    char line[256];
+
+    while (fgets(line, sizeof(line), fp)) {
+        if (strncmp(line, "voluntary_ctxt_switches:", 24) == 0) {
+            voluntary = strtoull(line + 24, nullptr, 10);
+        }
+        else if (strncmp(line, "nonvoluntary_ctxt_switches:", 27) == 0) {
+            involuntary = strtoull(line + 27, nullptr, 10);
+        }
+    }
+
+    fclose(fp);
+
+    return true;
+}
+#endif
+
+
+} // namespace xmrig
+
+
+double xmrig::CpuSchedMonitor::contention() const
+{
+    double sum      = 0.0;
+    size_t count    = 0;
+
+    for (const auto &sample : m_samples) {
+        if (sample.valid && sample.run > 0.0) {
+            sum += sample.wait + sample.steal;
+            ++count;
+        }
+    }
+
+    return count ? sum / count : 0.0;
+}
+
+
+rapidjson::Value xmrig::CpuSchedMonitor::toJSON(size_t index, rapidjson::Document &doc) const
+{
+    using namespace rapidjson;
+
+    if (index >= m_samples.size() || !m_samples[index].valid) {
+        return Value(kNullType);
+    }
+
+    auto &allocator     = doc.GetAllocator();
+    const auto &sample  = m_samples[index];
+
+    Value out(kObjectType);
+    out.AddMember("run",            sample.run, allocator);
+    out.AddMember("wait",           sample.wait, allocator);
+    out.AddMember("steal",          sample.steal, allocator);
+    out.AddMember("voluntary",      sample.voluntary, allocator);
+    out.AddMember("involuntary",    sample.involuntary, allocator);
+
+    return out;
+}
+
+
+void xmrig::CpuSchedMonitor::print(const std::vector<int64_t> &affinities) const
+{
+    if (!m_ready) {
+        return;
+    }
+
+    Log::print(WHITE_BOLD_S "|    CPU # | AFFINITY |  RUN % | WAIT % | STEAL % |  VCSW/s | NVCSW/s |");
+
+    for (size_t i = 0; i < m_samples.size(); ++i) {
+        const auto &sample = m_samples[i];
+        if (!sample.valid) {
+            continue;
+        }
+
+        Log::print("| %8zu | %8" PRId64 " | %6.1f | %s%6.1f" CLEAR " | %s%7.1f" CLEAR " | %7.1f | %7.1f |",
+                   i,
+                   i < affinities.size() ? affinities[i] : -1,
+                   sample.run,
+                   sample.wait + sample.steal > kAlert ? YELLOW_BOLD_S : "",
+                   sample.wait,
+                   sample.steal > kAlert ? YELLOW_BOLD_S : "",
+                   sample.steal,
+                   sample.voluntary,
+                   sample.involuntary
+                   );
+    }
+}
+
+
+void xmrig::CpuSchedMonitor::reset()
+{
+    m_ready = false;
+    m_next  = 0;
+    m_ts    = 0;
+
+    m_alerts.clear();
+    m_counters.clear();
+    m_samples.clear();
+}
+
+
+void xmrig::CpuSchedMonitor::tick(const std::vector<int64_t> &tids, const std::vector<int64_t> &affinities)
+{
+#   ifdef XMRIG_OS_LINUX
+    const uint64_t now = Chrono::steadyMSecs();
+    if (now < m_next) {
+        return;
+    }
+
+    m_next = now + kInterval;
+
+    if (m_counters.size() != tids.size()) {
+        m_alerts.assign(tids.size(), false);
+        m_counters.assign(tids.size(), {});
+        m_samples.assign(tids.size(), {});
+        m_ts = 0;
+    }
+
+    CpuTimes cpus;
+    readStat(cpus);
+
+    const double elapsed = m_ts ? static_cast<double>(now - m_ts) : 0.0;
+    m_ready              = false;
+
+    for (size_t i = 0; i < tids.size(); ++i) {
+        Counters counters;
+        counters.tid = tids[i];
+
+        const bool ok = counters.tid > 0 && readTask(counters.tid, counters.run, counters.wait, counters.voluntary, counters.involuntary);
+
+        const auto cpu = cpus.find(i < affinities.size() ? affinities[i] : -1);
+        if (cpu != cpus.end()) {
+            counters.steal = cpu->second.first;
+            counters.total = cpu->second.second;
+        }
+
+        auto &prev   = m_counters[i];
+        auto &sample = m_samples[i];
+
+        sample.valid = ok && elapsed > 0.0 && prev.tid == counters.tid && counters.run >= prev.run;
+
+        if (sample.valid) {
+            sample.run          = static_cast<double>(counters.run - prev.run) / (elapsed * 1e4);
+            sample.wait         = static_cast<double>(counters.wait - prev.wait) / (elapsed * 1e4);
+            sample.voluntary    = static_cast<double>(counters.voluntary - prev.voluntary) / (elapsed / 1000.0);
+            sample.involuntary  = static_cast<double>(counters.involuntary - prev.involuntary) / (elapsed / 1000.0);
+            sample.steal        = counters.total > prev.total ? static_cast<double>(counters.steal - prev.steal) * 100.0 / (counters.total - prev.total) : 0.0;
+
+            m_ready = true;
+
+            const bool alert = sample.wait + sample.steal > kAlert;
+            if (alert && !m_alerts[i]) {
+                LOG_WARN("%s " WHITE_BOLD("#%zu") YELLOW(" waits for a CPU ") YELLOW_BOLD("%.0f%%") YELLOW(" of the time (run queue %.0f%%, steal %.0f%%, %.0f preemptions/s)"),
+                         Tags::cpu(), i, sample.wait + sample.steal, sample.wait, sample.steal, sample.involuntary);
+            }
+
+            m_alerts[i] = alert;
+        }
+
+        prev = counters;
+    }
+
+    m_ts = now;
+#   else
+    (void) tids;
+    (void) affinities;
+#   endif
+}
@@ -0,0 +1,86 @@
+/* XMRig
+ * Copyright (c) 2018-2024 SChernykh   <https://github.com/SChernykh>
+ * Copyright (c) 2016-2024 XMRig       <https://github.com/xmrig>, <support@xmrig.com>
+ *
+ *   This program is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef XMRIG_CPUSCHEDMONITOR_H
+#define XMRIG_CPUSCHEDMONITOR_H
+
+
+#include "3rdparty/rapidjson/fwd.h"
+
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+
+namespace xmrig
+{
+
+
+/**
+ * Per worker scheduler statistics: share of wall time spent running and waiting on a run queue
+ * (/proc/self/task/<tid>/schedstat), context switches per second and hypervisor steal of the CPU
+ * the worker is pinned to (/proc/stat). Sampled every 5 seconds, Linux only.
+ */
+class CpuSchedMonitor
+{
+public:
+    struct Sample
+    {
+        bool valid          = false;
+        double run          = 0.0;  // %
+        double wait         = 0.0;  // %
+        double steal        = 0.0;  // %
+        double voluntary    = 0.0;  // per second
+        double involuntary  = 0.0;  // per second
+    };
+
+    inline bool isReady() const                         { return m_ready; }
+    inline const std::vector<Sample> &samples() const   { return m_samples; }
+
+    double contention() const;
+    rapidjson::Value toJSON(size_t index, rapidjson::Document &doc) const;
+    void print(const std::vector<int64_t> &affinities) const;
+    void reset();
+    void tick(const std::vector<int64_t> &tids, const std::vector<int64_t> &affinities);
+
+private:
+    struct Counters
+    {
+        int64_t tid         = -1;
+        uint64_t run        = 0;
+        uint64_t wait       = 0;
+        uint64_t voluntary  = 0;
+        uint64_t involuntary = 0;
+        uint64_t steal      = 0;
+        uint64_t total      = 0;
+    };
+
+    bool m_ready            = false;
+    std::vector<bool> m_alerts;
+    std::vector<Counters> m_counters;
+    std::vector<Sample> m_samples;
+    uint64_t m_next         = 0;
+    uint64_t m_ts           = 0;
+};
+
+
+} /* namespace xmrig */
+
+
+#endif /* XMRIG_CPUSCHEDMONITOR_H */
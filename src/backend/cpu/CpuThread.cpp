@@ -28,11 +28,33 @@
 #include "base/io/json/Json.h"
 
 
+#include <array>
+#include <cstring>
+
+
+#ifdef _MSC_VER
+#   define strcasecmp  _stricmp
+#endif
+
+
+namespace xmrig {
+
+
+static const std::array<const char *, CpuThread::VariantMax> variantNames = { "auto", "jit", "interpreter", "light", "soft-aes" };
+
+
+} // namespace xmrig
+
+
 xmrig::CpuThread::CpuThread(const rapidjson::Value &value)
 {
     if (value.IsArray() && value.Size() >= 2) {
         m_intensity = value[0].GetUint();
         m_affinity  = value[1].GetInt();
+
+        if (value.Size() >= 3) {
+            m_variant = readVariant(value[2]);
+        }
     }
     else if (value.IsInt()) {
         m_intensity = 0;
@@ -44,15 +66,39 @@ xmrig::CpuThread::CpuThread(const rapidjson::Value &value)
 rapidjson::Value xmrig::CpuThread::toJSON(rapidjson::Document &doc) const
 {
     using namespace rapidjson;
-    if (m_intensity == 0) {
+    if (m_intensity == 0 && m_variant == AutoVariant) {
         return Value(m_affinity);
     }
 
     auto &allocator = doc.GetAllocator();
 
     Value out(kArrayType);
-    out.PushBack(m_intensity, allocator);
+    out.PushBack(intensity(), allocator);
     out.PushBack(m_affinity, allocator);
 
+    if (m_variant != AutoVariant) {
+        out.PushBack(StringRef(variantName()), allocator);
+    }
+
     return out;
 }
+
+
+const char *xmrig::CpuThread::variantName(Variant variant)
+{
+    return variant < VariantMax ? variantNames[variant] : variantNames[AutoVariant];
+}
+
+
+xmrig::CpuThread::Variant xmrig::CpuThread::readVariant(const rapidjson::Value &value)
+{
+    if (value.IsString()) {
+        for (size_t i = 0; i < variantNames.size(); i++) {
+            if (strcasecmp(value.GetString(), variantNames[i]) == 0) {
+                return static_cast<Variant>(i);
+            }
+        }
+    }
+
+    return AutoVariant;
+}
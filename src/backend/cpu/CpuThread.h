@@ -35,24 +35,41 @@ namespace xmrig {
 class CpuThread
 {
 public:
+    // Per-thread VM flavor, allows different kernels on SoCs that mix core types.
+    enum Variant : uint32_t {
+        AutoVariant,
+        JitVariant,
+        InterpreterVariant,
+        LightVariant,
+        SoftAesVariant,
+        VariantMax
+    };
+
     inline constexpr CpuThread() = default;
-    inline constexpr CpuThread(int64_t affinity, uint32_t intensity) : m_affinity(affinity), m_intensity(intensity) {}
+    inline constexpr CpuThread(int64_t affinity, uint32_t intensity, Variant variant = AutoVariant) : m_affinity(affinity), m_intensity(intensity), m_variant(variant) {}
 
     CpuThread(const rapidjson::Value &value);
 
-    inline bool isEqual(const CpuThread &other) const       { return other.m_affinity == m_affinity && other.m_intensity == m_intensity; }
+    inline bool isEqual(const CpuThread &other) const       { return other.m_affinity == m_affinity && other.m_intensity == m_intensity && other.m_variant == m_variant; }
     inline bool isValid() const                             { return m_intensity <= 8; }
     inline int64_t affinity() const                         { return m_affinity; }
     inline uint32_t intensity() const                       { return m_intensity == 0 ? 1 : m_intensity; }
+    inline Variant variant() const                          { return m_variant; }
+    inline const char *variantName() const                  { return variantName(m_variant); }
 
     inline bool operator!=(const CpuThread &other) const    { return !isEqual(other); }
     inline bool operator==(const CpuThread &other) const    { return isEqual(other); }
 
     rapidjson::Value toJSON(rapidjson::Document &doc) const;
 
+    static const char *variantName(Variant variant);
+
 private:
+    static Variant readVariant(const rapidjson::Value &value);
+
     int64_t m_affinity   = -1;
     uint32_t m_intensity = 0;
+    Variant m_variant    = AutoVariant;
 };
 
 
@@ -0,0 +1,259 @@
+/* XMRig
+ * Copyright (c) 2018-2024 SChernykh   <https://github.com/SChernykh>
+ * Copyright (c) 2016-2024 XMRig       <https://github.com/xmrig>, <support@xmrig.com>
+ *
+ *   This program is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "backend/cpu/CpuThreadTuner.h"
+#include "3rdparty/rapidjson/document.h"
+#include "backend/common/Hashrate.h"
+#include "base/io/log/Log.h"
+#include "base/io/log/Tags.h"
+#include "base/tools/Chrono.h"
+#include "crypto/common/Nonce.h"
+
+
+#include <algorithm>
+#include <cmath>
+
+
+#ifdef XMRIG_OS_LINUX
+#   include <fstream>
+#endif
+
+
+namespace xmrig {
+
+
+constexpr uint64_t kSettle      = 5000;                                 // ms after a change before the hashrate window starts
+constexpr uint64_t kWindow      = kSettle + Hashrate::ShortInterval;    // ms per measurement
+constexpr uint64_t kFirstRound  = 60000;                                // ms, upper bound for the first round after start
+constexpr double kMargin        = 0.02;                                 // required gain, below it the difference is noise
+constexpr double kDrift         = 5.0;                                  // % points of CPU contention change that invalidate a trial
+constexpr size_t kHistory       = 16;
+
+
+static bool readEnergy(uint64_t &uj)
+{
+#   ifdef XMRIG_OS_LINUX
+    std::ifstream file("/sys/class/powercap/intel-rapl:0/energy_uj");
+
+    return static_cast<bool>(file >> uj);
+#   else
+    return false;
+#   endif
+}
+
+
+} // namespace xmrig
+
+
+void xmrig::CpuThreadTuner::reset(size_t threads)
+{
+    if (m_threads != threads) {
+        m_active  = threads;
+        m_threads = threads;
+    }
+
+    m_state     = STATE_IDLE;
+    m_failures  = 0;
+    m_deadline  = 0;
+}
+
+
+void xmrig::CpuThreadTuner::tick(Workers<CpuLaunchData> &workers, const Algorithm &algorithm, uint32_t interval, double contention)
+{
+    m_contention = contention;
+    m_interval   = static_cast<uint64_t>(interval) * 1000;
+    m_enabled  = m_interval > 0 && algorithm.family() == Algorithm::RANDOM_X && m_threads > 1;
+
+    if (!m_enabled) {
+        if (m_active != m_threads) {
+            m_active = m_threads;
+            m_state  = STATE_IDLE;
+        }
+
+        return workers.setActive(m_threads);
+    }
+
+    // Applied on every tick, workers of a restarted backend are created asynchronously.
+    workers.setActive(m_state == STATE_TRIAL ? m_candidate : m_active);
+
+    const uint64_t now = Chrono::steadyMSecs();
+    if (m_deadline == 0) {
+        m_deadline = now + std::min(m_interval, kFirstRound);
+    }
+
+    if (now < m_deadline) {
+        return;
+    }
+
+    const Hashrate *hashrate = workers.hashrate();
+    const auto h             = hashrate ? hashrate->calc(Hashrate::ShortInterval) : std::pair<bool, double>(false, 0.0);
+    const bool valid         = h.first && h.second > 0.0 && !Nonce::isPaused();
+
+    switch (m_state) {
+    case STATE_IDLE:
+        m_state = STATE_BASELINE;
+        break;
+
+    case STATE_BASELINE:
+        if (!valid) {
+            break;
+        }
+
+        m_base              = score(h.second, now);
+        m_baseContention    = m_contention;
+        m_perWatt           = m_watts > 0.0;
+
+        if (next()) {
+            m_state = STATE_TRIAL;
+        }
+        else {
+            m_state     = STATE_IDLE;
+            m_deadline  = now + m_interval;
+
+            return;
+        }
+        break;
+
+    case STATE_TRIAL:
+        {
+            if (!valid) {
+                m_state = STATE_BASELINE;
+                break;
+            }
+
+            const double value = score(h.second, now);
+
+            // Energy counters became readable or went away, or other processes took or released CPU time between the two measurements, they aren't comparable.
+            if ((m_watts > 0.0) != m_perWatt || std::fabs(m_contention - m_baseContention) > kDrift) {
+                m_state = STATE_BASELINE;
+                break;
+            }
+
+            const double gain   = value / m_base - 1.0;
+            const bool accepted = gain > kMargin;
+
+            m_history.push_back({ Chrono::currentMSecsSinceEpoch(), m_active, m_candidate, gain, accepted });
+            if (m_history.size() > kHistory) {
+                m_history.pop_front();
+            }
+
+            if (accepted) {
+                LOG_INFO("%s " WHITE_BOLD("auto-threads") " RandomX threads " CYAN_BOLD("%zu") " -> " CYAN_BOLD("%zu") GREEN_BOLD(" +%.1f%%") " %s",
+                         Tags::cpu(), m_active, m_candidate, gain * 100.0, m_watts > 0.0 ? "H/s per watt" : "H/s");
+
+                m_active   = m_candidate;
+                m_failures = 0;
+            }
+            else {
+                m_direction = -m_direction;
+
+                if (++m_failures >= 2) {
+                    m_failures  = 0;
+                    m_state     = STATE_IDLE;
+                    m_deadline  = now + m_interval;
+
+                    return;
+                }
+            }
+
+            // Conditions may have changed during the trial, the next one starts from a fresh baseline.
+            m_state = STATE_BASELINE;
+        }
+        break;
+    }
+
+    workers.setActive(m_state == STATE_TRIAL ? m_candidate : m_active);
+
+    mark(now);
+    m_deadline = now + kWindow;
+}
+
+
+rapidjson::Value xmrig::CpuThreadTuner::toJSON(rapidjson::Document &doc) const
+{
+    using namespace rapidjson;
+    auto &allocator = doc.GetAllocator();
+
+    Value out(kObjectType);
+    out.AddMember("enabled",    m_enabled, allocator);
+    out.AddMember("active",     static_cast<uint64_t>(m_active), allocator);
+    out.AddMember("threads",    static_cast<uint64_t>(m_threads), allocator);
+    out.AddMember("watts",      m_watts > 0.0 ? Value(m_watts) : Value(kNullType), allocator);
+    out.AddMember("contention", m_contention, allocator);
+
+    Value history(kArrayType);
+
+    for (const auto &decision : m_history) {
+        Value item(kObjectType);
+        item.AddMember("ts",        decision.ts, allocator);
+        item.AddMember("from",      static_cast<uint64_t>(decision.from), allocator);
+        item.AddMember("to",        static_cast<uint64_t>(decision.to), allocator);
+        item.AddMember("gain",      decision.gain, allocator);
+        item.AddMember("accepted",  decision.accepted, allocator);
+
+        history.PushBack(item, allocator);
+    }
+
+    out.AddMember("history", history, allocator);
+
+    return out;
+}
+
+
+bool xmrig::CpuThreadTuner::next()
+{
+    for (size_t i = 0; i < 2; ++i) {
+        const size_t candidate = m_direction > 0 ? m_active + 1 : m_active - 1;
+
+        if (candidate >= 1 && candidate <= m_threads) {
+            m_candidate = candidate;
+
+            return true;
+        }
+
+        m_direction = -m_direction;
+    }
+
+    return false;
+}
+
+
+double xmrig::CpuThreadTuner::score(double hashrate, uint64_t now)
+{
+    uint64_t energy = 0;
+
+    if (m_energy && readEnergy(energy) && energy > m_energy && now > m_ts) {
+        m_watts = static_cast<double>(energy - m_energy) / static_cast<double>(now - m_ts) / 1000.0;
+
+        return hashrate / m_watts;
+    }
+
+    m_watts = 0.0;
+
+    return hashrate;
+}
+
+
+void xmrig::CpuThreadTuner::mark(uint64_t now)
+{
+    m_ts = now;
+
+    if (!readEnergy(m_energy)) {
+        m_energy = 0;
+    }
+}
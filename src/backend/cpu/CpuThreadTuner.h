@@ -0,0 +1,93 @@
+/* XMRig
+ * Copyright (c) 2018-2024 SChernykh   <https://github.com/SChernykh>
+ * Copyright (c) 2016-2024 XMRig       <https://github.com/xmrig>, <support@xmrig.com>
+ *
+ *   This program is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef XMRIG_CPUTHREADTUNER_H
+#define XMRIG_CPUTHREADTUNER_H
+
+
+#include "3rdparty/rapidjson/fwd.h"
+#include "backend/common/Workers.h"
+#include "base/crypto/Algorithm.h"
+
+
+#include <deque>
+
+
+namespace xmrig
+{
+
+
+/**
+ * Online RandomX thread count controller: every "auto-threads" seconds it parks or wakes up one worker,
+ * compares the total hashrate (hashrate per watt if RAPL energy counters are readable) with the current
+ * count and keeps the better one. It follows memory bandwidth contention from other tenants, the threads
+ * stay allocated and parked workers only sleep. A trial is discarded when the CPU contention measured by
+ * CpuSchedMonitor (run queue wait + steal) moved between the two measurements.
+ */
+class CpuThreadTuner
+{
+public:
+    void reset(size_t threads);
+    void tick(Workers<CpuLaunchData> &workers, const Algorithm &algorithm, uint32_t interval, double contention);
+
+    rapidjson::Value toJSON(rapidjson::Document &doc) const;
+
+private:
+    enum State {
+        STATE_IDLE,
+        STATE_BASELINE,
+        STATE_TRIAL
+    };
+
+    struct Decision
+    {
+        uint64_t ts;
+        size_t from;
+        size_t to;
+        double gain;
+        bool accepted;
+    };
+
+    bool next();
+    double score(double hashrate, uint64_t now);
+    void mark(uint64_t now);
+
+    bool m_enabled          = false;
+    bool m_perWatt          = false;
+    double m_base           = 0.0;
+    double m_baseContention = 0.0;
+    double m_contention     = 0.0;
+    double m_watts          = 0.0;
+    int m_direction         = -1;
+    size_t m_active         = 0;
+    size_t m_candidate      = 0;
+    size_t m_failures       = 0;
+    size_t m_threads        = 0;
+    State m_state           = STATE_IDLE;
+    std::deque<Decision> m_history;
+    uint64_t m_deadline     = 0;
+    uint64_t m_energy       = 0;
+    uint64_t m_interval     = 0;
+    uint64_t m_ts           = 0;
+};
+
+
+} /* namespace xmrig */
+
+
+#endif /* XMRIG_CPUTHREADTUNER_H */
@@ -52,7 +52,12 @@
 
 namespace xmrig {
 
-static constexpr uint32_t kReserveCount = 32768;
+static constexpr uint32_t kReserveCount      = 32768;
+static constexpr uint32_t kMinReserveCount   = 256;
+static constexpr uint32_t kReserveFraction   = 8;
+static constexpr uint32_t kParkTimeout       = 500;  // ms, only a safety net, every wake-up source calls Parking::wake()
+static constexpr size_t kMaxResults          = 64;   // buffered shares per worker before a hand-off is forced
+static constexpr uint64_t kResultsDelay      = 20;   // ms, upper bound for holding a found share
 
 
 #ifdef XMRIG_ALGO_CN_HEAVY
@@ -69,13 +74,18 @@ xmrig::CpuWorker<N>::CpuWorker(size_t id, const CpuLaunchData &data) :
     Worker(id, data.affinity, data.priority),
     m_algorithm(data.algorithm),
     m_assembly(data.assembly),
+    m_coSchedule(data.coSchedule),
     m_hwAES(data.hwAES),
     m_yield(data.yield),
     m_av(data.av()),
+    m_variant(data.variant),
     m_miner(data.miner),
+    m_nonce(data.nonce()),
     m_threads(data.threads),
     m_ctx()
 {
+    m_results.reserve(kMaxResults);
+
 #   ifdef XMRIG_ALGO_CN_HEAVY
     // cn-heavy optimization for Zen3 CPUs
     const auto arch = Cpu::info()->arch();
@@ -129,24 +139,30 @@ xmrig::CpuWorker<N>::~CpuWorker()
 template<size_t N>
 void xmrig::CpuWorker<N>::allocateRandomX_VM()
 {
+    uint32_t epoch     = Parking::epoch();
     RxDataset *dataset = Rx::dataset(m_job.currentJob(), node());
 
     while (dataset == nullptr) {
-        std::this_thread::sleep_for(std::chrono::milliseconds(20));
+        Parking::wait(epoch, kParkTimeout);
 
-        if (Nonce::sequence(Nonce::CPU) == 0) {
+        if (Nonce::sequence(m_nonce) == 0) {
             return;
         }
 
+        epoch   = Parking::epoch();
         dataset = Rx::dataset(m_job.currentJob(), node());
+        m_resumed = true;
+        m_rateTs  = 0;
     }
 
+    const bool light = !dataset->get() || (m_variant == CpuThread::LightVariant && dataset->cache() && dataset->cache()->get());
+
     if (!m_vm) {
         // Try to allocate scratchpad from dataset's 1 GB huge pages, if normal huge pages are not available
         uint8_t* scratchpad = m_memory->isHugePages() ? m_memory->scratchpad() : dataset->tryAllocateScrathpad();
-        m_vm = RxVm::create(dataset, scratchpad ? scratchpad : m_memory->scratchpad(), !m_hwAES, m_assembly, node());
+        m_vm = RxVm::create(dataset, scratchpad ? scratchpad : m_memory->scratchpad(), !m_hwAES, m_assembly, node(), light, m_variant == CpuThread::InterpreterVariant, m_variant == CpuThread::JitVariant);
     }
-    else if (!dataset->get() && (m_job.currentJob().seed() != m_seed)) {
+    else if (light && (m_job.currentJob().seed() != m_seed)) {
         // Update RandomX light VM with the new seed
         randomx_vm_set_cache(m_vm, dataset->cache()->get());
     }
@@ -168,7 +184,8 @@ bool xmrig::CpuWorker<N>::selfTest()
 
 #   ifdef XMRIG_ALGO_GHOSTRIDER
     if (m_algorithm.family() == Algorithm::GHOSTRIDER) {
-        return (N == 8) && verify(Algorithm::GHOSTRIDER_RTM, test_output_gr);
+        // test_output_gr goes through the multi-buffer core hashes too, verify_x4() also covers the cores it doesn't select.
+        return (N == 8) && verify(Algorithm::GHOSTRIDER_RTM, test_output_gr) && ghostrider::verify_x4();
     }
 #   endif
 
@@ -240,14 +257,20 @@ void xmrig::CpuWorker<N>::hashrateData(uint64_t &hashCount, uint64_t &, uint64_t
 template<size_t N>
 void xmrig::CpuWorker<N>::start()
 {
-    while (Nonce::sequence(Nonce::CPU) > 0) {
-        if (Nonce::isPaused()) {
-            do {
-                std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    while (Nonce::sequence(m_nonce) > 0) {
+        if (Nonce::isPaused() || isParked() || m_job.isExhausted()) {
+            uint32_t epoch = Parking::epoch();
+
+            while ((Nonce::isPaused() || isParked() || m_job.isExhausted()) && Nonce::sequence(m_nonce) > 0) {
+                Parking::wait(epoch, kParkTimeout);
+                epoch = Parking::epoch();
             }
-            while (Nonce::isPaused() && Nonce::sequence(Nonce::CPU) > 0);
 
-            if (Nonce::sequence(Nonce::CPU) == 0) {
+            // Time spent paused or parked must not lower the measured hash rate used to size nonce reservations.
+            m_resumed = true;
+            m_rateTs  = 0;
+
+            if (Nonce::sequence(m_nonce) == 0) {
                 break;
             }
 
@@ -259,7 +282,7 @@ void xmrig::CpuWorker<N>::start()
         alignas(16) uint64_t tempHash[8] = {};
 #       endif
 
-        while (!Nonce::isOutdated(Nonce::CPU, m_job.sequence())) {
+        while (!Nonce::isOutdated(m_nonce, m_job.sequence()) && !isParked()) {
             const Job &job = m_job.currentJob();
 
             if (job.algorithm().l3() != m_algorithm.l3()) {
@@ -274,12 +297,16 @@ void xmrig::CpuWorker<N>::start()
 #           ifdef XMRIG_FEATURE_BENCHMARK
             if (m_benchSize) {
                 if (current_job_nonces[0] >= m_benchSize) {
+                    BenchState::add(m_benchData);
+                    m_benchData = 0;
+
                     return BenchState::done();
                 }
 
-                // Make each hash dependent on the previous one in single thread benchmark to prevent cheating with multiple threads
+                // Make each hash dependent on the previous one in single thread benchmark to prevent cheating with multiple threads,
+                // this thread is the only writer so the shared value plus the local accumulator is the current state.
                 if (m_threads == 1) {
-                    *(uint64_t*)(m_job.blob()) ^= BenchState::data();
+                    *(uint64_t*)(m_job.blob()) ^= BenchState::data() ^ m_benchData;
                 }
             }
 #           endif
@@ -336,22 +363,51 @@ void xmrig::CpuWorker<N>::start()
             }
 
             if (valid) {
-                for (size_t i = 0; i < N; ++i) {
-                    const uint64_t value = *reinterpret_cast<uint64_t*>(m_hash + (i * 32) + 24);
+                const uint64_t *values = reinterpret_cast<const uint64_t*>(m_hash + 24);
 
-#                   ifdef XMRIG_FEATURE_BENCHMARK
-                    if (m_benchSize) {
+#               ifdef XMRIG_FEATURE_BENCHMARK
+                if (m_benchSize) {
+                    for (size_t i = 0; i < N; ++i) {
                         if (current_job_nonces[i] < m_benchSize) {
-                            BenchState::add(value);
+                            m_benchData ^= values[i * 4];
                         }
                     }
-                    else
-#                   endif
-                    if (value < job.target()) {
-                        JobResults::submit(job, current_job_nonces[i], m_hash + (i * 32), job.hasMinerSignature() ? miner_signature_saved : nullptr);
+                }
+                else
+#               endif
+                {
+                    // Branch free over all lanes, shares are rare and only a non zero mask takes the slow path.
+                    const uint64_t target = job.target();
+                    uint32_t found        = 0;
+
+                    for (size_t i = 0; i < N; ++i) {
+                        found |= static_cast<uint32_t>(values[i * 4] < target) << i;
+                    }
+
+                    if (found) {
+                        if (m_results.empty()) {
+                            m_resultsTs = Chrono::steadyMSecs();
+                        }
+
+                        for (size_t i = 0; i < N; ++i) {
+                            if (found & (1U << i)) {
+                                m_results.emplace_back(job, current_job_nonces[i], m_hash + (i * 32), nullptr, nullptr, job.hasMinerSignature() ? miner_signature_saved : nullptr);
+                            }
+                        }
+                    }
+
+                    // Shares of a replaced job are handed off at once, the next round can't outgrow the reserved buffer.
+                    if (!m_results.empty() && (m_results.size() + N > kMaxResults || Nonce::isOutdated(m_nonce, m_job.sequence()) || Chrono::steadyMSecs() - m_resultsTs >= kResultsDelay)) {
+                        flushResults();
                     }
                 }
+
                 m_count += N;
+
+                if (m_resumed) {
+                    m_resumed = false;
+                    Parking::resumed();
+                }
             }
 
             if (m_yield) {
@@ -359,7 +415,14 @@ void xmrig::CpuWorker<N>::start()
             }
         }
 
-        if (!Nonce::isPaused()) {
+        flushResults();
+
+#       ifdef XMRIG_FEATURE_BENCHMARK
+        BenchState::add(m_benchData);
+        m_benchData = 0;
+#       endif
+
+        if (!Nonce::isPaused() && !isParked()) {
             consumeJob();
         }
     }
@@ -369,13 +432,12 @@ void xmrig::CpuWorker<N>::start()
 template<size_t N>
 bool xmrig::CpuWorker<N>::nextRound()
 {
-#   ifdef XMRIG_FEATURE_BENCHMARK
-    const uint32_t count = m_benchSize ? 1U : kReserveCount;
-#   else
-    constexpr uint32_t count = kReserveCount;
-#   endif
+    // End of the reserved nonce block.
+    if (m_job.unused() <= N) {
+        flushResults();
+    }
 
-    if (!m_job.nextRound(count, 1)) {
+    if (!m_job.nextRound(m_job.reserveCount(), 1)) {
         JobResults::done(m_job.currentJob());
 
         return false;
@@ -424,6 +486,30 @@ bool xmrig::CpuWorker<N>::verify(const Algorithm &algorithm, const uint8_t *refe
         return false;
     }
 
+#   ifdef XMRIG_ALGO_ARGON2
+    if (algorithm.family() == Algorithm::ARGON2 && N > 1) {
+        // Scratchpads are m_algorithm.l3() apart, a variant with a larger scratchpad always runs with its own profile
+        if (algorithm.l3() > m_algorithm.l3()) {
+            return true;
+        }
+
+        // Only the first hash has a reference value: move the reference input through all lanes, with different inputs in the other lanes
+        for (size_t r = 0; r < N; ++r) {
+            for (size_t k = 0; k < N; ++k) {
+                memcpy(m_job.blob() + k * 76, test_input + ((k + N - r) % N) * 76, 76);
+            }
+
+            func(m_job.blob(), 76, m_hash, m_ctx, 0);
+
+            if (memcmp(m_hash + r * 32, referenceValue, 32) != 0) {
+                return false;
+            }
+        }
+
+        return true;
+    }
+#   endif
+
     func(test_input, 76, m_hash, m_ctx, 0);
     return memcmp(m_hash, referenceValue, sizeof m_hash) == 0;
 }
@@ -480,6 +566,52 @@ bool CpuWorker<1>::verify2(const Algorithm &algorithm, const uint8_t *referenceV
 } // namespace xmrig
 
 
+template<size_t N>
+uint32_t xmrig::CpuWorker<N>::reserveCount(const Job &job)
+{
+    const uint64_t now = Chrono::steadyMSecs();
+
+    if (now - m_rateTs >= 1000) {
+        if (m_rateTs) {
+            m_rate = static_cast<double>(m_count - m_rateCount) / static_cast<double>(now - m_rateTs);
+        }
+
+        m_rateTs    = now;
+        m_rateCount = m_count;
+    }
+
+    Nonce::waste(m_job.abandoned(job));
+
+    if (job.index() == m_job.index() && job != m_job.currentJob() && m_job.currentJob().isValid()) {
+        const uint64_t lifetime = now - m_jobTs;
+        m_jobLifetime = m_jobLifetime ? (m_jobLifetime * 3 + lifetime) / 4 : lifetime;
+        m_jobTs       = now;
+    }
+    else if (!m_jobTs) {
+        m_jobTs = now;
+    }
+
+    // Each reservation should last a fraction of the expected job lifetime, so little is lost on job switch.
+    uint64_t count = kReserveCount;
+    if (m_rate > 0.0 && m_jobLifetime > 0) {
+        count = std::max<uint64_t>(static_cast<uint64_t>(m_rate / N * static_cast<double>(m_jobLifetime) / kReserveFraction), kMinReserveCount);
+    }
+
+    // Small nonce space (nicehash behind a proxy) must leave room for every thread.
+    const uint64_t space = (job.nonceMask() & 0x7FFFFFFFFFFFFFFFULL) + 1;
+    count = std::min<uint64_t>(count, std::max<uint64_t>(space / (m_threads * N * kReserveFraction), 1));
+    count = std::min<uint64_t>(count, kReserveCount);
+
+    // Power of two, WorkerJob::nextRound() masks the round counter.
+    uint32_t result = 1;
+    while (result * 2 <= count) {
+        result *= 2;
+    }
+
+    return result;
+}
+
+
 template<size_t N>
 void xmrig::CpuWorker<N>::allocateCnCtx()
 {
@@ -498,23 +630,35 @@ void xmrig::CpuWorker<N>::allocateCnCtx()
 }
 
 
+template<size_t N>
+void xmrig::CpuWorker<N>::flushResults()
+{
+    if (!m_results.empty()) {
+        JobResults::submit(m_results);
+        m_results.clear();
+    }
+}
+
+
 template<size_t N>
 void xmrig::CpuWorker<N>::consumeJob()
 {
-    if (Nonce::sequence(Nonce::CPU) == 0) {
+    flushResults();
+
+    if (Nonce::sequence(m_nonce) == 0) {
         return;
     }
 
-    auto job = m_miner->job();
+    auto job = m_coSchedule ? m_miner->coJob() : m_miner->job();
 
 #   ifdef XMRIG_FEATURE_BENCHMARK
     m_benchSize          = job.benchSize();
-    const uint32_t count = m_benchSize ? 1U : kReserveCount;
+    const uint32_t count = m_benchSize ? 1U : reserveCount(job);
 #   else
-    constexpr uint32_t count = kReserveCount;
+    const uint32_t count = reserveCount(job);
 #   endif
 
-    m_job.add(job, count, Nonce::CPU);
+    m_job.add(job, count, m_nonce);
 
 #   ifdef XMRIG_ALGO_RANDOMX
     if (m_job.currentJob().algorithm().family() == Algorithm::RANDOM_X) {
@@ -27,6 +27,9 @@
 #include "net/JobResult.h"
 
 
+#include <vector>
+
+
 #ifdef XMRIG_ALGO_RANDOMX
 class randomx_vm;
 #endif
@@ -80,20 +83,34 @@ private:
     bool nextRound();
     bool verify(const Algorithm &algorithm, const uint8_t *referenceValue);
     bool verify2(const Algorithm &algorithm, const uint8_t *referenceValue);
+    uint32_t reserveCount(const Job &job);
     void allocateCnCtx();
     void consumeJob();
+    void flushResults();
 
     alignas(8) uint8_t m_hash[N * 32]{ 0 };
     const Algorithm m_algorithm;
     const Assembly m_assembly;
+    const bool m_coSchedule;
     const bool m_hwAES;
     const bool m_yield;
     const CnHash::AlgoVariant m_av;
+    const CpuThread::Variant m_variant;
     const Miner *m_miner;
+    const Nonce::Backend m_nonce;
     const size_t m_threads;
     cryptonight_ctx *m_ctx[N];
     VirtualMemory *m_memory = nullptr;
     WorkerJob<N> m_job;
+    std::vector<JobResult> m_results;
+
+    bool m_resumed          = false;
+    double m_rate           = 0.0;
+    uint64_t m_jobLifetime  = 0;
+    uint64_t m_jobTs        = 0;
+    uint64_t m_rateCount    = 0;
+    uint64_t m_rateTs       = 0;
+    uint64_t m_resultsTs    = 0;
 
 #   ifdef XMRIG_ALGO_RANDOMX
     randomx_vm *m_vm        = nullptr;
@@ -106,6 +123,7 @@ private:
 
 #   ifdef XMRIG_FEATURE_BENCHMARK
     uint32_t m_benchSize    = 0;
+    uint64_t m_benchData    = 0;
 #   endif
 };
 
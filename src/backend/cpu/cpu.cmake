@@ -1,10 +1,13 @@
 set(HEADERS_BACKEND_CPU
     src/backend/cpu/Cpu.h
     src/backend/cpu/CpuBackend.h
+    src/backend/cpu/CpuCoSchedule.h
     src/backend/cpu/CpuConfig_gen.h
     src/backend/cpu/CpuConfig.h
     src/backend/cpu/CpuLaunchData.cpp
+    src/backend/cpu/CpuSchedMonitor.h
     src/backend/cpu/CpuThread.h
+    src/backend/cpu/CpuThreadTuner.h
     src/backend/cpu/CpuThreads.h
     src/backend/cpu/CpuWorker.h
     src/backend/cpu/interfaces/ICpuInfo.h
@@ -14,9 +17,12 @@ set(HEADERS_BACKEND_CPU
 set(SOURCES_BACKEND_CPU
     src/backend/cpu/Cpu.cpp
     src/backend/cpu/CpuBackend.cpp
+    src/backend/cpu/CpuCoSchedule.cpp
     src/backend/cpu/CpuConfig.cpp
     src/backend/cpu/CpuLaunchData.h
+    src/backend/cpu/CpuSchedMonitor.cpp
     src/backend/cpu/CpuThread.cpp
+    src/backend/cpu/CpuThreadTuner.cpp
     src/backend/cpu/CpuThreads.cpp
     src/backend/cpu/CpuWorker.cpp
    )
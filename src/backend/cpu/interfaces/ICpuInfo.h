@@ -23,9 +23,13 @@
 #include "backend/cpu/CpuThreads.h"
 #include "base/crypto/Algorithm.h"
 #include "base/tools/Object.h"
+#include "base/tools/String.h"
 #include "crypto/common/Assembly.h"
 
 
+#include <map>
+
+
 #ifdef XMRIG_FEATURE_HWLOC
 using hwloc_const_bitmap_t  = const struct hwloc_bitmap_s *;
 using hwloc_topology_t      = struct hwloc_topology *;
@@ -75,6 +79,7 @@ public:
         FLAG_AVX,
         FLAG_AVX2,
         FLAG_AVX512F,
+        FLAG_AVX512DQ,
         FLAG_BMI2,
         FLAG_OSXSAVE,
         FLAG_PDPE1GB,
@@ -85,9 +90,32 @@ public:
         FLAG_POPCNT,
         FLAG_CAT_L3,
         FLAG_VM,
+        FLAG_SVE,
         FLAG_MAX
     };
 
+#   ifdef XMRIG_FEATURE_HWLOC
+    struct Kind
+    {
+        bool ghostrider     = true;     // kind is fast enough to be used for GhostRider
+        bool mining         = true;     // kind is fast enough to be used for other algorithms
+        double score        = 1.0;      // single thread speed relative to the fastest kind, measured at startup
+        int efficiency      = -1;       // hwloc efficiency rank, higher is faster, -1 if unknown
+        size_t cores        = 0;
+        size_t threads      = 0;
+        char type[24]       = { 0 };
+        std::map<Algorithm::Id, double> measured;   // per thread hashrate relative to the fastest kind, replaces "score" for these algorithms
+    };
+
+    // Scores relative to the fastest kind, configurable in the "kinds" object of the "cpu" section
+    struct KindThresholds
+    {
+        double ghostrider   = 0.75;     // minimum score to be used for GhostRider
+        double intensity    = 0.9;      // minimum score to keep multi-hash intensity
+        double mining       = 0.3;      // minimum score to be used for other algorithms
+    };
+#   endif
+
     ICpuInfo()          = default;
     virtual ~ICpuInfo() = default;
 
@@ -126,9 +154,16 @@ public:
     virtual uint32_t model() const                                                  = 0;
 
 #   ifdef XMRIG_FEATURE_HWLOC
+    virtual bool isGenerated(const char *profile, const CpuThreads &threads) const  = 0;
     virtual bool membind(hwloc_const_bitmap_t nodeset)                              = 0;
+    virtual const std::vector<Kind> &kinds() const                                  = 0;
     virtual const std::vector<uint32_t> &nodeset() const                            = 0;
     virtual hwloc_topology_t topology() const                                       = 0;
+    virtual void loadKinds(const String &fileName)                                  = 0;
+    virtual void saveKinds() const                                                  = 0;
+    virtual void setGenerated(const char *profile, const CpuThreads &threads)       = 0;
+    virtual void setKindHashrate(const Algorithm &algorithm, const std::vector<std::pair<int64_t, double>> &samples) = 0;
+    virtual void setKindThresholds(const KindThresholds &thresholds)                = 0;
 #   endif
 };
 
@@ -95,6 +95,10 @@ rapidjson::Value xmrig::BasicCpuInfo::toJSON(rapidjson::Document &doc) const
         flags.PushBack("aes", allocator);
     }
 
+    if (has(FLAG_SVE)) {
+        flags.PushBack("sve", allocator);
+    }
+
     out.AddMember("flags", flags, allocator);
 
     return out;
@@ -34,6 +34,9 @@
 #           define ID_AA64ISAR0_AES_VAL ID_AA64ISAR0_AES
 #       endif
 #   endif
+#elif defined(XMRIG_ARM_SVE) && !defined(XMRIG_OS_FREEBSD)
+#   include <sys/auxv.h>
+#   include <asm/hwcap.h>
 #endif
 
 
@@ -57,6 +60,10 @@ void xmrig::BasicCpuInfo::init_arm()
 #   endif
 #   endif
 
+#   if defined(XMRIG_ARM_SVE) && defined(HWCAP_SVE) && !defined(XMRIG_OS_FREEBSD)
+    m_flags.set(FLAG_SVE, getauxval(AT_HWCAP) & HWCAP_SVE);
+#   endif
+
 #   if defined(XMRIG_OS_UNIX)
     auto name = cpu_name_arm();
     if (!name.isNull()) {
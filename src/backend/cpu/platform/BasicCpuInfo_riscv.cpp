@@ -47,6 +47,7 @@ xmrig::BasicCpuInfo::BasicCpuInfo()
     m_flags[FLAG_AVX] = false;        // x86-specific
     m_flags[FLAG_AVX2] = false;       // x86-specific  
     m_flags[FLAG_AVX512F] = false;    // x86-specific
+    m_flags[FLAG_AVX512DQ] = false;   // x86-specific
     m_flags[FLAG_BMI2] = false;       // x86-specific
     m_flags[FLAG_OSXSAVE] = false;    // x86-specific
     m_flags[FLAG_PDPE1GB] = true;     // Assume 1GB pages support
@@ -57,6 +58,7 @@ xmrig::BasicCpuInfo::BasicCpuInfo()
     m_flags[FLAG_POPCNT] = true;      // Available via Zbb extension
     m_flags[FLAG_CAT_L3] = false;     // Intel-specific
     m_flags[FLAG_VM] = false;         // Not running in VM by default
+    m_flags[FLAG_SVE] = false;        // ARM-specific
 
     // Detect RISC-V extensions
     detectRiscvExtensions();
@@ -63,9 +63,16 @@ protected:
     uint32_t model() const override                                                  { return 0; }
 
 #   ifdef XMRIG_FEATURE_HWLOC
+    bool isGenerated(const char *, const CpuThreads &) const override               { return false; }
     bool membind(hwloc_const_bitmap_t nodeset) override                              { return false; }
+    const std::vector<Kind> &kinds() const override                                 { return m_kinds; }
     const std::vector<uint32_t> &nodeset() const override                           { return m_nodeset; }
     hwloc_topology_t topology() const override                                      { return nullptr; }
+    void loadKinds(const String &) override                                         {}
+    void saveKinds() const override                                                 {}
+    void setGenerated(const char *, const CpuThreads &) override                    {}
+    void setKindHashrate(const Algorithm &, const std::vector<std::pair<int64_t, double>> &) override {}
+    void setKindThresholds(const KindThresholds &) override                        {}
 #   endif
 
     // RISC-V specific extensions
@@ -105,6 +112,7 @@ private:
     bool m_hasRvv;
 
 #   ifdef XMRIG_FEATURE_HWLOC
+    std::vector<Kind> m_kinds;
     std::vector<uint32_t> m_nodeset;
 #   endif
 };
@@ -22,8 +22,12 @@
 
 
 #include <algorithm>
+#include <chrono>
 #include <cmath>
 #include <hwloc.h>
+#include <set>
+#include <string>
+#include <thread>
 
 
 #if HWLOC_API_VERSION < 0x00010b00
@@ -33,7 +37,10 @@
 
 
 #include "backend/cpu/platform/HwlocCpuInfo.h"
+#include "3rdparty/rapidjson/document.h"
+#include "base/io/json/Json.h"
 #include "base/io/log/Log.h"
+#include "base/io/log/Tags.h"
 
 
 #if HWLOC_API_VERSION < 0x20000
@@ -114,6 +121,57 @@ static inline bool isCacheExclusive(hwloc_obj_t obj)
 #endif
 
 
+#if HWLOC_API_VERSION >= 0x00020400
+// Single thread speed of the first PU in "cpuset": a mix of dependent multiplications and L2 sized random reads,
+// which is roughly what CryptoNight and RandomX threads do, used until the real hashrate of an algorithm is measured
+static double probeKind(hwloc_topology_t topology, hwloc_const_bitmap_t cpuset)
+{
+    double result = 0.0;
+
+    std::thread t([topology, cpuset, &result]() {
+        hwloc_bitmap_t pu = hwloc_bitmap_alloc();
+        hwloc_bitmap_only(pu, static_cast<unsigned>(hwloc_bitmap_first(cpuset)));
+        hwloc_set_cpubind(topology, pu, HWLOC_CPUBIND_THREAD);
+        hwloc_bitmap_free(pu);
+
+        constexpr size_t mask = (256 * 1024 / sizeof(uint64_t)) - 1;
+        std::vector<uint64_t> buf(mask + 1);
+        for (size_t i = 0; i < buf.size(); ++i) {
+            buf[i] = i * 0x9E3779B97F4A7C15ULL;
+        }
+
+        using namespace std::chrono;
+
+        uint64_t x = 1;
+
+        // Best of 3 short runs, to filter out interruptions
+        for (int run = 0; run < 3; ++run) {
+            uint64_t iterations = 0;
+            const auto start    = steady_clock::now();
+            auto now            = start;
+
+            do {
+                for (size_t i = 0; i < 4096; ++i) {
+                    x = (x * 0x5851F42D4C957F2DULL + 1) ^ buf[x & mask];
+                }
+
+                iterations += 4096;
+                now = steady_clock::now();
+            } while (now - start < milliseconds(10));
+
+            result = std::max(result, iterations / duration<double, std::milli>(now - start).count());
+        }
+
+        result += static_cast<double>(x & 1) * 1e-9;
+    });
+
+    t.join();
+
+    return result;
+}
+#endif
+
+
 } // namespace xmrig
 
 
@@ -164,6 +222,8 @@ xmrig::HwlocCpuInfo::HwlocCpuInfo()
 
     setThreads(countByType(m_topology, HWLOC_OBJ_PU));
 
+    initKinds();
+
     m_cores     = countByType(m_topology, HWLOC_OBJ_CORE);
     m_nodes     = std::max(hwloc_bitmap_weight(hwloc_topology_get_complete_nodeset(m_topology)), 1);
     m_packages  = countByType(m_topology, HWLOC_OBJ_PACKAGE);
@@ -187,10 +247,22 @@ xmrig::HwlocCpuInfo::HwlocCpuInfo()
 
 xmrig::HwlocCpuInfo::~HwlocCpuInfo()
 {
+    for (hwloc_bitmap_t set : m_kindSets) {
+        hwloc_bitmap_free(set);
+    }
+
     hwloc_topology_destroy(m_topology);
 }
 
 
+bool xmrig::HwlocCpuInfo::isGenerated(const char *profile, const CpuThreads &threads) const
+{
+    const auto it = m_generated.find(profile);
+
+    return it != m_generated.end() && it->second == threads;
+}
+
+
 bool xmrig::HwlocCpuInfo::membind(hwloc_const_bitmap_t nodeset)
 {
     if (!hwloc_topology_get_support(m_topology)->membind->set_thisthread_membind) {
@@ -205,6 +277,228 @@ bool xmrig::HwlocCpuInfo::membind(hwloc_const_bitmap_t nodeset)
 }
 
 
+rapidjson::Value xmrig::HwlocCpuInfo::toJSON(rapidjson::Document &doc) const
+{
+    using namespace rapidjson;
+    auto &allocator = doc.GetAllocator();
+
+    Value out = BasicCpuInfo::toJSON(doc);
+
+    if (m_kinds.size() > 1) {
+        Value kinds(kArrayType);
+
+        for (const auto &kind : m_kinds) {
+            Value obj(kObjectType);
+            obj.AddMember("type",       StringRef(kind.type), allocator);
+            obj.AddMember("efficiency", kind.efficiency, allocator);
+            obj.AddMember("cores",      static_cast<uint64_t>(kind.cores), allocator);
+            obj.AddMember("threads",    static_cast<uint64_t>(kind.threads), allocator);
+            obj.AddMember("score",      kind.score, allocator);
+            obj.AddMember("mining",     kind.mining, allocator);
+            obj.AddMember("ghostrider", kind.ghostrider, allocator);
+
+            Value measured(kObjectType);
+            for (const auto &kv : kind.measured) {
+                measured.AddMember(StringRef(Algorithm(kv.first).name()), kv.second, allocator);
+            }
+
+            obj.AddMember("measured",   measured, allocator);
+
+            kinds.PushBack(obj, allocator);
+        }
+
+        out.AddMember("kinds", kinds, allocator);
+    }
+
+    return out;
+}
+
+
+void xmrig::HwlocCpuInfo::loadKinds(const String &fileName)
+{
+    if (m_kinds.size() < 2 || fileName.isEmpty() || m_kindsFile == fileName) {
+        return;
+    }
+
+    m_kindsFile = fileName;
+
+    rapidjson::Document doc;
+    if (!Json::get(fileName, doc) || !doc.IsObject()) {
+        return;
+    }
+
+    const rapidjson::Value &entry = Json::getObject(doc, fingerprint());
+    if (!entry.IsObject()) {
+        return;
+    }
+
+    const rapidjson::Value &measured = Json::getObject(entry, "measured");
+
+    if (measured.IsObject()) {
+        for (const auto &kv : measured.GetObject()) {
+            const Algorithm algorithm(kv.name.GetString());
+            if (!algorithm.isValid() || !kv.value.IsArray() || kv.value.Size() != m_kinds.size()) {
+                continue;
+            }
+
+            for (size_t i = 0; i < m_kinds.size(); ++i) {
+                if (kv.value[i].IsNumber()) {
+                    m_kinds[i].measured[algorithm.id()] = kv.value[i].GetDouble();
+                }
+            }
+        }
+    }
+
+    const rapidjson::Value &profiles = Json::getObject(entry, "profiles");
+
+    if (profiles.IsObject()) {
+        for (const auto &kv : profiles.GetObject()) {
+            m_generated[kv.name.GetString()] = CpuThreads(kv.value);
+        }
+    }
+}
+
+
+void xmrig::HwlocCpuInfo::saveKinds() const
+{
+    using namespace rapidjson;
+
+    if (m_kinds.size() < 2 || m_kindsFile.isEmpty()) {
+        return;
+    }
+
+    Document doc;
+    if (!Json::get(m_kindsFile, doc) || !doc.IsObject()) {
+        doc.SetObject();
+    }
+
+    auto &allocator = doc.GetAllocator();
+
+    std::set<Algorithm::Id> algorithms;
+    for (const auto &kind : m_kinds) {
+        for (const auto &kv : kind.measured) {
+            algorithms.insert(kv.first);
+        }
+    }
+
+    Value measured(kObjectType);
+    for (const auto id : algorithms) {
+        Value scores(kArrayType);
+
+        for (const auto &kind : m_kinds) {
+            const auto it = kind.measured.find(id);
+            scores.PushBack(it != kind.measured.end() ? Value(it->second) : Value(kNullType), allocator);
+        }
+
+        measured.AddMember(StringRef(Algorithm(id).name()), scores, allocator);
+    }
+
+    Value profiles(kObjectType);
+    for (const auto &kv : m_generated) {
+        profiles.AddMember(kv.first.toJSON(doc), kv.second.toJSON(doc), allocator);
+    }
+
+    Value entry(kObjectType);
+    entry.AddMember("measured", measured, allocator);
+    entry.AddMember("profiles", profiles, allocator);
+
+    const String key = fingerprint();
+
+    doc.RemoveMember(key.data());
+    doc.AddMember(key.toJSON(doc), entry, allocator);
+
+    if (!Json::save(m_kindsFile, doc)) {
+        LOG_WARN("%s " YELLOW("failed to save measured speed of CPU kinds to \"%s\""), Tags::cpu(), m_kindsFile.data());
+    }
+}
+
+
+void xmrig::HwlocCpuInfo::setGenerated(const char *profile, const CpuThreads &threads)
+{
+    if (m_kinds.size() > 1) {
+        m_generated[profile] = threads;
+    }
+}
+
+
+void xmrig::HwlocCpuInfo::setKindHashrate(const Algorithm &algorithm, const std::vector<std::pair<int64_t, double>> &samples)
+{
+    if (m_kinds.size() < 2 || !algorithm.isValid()) {
+        return;
+    }
+
+    std::vector<double> hashrate(m_kinds.size(), 0.0);
+    std::vector<size_t> count(m_kinds.size(), 0);
+
+    for (const auto &sample : samples) {
+        if (sample.first < 0 || sample.second <= 0.0) {
+            continue;
+        }
+
+        for (size_t i = 0; i < m_kindSets.size(); ++i) {
+            if (hwloc_bitmap_isset(m_kindSets[i], static_cast<unsigned>(sample.first))) {
+                hashrate[i] += sample.second;
+                count[i]++;
+                break;
+            }
+        }
+    }
+
+    double best  = 0.0;
+    size_t kinds = 0;
+
+    for (size_t i = 0; i < m_kinds.size(); ++i) {
+        if (count[i]) {
+            hashrate[i] /= static_cast<double>(count[i]);
+            best = std::max(best, hashrate[i]);
+            kinds++;
+        }
+    }
+
+    // Threads on a single kind have nothing to compare against
+    if (kinds < 2 || best <= 0.0) {
+        return;
+    }
+
+    const double minScore = algorithm.family() == Algorithm::GHOSTRIDER ? m_thresholds.ghostrider : m_thresholds.mining;
+    bool changed          = false;
+
+    for (size_t i = 0; i < m_kinds.size(); ++i) {
+        if (!count[i]) {
+            continue;
+        }
+
+        auto &kind           = m_kinds[i];
+        const double value   = std::round(hashrate[i] / best * 100.0) / 100.0;
+        const double prev    = score(kind, algorithm);
+        const bool first     = kind.measured.count(algorithm.id()) == 0;
+
+        changed |= first || prev != value;
+        kind.measured[algorithm.id()] = value;
+
+        if (first || (prev < minScore) != (value < minScore)) {
+            LOG_INFO("%s " WHITE_BOLD("%s") " cores run " WHITE_BOLD("%s") " at %.2f of the fastest kind%s",
+                     Tags::cpu(), kind.type, algorithm.name(), value, value < minScore ? YELLOW(", auto-configuration won't use them") : "");
+        }
+    }
+
+    if (changed) {
+        saveKinds();
+    }
+}
+
+
+void xmrig::HwlocCpuInfo::setKindThresholds(const KindThresholds &thresholds)
+{
+    m_thresholds = thresholds;
+
+    for (auto &kind : m_kinds) {
+        kind.mining     = kind.score >= m_thresholds.mining;
+        kind.ghostrider = kind.score >= m_thresholds.ghostrider;
+    }
+}
+
+
 xmrig::CpuThreads xmrig::HwlocCpuInfo::threads(const Algorithm &algorithm, uint32_t limit) const
 {
 #   ifndef XMRIG_ARM
@@ -275,6 +569,93 @@ xmrig::CpuThreads xmrig::HwlocCpuInfo::allThreads(const Algorithm &algorithm, ui
 
 
 
+const xmrig::ICpuInfo::Kind *xmrig::HwlocCpuInfo::kindOf(hwloc_obj_t obj) const
+{
+    for (size_t i = 0; i < m_kindSets.size(); ++i) {
+        if (hwloc_bitmap_isincluded(obj->cpuset, m_kindSets[i])) {
+            return &m_kinds[i];
+        }
+    }
+
+    return nullptr;
+}
+
+
+double xmrig::HwlocCpuInfo::score(const Kind &kind, const Algorithm &algorithm) const
+{
+    const auto it = kind.measured.find(algorithm.id());
+
+    return it != kind.measured.end() ? it->second : kind.score;
+}
+
+
+// Measurements are kept per CPU model and layout of its kinds, "Intel(R) Core(TM) i5-12600K IntelCore:12,IntelAtom:4"
+xmrig::String xmrig::HwlocCpuInfo::fingerprint() const
+{
+    std::string out = m_brand;
+
+    for (size_t i = 0; i < m_kinds.size(); ++i) {
+        out += (i == 0 ? " " : ",");
+        out += m_kinds[i].type;
+        out += ":" + std::to_string(m_kinds[i].threads);
+    }
+
+    return out.c_str();
+}
+
+
+void xmrig::HwlocCpuInfo::initKinds()
+{
+#   if HWLOC_API_VERSION >= 0x00020400
+    const int count = hwloc_cpukinds_get_nr(m_topology, 0);
+    if (count < 2) {
+        return;
+    }
+
+    double best = 0.0;
+
+    for (int i = 0; i < count; ++i) {
+        hwloc_bitmap_t cpuset   = hwloc_bitmap_alloc();
+        int efficiency          = -1;
+        unsigned nr_infos       = 0;
+        hwloc_info_s *infos     = nullptr;
+
+        if (hwloc_cpukinds_get_info(m_topology, static_cast<unsigned>(i), cpuset, &efficiency, &nr_infos, &infos, 0) != 0 || hwloc_bitmap_iszero(cpuset)) {
+            hwloc_bitmap_free(cpuset);
+            continue;
+        }
+
+        Kind kind;
+        kind.efficiency = efficiency;
+        kind.threads    = static_cast<size_t>(hwloc_bitmap_weight(cpuset));
+        kind.cores      = static_cast<size_t>(hwloc_get_nbobjs_inside_cpuset_by_type(m_topology, cpuset, HWLOC_OBJ_CORE));
+        kind.score      = probeKind(m_topology, cpuset);
+
+        for (unsigned j = 0; j < nr_infos; ++j) {
+            if (strcmp(infos[j].name, "CoreType") == 0 || (kind.type[0] == 0 && strcmp(infos[j].name, "FrequencyMaxMHz") == 0)) {
+                snprintf(kind.type, sizeof(kind.type), "%s%s", infos[j].value, strcmp(infos[j].name, "CoreType") == 0 ? "" : " MHz");
+            }
+        }
+
+        if (kind.type[0] == 0) {
+            snprintf(kind.type, sizeof(kind.type), "kind %d", i);
+        }
+
+        best = std::max(best, kind.score);
+
+        m_kindSets.emplace_back(cpuset);
+        m_kinds.emplace_back(kind);
+    }
+
+    for (auto &kind : m_kinds) {
+        kind.score = best > 0.0 ? std::round(kind.score / best * 100.0) / 100.0 : 1.0;
+    }
+
+    setKindThresholds(m_thresholds);
+#   endif
+}
+
+
 void xmrig::HwlocCpuInfo::processTopLevelCache(hwloc_obj_t cache, const Algorithm &algorithm, CpuThreads &threads, size_t limit) const
 {
 #   ifndef XMRIG_ARM
@@ -291,9 +672,34 @@ void xmrig::HwlocCpuInfo::processTopLevelCache(hwloc_obj_t cache, const Algorith
 
     const bool L3_exclusive = isCacheExclusive(cache);
 
+    if (m_kinds.size() > 1) {
+        // Hybrid CPU: fastest kinds get the cache first, kinds measured too slow for this algorithm are not used
+        auto rank = [this, &algorithm](hwloc_obj_t c) {
+            const Kind *kind = kindOf(c);
+            return kind ? std::make_pair(kind->efficiency, score(*kind, algorithm)) : std::make_pair(-1, 1.0);
+        };
+
+        std::stable_sort(cores.begin(), cores.end(), [&rank](hwloc_obj_t a, hwloc_obj_t b) { return rank(a) > rank(b); });
+
+        const double minScore = algorithm.family() == Algorithm::GHOSTRIDER ? m_thresholds.ghostrider : m_thresholds.mining;
+
+        cores.erase(std::remove_if(cores.begin(), cores.end(), [this, &algorithm, minScore](hwloc_obj_t c) {
+            const Kind *kind = kindOf(c);
+            return kind && score(*kind, algorithm) < minScore;
+        }), cores.end());
+
+        if (cores.empty()) {
+            return;
+        }
+
+        PUs = 0;
+        for (hwloc_obj_t core : cores) {
+            PUs += countByType(core, HWLOC_OBJ_PU);
+        }
+    }
 #   ifdef XMRIG_ALGO_GHOSTRIDER
-    if ((algorithm == Algorithm::GHOSTRIDER_RTM) && L3_exclusive && (PUs > cores.size()) && (PUs < cores.size() * 2)) {
-        // Don't use E-cores on Alder Lake
+    else if ((algorithm == Algorithm::GHOSTRIDER_RTM) && L3_exclusive && (PUs > cores.size()) && (PUs < cores.size() * 2)) {
+        // Don't use E-cores on Alder Lake (hwloc without cpukinds support)
         cores.erase(std::remove_if(cores.begin(), cores.end(), [](hwloc_obj_t c) { return hwloc_bitmap_weight(c->cpuset) == 1; }), cores.end());
 
         // This shouldn't happen, but check it anyway
@@ -308,7 +714,8 @@ void xmrig::HwlocCpuInfo::processTopLevelCache(hwloc_obj_t cache, const Algorith
     int L2_associativity    = 0;
     size_t extra            = 0;
     size_t scratchpad       = algorithm.l3();
-    uint32_t intensity      = algorithm.maxIntensity() == 1 ? 0 : 1;
+    // Argon2 multi-hash is opt-in, generated profiles keep the plain affinity format.
+    uint32_t intensity      = (algorithm.maxIntensity() == 1 || algorithm.family() == Algorithm::ARGON2) ? 0 : 1;
 
     if (cache->attr->cache.depth == 3) {
         auto process_L2 = [&L2, &L2_associativity, L3_exclusive, this, &extra, scratchpad](hwloc_obj_t l2) {
@@ -382,11 +789,17 @@ void xmrig::HwlocCpuInfo::processTopLevelCache(hwloc_obj_t cache, const Algorith
     }
 #   endif
 
+    // Multi-hash intensity only on the fastest kind of cores, slower kinds have smaller private caches
+    auto coreIntensity = [this, &algorithm, intensity](hwloc_obj_t core) {
+        const Kind *kind = kindOf(core);
+        return (kind && score(*kind, algorithm) < m_thresholds.intensity && intensity > 1 && intensity < 8) ? 1U : intensity;
+    };
+
     if (cacheHashes >= PUs) {
         for (hwloc_obj_t core : cores) {
             const std::vector<hwloc_obj_t> units = findByType(core, HWLOC_OBJ_PU);
             for (hwloc_obj_t pu : units) {
-                threads.add(pu->os_index, intensity);
+                threads.add(pu->os_index, coreIntensity(core));
             }
         }
 
@@ -411,7 +824,7 @@ void xmrig::HwlocCpuInfo::processTopLevelCache(hwloc_obj_t cache, const Algorith
             PUs--;
 
             allocated_pu = true;
-            threads_data.emplace_back(units[pu_id]->os_index, intensity);
+            threads_data.emplace_back(units[pu_id]->os_index, coreIntensity(core));
 
             if (cacheHashes == 0) {
                 break;
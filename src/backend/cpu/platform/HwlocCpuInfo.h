@@ -23,7 +23,11 @@
 #include "backend/cpu/platform/BasicCpuInfo.h"
 
 
-using hwloc_obj_t = struct hwloc_obj *;
+#include <map>
+
+
+using hwloc_bitmap_t  = struct hwloc_bitmap_s *;
+using hwloc_obj_t     = struct hwloc_obj *;
 
 
 namespace xmrig {
@@ -38,10 +42,18 @@ public:
     ~HwlocCpuInfo() override;
 
 protected:
+    bool isGenerated(const char *profile, const CpuThreads &threads) const override;
     bool membind(hwloc_const_bitmap_t nodeset) override;
     CpuThreads threads(const Algorithm &algorithm, uint32_t limit) const override;
+    rapidjson::Value toJSON(rapidjson::Document &doc) const override;
+    void loadKinds(const String &fileName) override;
+    void saveKinds() const override;
+    void setGenerated(const char *profile, const CpuThreads &threads) override;
+    void setKindHashrate(const Algorithm &algorithm, const std::vector<std::pair<int64_t, double>> &samples) override;
+    void setKindThresholds(const KindThresholds &thresholds) override;
 
     inline const char *backend() const override                     { return m_backend; }
+    inline const std::vector<Kind> &kinds() const override          { return m_kinds; }
     inline const std::vector<uint32_t> &nodeset() const override    { return m_nodeset; }
     inline hwloc_topology_t topology() const override               { return m_topology; }
     inline size_t cores() const override                            { return m_cores; }
@@ -52,15 +64,24 @@ protected:
 
 private:
     CpuThreads allThreads(const Algorithm &algorithm, uint32_t limit) const;
+    const Kind *kindOf(hwloc_obj_t obj) const;
+    double score(const Kind &kind, const Algorithm &algorithm) const;
+    String fingerprint() const;
+    void initKinds();
     void processTopLevelCache(hwloc_obj_t cache, const Algorithm &algorithm, CpuThreads &threads, size_t limit) const;
     void setThreads(size_t threads);
 
     char m_backend[20]          = { 0 };
     hwloc_topology_t m_topology = nullptr;
+    KindThresholds m_thresholds;
+    String m_kindsFile;
     size_t m_cache[5]           = { 0 };
     size_t m_cores              = 0;
     size_t m_nodes              = 0;
     size_t m_packages           = 0;
+    std::map<String, CpuThreads> m_generated;
+    std::vector<hwloc_bitmap_t> m_kindSets;
+    std::vector<Kind> m_kinds;
     std::vector<uint32_t> m_nodeset;
 };
 
@@ -34,6 +34,7 @@ set(HEADERS_BASE
     src/base/kernel/interfaces/IConsoleListener.h
     src/base/kernel/interfaces/IDnsBackend.h
     src/base/kernel/interfaces/IDnsListener.h
+    src/base/kernel/interfaces/ILatencyListener.h
     src/base/kernel/interfaces/ILineListener.h
     src/base/kernel/interfaces/ILogBackend.h
     src/base/kernel/interfaces/ISignalListener.h
@@ -41,6 +42,7 @@ set(HEADERS_BASE
     src/base/kernel/interfaces/IStrategyListener.h
     src/base/kernel/interfaces/ITimerListener.h
     src/base/kernel/interfaces/IWatcherListener.h
+    src/base/kernel/interfaces/IZmqListener.h
     src/base/kernel/Platform.h
     src/base/kernel/Process.h
     src/base/net/dns/Dns.h
@@ -64,10 +66,12 @@ set(HEADERS_BASE
     src/base/net/stratum/strategies/StrategyProxy.h
     src/base/net/stratum/SubmitResult.h
     src/base/net/stratum/Url.h
+    src/base/net/tools/LatencyProbe.h
     src/base/net/tools/LineReader.h
     src/base/net/tools/MemPool.h
     src/base/net/tools/NetBuffer.h
     src/base/net/tools/Storage.h
+    src/base/net/tools/ZmqSubscriber.h
     src/base/tools/Alignment.h
     src/base/tools/Arguments.h
     src/base/tools/Baton.h
@@ -82,6 +86,7 @@ set(HEADERS_BASE
     src/base/tools/cryptonote/WalletAddress.h
     src/base/tools/Cvt.h
     src/base/tools/Handle.h
+    src/base/tools/Parking.h
     src/base/tools/Span.h
     src/base/tools/String.h
     src/base/tools/Timer.h
@@ -130,8 +135,10 @@ set(SOURCES_BASE
     src/base/net/stratum/strategies/FailoverStrategy.cpp
     src/base/net/stratum/strategies/SinglePoolStrategy.cpp
     src/base/net/stratum/Url.cpp
+    src/base/net/tools/LatencyProbe.cpp
     src/base/net/tools/LineReader.cpp
     src/base/net/tools/NetBuffer.cpp
+    src/base/net/tools/ZmqSubscriber.cpp
     src/base/tools/Arguments.cpp
     src/base/tools/Chrono.cpp
     src/base/tools/cryptonote/BlockTemplate.cpp
@@ -140,6 +147,7 @@ set(SOURCES_BASE
     src/base/tools/cryptonote/Signatures.cpp
     src/base/tools/cryptonote/WalletAddress.cpp
     src/base/tools/Cvt.cpp
+    src/base/tools/Parking.cpp
     src/base/tools/String.cpp
     src/base/tools/Timer.cpp
    )
@@ -68,6 +68,7 @@ public:
     virtual const Job &job() const                                          = 0;
     virtual const Pool &pool() const                                        = 0;
     virtual const String &ip() const                                        = 0;
+    virtual double rtt() const                                              = 0;
     virtual int id() const                                                  = 0;
     virtual int64_t send(const rapidjson::Value &obj, Callback callback)    = 0;
     virtual int64_t send(const rapidjson::Value &obj)                       = 0;
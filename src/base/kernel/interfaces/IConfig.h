@@ -113,6 +113,8 @@ public:
         YieldKey             = 1030,
         Argon2ImplKey        = 1039,
         RandomXCacheQoSKey   = 1040,
+        RandomXHandoffKey    = 1060,
+        RandomXScrubKey      = 1061,
 
         // xmrig amd
         OclPlatformKey       = 1400,
@@ -29,6 +29,9 @@
 #include <cstdint>
 
 
+#include "3rdparty/rapidjson/fwd.h"
+
+
 namespace xmrig {
 
 
@@ -46,6 +49,7 @@ public:
     virtual bool isActive() const                      = 0;
     virtual IClient *client() const                    = 0;
     virtual int64_t submit(const JobResult &result)    = 0;
+    virtual rapidjson::Value toJSON(rapidjson::Document &doc) const = 0;
     virtual void connect()                             = 0;
     virtual void resume()                              = 0;
     virtual void setAlgo(const Algorithm &algo)        = 0;
@@ -47,6 +47,7 @@ protected:
     inline const Job &job() const override                     { return m_job; }
     inline const Pool &pool() const override                   { return m_pool; }
     inline const String &ip() const override                   { return m_ip; }
+    inline double rtt() const override                         { return m_rtt; }
     inline int id() const override                             { return m_id; }
     inline int64_t sequence() const override                   { return m_sequence; }
     inline void setAlgo(const Algorithm &algo) override        { m_pool.setAlgo(algo); }
@@ -82,6 +83,7 @@ protected:
     bool handleSubmitResponse(int64_t id, const char *error = nullptr);
 
     bool m_quiet                    = false;
+    double m_rtt                    = 0.0;
     IClientListener *m_listener;
     int m_id;
     int m_retries                   = 5;
@@ -637,6 +637,9 @@ void xmrig::Client::login()
 
     JsonRequest::create(doc, 1, "login", params);
 
+    m_pingId = 1;
+    m_pingTs = Chrono::highResolutionMSecs();
+
     send(doc);
 }
 
@@ -807,6 +810,12 @@ void xmrig::Client::parseNotification(const char *method, const rapidjson::Value
 
 void xmrig::Client::parseResponse(int64_t id, const rapidjson::Value &result, const rapidjson::Value &error)
 {
+    // Stratum round trip, measured on login and keepalived requests.
+    if (id == m_pingId && m_pingTs > 0.0) {
+        m_rtt    = Chrono::highResolutionMSecs() - m_pingTs;
+        m_pingTs = 0.0;
+    }
+
     if (handleResponse(id, result, error)) {
         return;
     }
@@ -856,6 +865,9 @@ void xmrig::Client::parseResponse(int64_t id, const rapidjson::Value &result, co
 
 void xmrig::Client::ping()
 {
+    m_pingId = m_sequence;
+    m_pingTs = Chrono::highResolutionMSecs();
+
     send(snprintf(m_sendBuf.data(), m_sendBuf.size(), "{\"id\":%" PRId64 ",\"jsonrpc\":\"2.0\",\"method\":\"keepalived\",\"params\":{\"id\":\"%s\"}}\n", m_sequence, m_rpcId.data()));
 
     m_keepAlive = 0;
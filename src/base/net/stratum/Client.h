@@ -134,6 +134,8 @@ private:
     std::vector<char> m_sendBuf;
     std::vector<char> m_tempBuf;
     String m_rpcId;
+    double m_pingTs             = 0.0;
+    int64_t m_pingId            = 0;
     Tls *m_tls                  = nullptr;
     uint64_t m_expire           = 0;
     uint64_t m_jobs             = 0;
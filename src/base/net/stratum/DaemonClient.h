@@ -21,11 +21,10 @@
 #define XMRIG_DAEMONCLIENT_H
 
 
-#include "base/kernel/interfaces/IDnsListener.h"
 #include "base/kernel/interfaces/IHttpListener.h"
 #include "base/kernel/interfaces/ITimerListener.h"
+#include "base/kernel/interfaces/IZmqListener.h"
 #include "base/net/stratum/BaseClient.h"
-#include "base/net/tools/Storage.h"
 #include "base/tools/cryptonote/BlockTemplate.h"
 #include "base/tools/cryptonote/WalletAddress.h"
 
@@ -33,12 +32,6 @@
 #include <memory>
 
 
-using uv_buf_t      = struct uv_buf_t;
-using uv_connect_t  = struct uv_connect_s;
-using uv_handle_t   = struct uv_handle_s;
-using uv_stream_t   = struct uv_stream_s;
-using uv_tcp_t      = struct uv_tcp_s;
-
 #ifdef XMRIG_FEATURE_TLS
 using BIO           = struct bio_st;
 using SSL           = struct ssl_st;
@@ -49,10 +42,10 @@ using SSL_CTX       = struct ssl_ctx_st;
 namespace xmrig {
 
 
-class DnsRequest;
+class ZmqSubscriber;
 
 
-class DaemonClient : public BaseClient, public IDnsListener, public ITimerListener, public IHttpListener
+class DaemonClient : public BaseClient, public ITimerListener, public IHttpListener, public IZmqListener
 {
 public:
     XMRIG_DISABLE_COPY_MOVE_DEFAULT(DaemonClient)
@@ -70,7 +63,10 @@ protected:
 
     void onHttpData(const HttpData &data) override;
     void onTimer(const Timer *timer) override;
-    void onResolved(const DnsRecords &records, int status, const char* error) override;
+
+    void onZmqClose(ZmqSubscriber *subscriber, const char *error) override;
+    void onZmqConnected(ZmqSubscriber *subscriber) override;
+    void onZmqMessage(ZmqSubscriber *subscriber, const char *data, size_t size) override;
 
     inline bool hasExtension(Extension) const noexcept override         { return false; }
     inline const char *mode() const override                            { return "daemon"; }
@@ -110,38 +106,7 @@ private:
     Timer *m_timer;
     uint64_t m_blocktemplateRequestHeight = 0;
     WalletAddress m_walletAddress;
-
-private:
-    static inline DaemonClient* getClient(void* data) { return m_storage.get(data); }
-
-    uintptr_t m_key = 0;
-    static Storage<DaemonClient> m_storage;
-
-    static void onZMQConnect(uv_connect_t* req, int status);
-    static void onZMQRead(uv_stream_t* stream, ssize_t nread, const uv_buf_t* buf);
-    static void onZMQClose(uv_handle_t* handle);
-    static void onZMQShutdown(uv_handle_t* handle);
-
-    void ZMQConnected();
-    bool ZMQWrite(const char* data, size_t size);
-    void ZMQRead(ssize_t nread, const uv_buf_t* buf);
-    void ZMQParse();
-    bool ZMQClose(bool shutdown = false);
-
-    std::shared_ptr<DnsRequest> m_dns;
-    uv_tcp_t* m_ZMQSocket = nullptr;
-
-    enum {
-        ZMQ_NOT_CONNECTED,
-        ZMQ_GREETING_1,
-        ZMQ_GREETING_2,
-        ZMQ_HANDSHAKE,
-        ZMQ_CONNECTED,
-        ZMQ_DISCONNECTING,
-    } m_ZMQConnectionState = ZMQ_NOT_CONNECTED;
-
-    std::vector<char> m_ZMQSendBuf;
-    std::vector<char> m_ZMQRecvBuf;
+    ZmqSubscriber *m_zmq = nullptr;
 };
 
 
@@ -39,6 +39,7 @@ public:
     NetworkState(IStrategyListener *listener);
 
     inline const Algorithm &algorithm() const   { return m_algorithm; }
+    inline const std::vector<uint16_t> &latencies() const  { return m_latency; }
     inline uint64_t accepted() const            { return m_accepted; }
     inline uint64_t rejected() const            { return m_rejected; }
 
@@ -63,12 +63,14 @@ const String Pool::kDefaultUser           = "x";
 
 const char *Pool::kAlgo                   = "algo";
 const char *Pool::kCoin                   = "coin";
+const char *Pool::kCoSchedule             = "co-schedule";
 const char *Pool::kDaemon                 = "daemon";
 const char *Pool::kDaemonPollInterval     = "daemon-poll-interval";
 const char *Pool::kDaemonJobTimeout       = "daemon-job-timeout";
 const char *Pool::kDaemonZMQPort          = "daemon-zmq-port";
 const char *Pool::kEnabled                = "enabled";
 const char *Pool::kFingerprint            = "tls-fingerprint";
+const char *Pool::kGroup                  = "group";
 const char *Pool::kKeepalive              = "keepalive";
 const char *Pool::kNicehash               = "nicehash";
 const char *Pool::kPass                   = "pass";
@@ -127,6 +129,7 @@ xmrig::Pool::Pool(const rapidjson::Value &object) :
     m_password       = Json::getString(object, kPass);
     m_rigId          = Json::getString(object, kRigId);
     m_fingerprint    = Json::getString(object, kFingerprint);
+    m_group          = Json::getString(object, kGroup);
     m_pollInterval   = Json::getUint64(object, kDaemonPollInterval, kDefaultPollInterval);
     m_jobTimeout     = Json::getUint64(object, kDaemonJobTimeout, kDefaultJobTimeout);
     m_algorithm      = Json::getString(object, kAlgo);
@@ -139,6 +142,7 @@ xmrig::Pool::Pool(const rapidjson::Value &object) :
     m_flags.set(FLAG_NICEHASH, Json::getBool(object, kNicehash) || m_url.host().contains(kNicehashHost));
     m_flags.set(FLAG_TLS,      Json::getBool(object, kTls) || m_url.isTLS());
     m_flags.set(FLAG_SNI,      Json::getBool(object, kSni));
+    m_flags.set(FLAG_CO_SCHEDULE, Json::getBool(object, kCoSchedule));
 
     setKeepAlive(Json::getValue(object, kKeepalive));
 
@@ -209,6 +213,7 @@ bool xmrig::Pool::isEqual(const Pool &other) const
             && m_coin         == other.m_coin
             && m_mode         == other.m_mode
             && m_fingerprint  == other.m_fingerprint
+            && m_group        == other.m_group
             && m_password     == other.m_password
             && m_rigId        == other.m_rigId
             && m_url          == other.m_url
@@ -216,6 +221,7 @@ bool xmrig::Pool::isEqual(const Pool &other) const
             && m_pollInterval == other.m_pollInterval
             && m_jobTimeout   == other.m_jobTimeout
             && m_daemon       == other.m_daemon
+            && m_zmqPort      == other.m_zmqPort
             && m_proxy        == other.m_proxy
             );
 }
@@ -302,6 +308,8 @@ rapidjson::Value xmrig::Pool::toJSON(rapidjson::Document &doc) const
     obj.AddMember(StringRef(kEnabled),      m_flags.test(FLAG_ENABLED), allocator);
     obj.AddMember(StringRef(kTls),          isTLS(), allocator);
     obj.AddMember(StringRef(kSni),          isSNI(), allocator);
+    obj.AddMember(StringRef(kCoSchedule),   isCoSchedule(), allocator);
+    obj.AddMember(StringRef(kGroup),        m_group.toJSON(), allocator);
     obj.AddMember(StringRef(kFingerprint),  m_fingerprint.toJSON(), allocator);
     obj.AddMember(StringRef(kDaemon),       m_mode == MODE_DAEMON, allocator);
     obj.AddMember(StringRef(kSOCKS5),       m_proxy.toJSON(doc), allocator);
@@ -314,6 +322,10 @@ rapidjson::Value xmrig::Pool::toJSON(rapidjson::Document &doc) const
     else {
         obj.AddMember(StringRef(kSelfSelect),     m_daemon.url().toJSON(), allocator);
         obj.AddMember(StringRef(kSubmitToOrigin), m_submitToOrigin, allocator);
+
+        if (m_mode == MODE_SELF_SELECT) {
+            obj.AddMember(StringRef(kDaemonZMQPort), m_zmqPort, allocator);
+        }
     }
 
     return obj;
@@ -335,6 +347,14 @@ std::string xmrig::Pool::printableName() const
         out += std::string(" self-select ") + CSI "1;" + std::to_string(m_daemon.isTLS() ? 32 : 36) + "m" + m_daemon.url().data() + WHITE_BOLD_S + (m_submitToOrigin ? " submit-to-origin" : "") + CLEAR;
     }
 
+    if (isCoSchedule()) {
+        out += std::string(" ") + MAGENTA_BOLD_S + "co-schedule" + CLEAR;
+    }
+
+    if (!m_group.isEmpty()) {
+        out += std::string(" group ") + WHITE_BOLD_S + m_group.data() + CLEAR;
+    }
+
     return out;
 }
 
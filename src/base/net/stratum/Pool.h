@@ -57,11 +57,13 @@ public:
 
     static const char *kAlgo;
     static const char *kCoin;
+    static const char *kCoSchedule;
     static const char *kDaemon;
     static const char *kDaemonPollInterval;
     static const char *kDaemonJobTimeout;
     static const char *kEnabled;
     static const char *kFingerprint;
+    static const char *kGroup;
     static const char *kKeepalive;
     static const char *kNicehash;
     static const char *kPass;
@@ -94,6 +96,7 @@ public:
     uint32_t benchSize() const;
 #   endif
 
+    inline bool isCoSchedule() const                    { return m_flags.test(FLAG_CO_SCHEDULE); }
     inline bool isNicehash() const                      { return m_flags.test(FLAG_NICEHASH); }
     inline bool isTLS() const                           { return m_flags.test(FLAG_TLS) || m_url.isTLS(); }
     inline bool isSNI() const                           { return m_flags.test(FLAG_SNI); }
@@ -102,6 +105,7 @@ public:
     inline const Coin &coin() const                     { return m_coin; }
     inline const ProxyUrl &proxy() const                { return m_proxy; }
     inline const String &fingerprint() const            { return m_fingerprint; }
+    inline const String &group() const                  { return m_group; }
     inline const String &host() const                   { return m_url.host(); }
     inline const String &password() const               { return !m_password.isNull() ? m_password : kDefaultPassword; }
     inline const String &rigId() const                  { return m_rigId; }
@@ -141,6 +145,7 @@ private:
         FLAG_NICEHASH,
         FLAG_TLS,
         FLAG_SNI,
+        FLAG_CO_SCHEDULE,
         FLAG_MAX
     };
 
@@ -157,6 +162,7 @@ private:
     ProxyUrl m_proxy;
     std::bitset<FLAG_MAX> m_flags   = 0;
     String m_fingerprint;
+    String m_group;
     String m_password;
     String m_rigId;
     String m_user;
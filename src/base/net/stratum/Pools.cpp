@@ -80,24 +80,19 @@ int xmrig::Pools::donateLevel() const
 }
 
 
-xmrig::IStrategy *xmrig::Pools::createStrategy(IStrategyListener *listener) const
+xmrig::IStrategy *xmrig::Pools::createCoStrategy(IStrategyListener *listener) const
 {
-    if (active() == 1) {
-        for (const Pool &pool : m_data) {
-            if (pool.isEnabled()) {
-                return new SinglePoolStrategy(pool, retryPause(), retries(), listener);
-            }
-        }
+    if (coActive() == 0) {
+        return nullptr;
     }
 
-    auto strategy = new FailoverStrategy(retryPause(), retries(), listener);
-    for (const Pool &pool : m_data) {
-        if (pool.isEnabled()) {
-            strategy->add(pool);
-        }
-    }
+    return createStrategy(listener, true);
+}
 
-    return strategy;
+
+xmrig::IStrategy *xmrig::Pools::createStrategy(IStrategyListener *listener) const
+{
+    return createStrategy(listener, false);
 }
 
 
@@ -118,14 +113,13 @@ rapidjson::Value xmrig::Pools::toJSON(rapidjson::Document &doc) const
 
 size_t xmrig::Pools::active() const
 {
-    size_t count = 0;
-    for (const Pool &pool : m_data) {
-        if (pool.isEnabled()) {
-            count++;
-        }
-    }
+    return active(false);
+}
 
-    return count;
+
+size_t xmrig::Pools::coActive() const
+{
+    return active(true);
 }
 
 
@@ -215,6 +209,40 @@ void xmrig::Pools::toJSON(rapidjson::Value &out, rapidjson::Document &doc) const
 }
 
 
+xmrig::IStrategy *xmrig::Pools::createStrategy(IStrategyListener *listener, bool coSchedule) const
+{
+    if (active(coSchedule) == 1) {
+        for (const Pool &pool : m_data) {
+            if (pool.isEnabled() && pool.isCoSchedule() == coSchedule) {
+                return new SinglePoolStrategy(pool, retryPause(), retries(), listener);
+            }
+        }
+    }
+
+    auto strategy = new FailoverStrategy(retryPause(), retries(), listener);
+    for (const Pool &pool : m_data) {
+        if (pool.isEnabled() && pool.isCoSchedule() == coSchedule) {
+            strategy->add(pool);
+        }
+    }
+
+    return strategy;
+}
+
+
+size_t xmrig::Pools::active(bool coSchedule) const
+{
+    size_t count = 0;
+    for (const Pool &pool : m_data) {
+        if (pool.isEnabled() && pool.isCoSchedule() == coSchedule) {
+            count++;
+        }
+    }
+
+    return count;
+}
+
+
 void xmrig::Pools::setDonateLevel(int level)
 {
     if (level >= kMinimumDonateLevel && level <= 99) {
@@ -73,15 +73,19 @@ public:
 
     bool isEqual(const Pools &other) const;
     int donateLevel() const;
+    IStrategy *createCoStrategy(IStrategyListener *listener) const;
     IStrategy *createStrategy(IStrategyListener *listener) const;
     rapidjson::Value toJSON(rapidjson::Document &doc) const;
     size_t active() const;
+    size_t coActive() const;
     uint32_t benchSize() const;
     void load(const IJsonReader &reader);
     void print() const;
     void toJSON(rapidjson::Value &out, rapidjson::Document &doc) const;
 
 private:
+    IStrategy *createStrategy(IStrategyListener *listener, bool coSchedule) const;
+    size_t active(bool coSchedule) const;
     void setDonateLevel(int level);
     void setProxyDonate(int value);
     void setRetries(int retries);
@@ -29,8 +29,15 @@
 #include "base/net/http/Fetch.h"
 #include "base/net/http/HttpData.h"
 #include "base/net/stratum/Client.h"
+#include "base/net/tools/ZmqSubscriber.h"
 #include "net/JobResult.h"
+#include "base/tools/Chrono.h"
 #include "base/tools/Cvt.h"
+#include "base/tools/Timer.h"
+
+
+#include <algorithm>
+#include <cstring>
 
 
 namespace xmrig {
@@ -45,6 +52,11 @@ static const char *kJobId               = "job_id";
 static const char *kNextSeedHash        = "next_seed_hash";
 static const char *kPrevHash            = "prev_hash";
 static const char *kSeedHash            = "seed_hash";
+static const char *kZmqTopic            = "json-minimal-chain_main";
+
+constexpr int kTipRetries               = 20;       // the daemon publishes a new block before its template is rebuilt
+constexpr uint64_t kTipRetryDelay       = 100;      // ms
+constexpr uint64_t kTemplateTimeout     = 15000;    // ms, a cached template is refetched after that to pick up new transactions
 
 static const char * const required_fields[] = { kBlocktemplateBlob, kBlockhashingBlob, kHeight, kDifficulty, kPrevHash };
 
@@ -57,11 +69,14 @@ xmrig::SelfSelectClient::SelfSelectClient(int id, const char *agent, IClientList
 {
     m_httpListener  = std::make_shared<HttpListener>(this);
     m_client        = new Client(id, agent, this);
+    m_timer         = new Timer(this);
 }
 
 
 xmrig::SelfSelectClient::~SelfSelectClient()
 {
+    delete m_zmq;
+    delete m_timer;
     delete m_client;
 }
 
@@ -94,14 +109,39 @@ void xmrig::SelfSelectClient::tick(uint64_t now)
 
         getBlockTemplate();
     }
+
+    if (m_active && m_zmq && !m_zmq->isActive() && now - m_zmqTs >= m_retryPause) {
+        m_zmq->connect();
+    }
+}
+
+
+void xmrig::SelfSelectClient::onClose(IClient *, int failures)
+{
+    m_listener->onClose(this, failures);
+    setState(IdleState);
+    m_active  = false;
+    m_submit  = false;
+    m_request = 0;
+
+    if (m_zmq) {
+        m_zmq->close();
+    }
+
+    m_template.valid = false;
 }
 
 
 void xmrig::SelfSelectClient::onJobReceived(IClient *, const Job &job, const rapidjson::Value &)
 {
-    m_job = job;
+    m_job    = job;
+    m_jobTs  = Chrono::highResolutionMSecs();
+    m_source = "daemon";
+    m_submit = true;
 
-    getBlockTemplate();
+    if (!fromCache()) {
+        getBlockTemplate();
+    }
 }
 
 
@@ -113,6 +153,85 @@ void xmrig::SelfSelectClient::onLogin(IClient *, rapidjson::Document &doc, rapid
 }
 
 
+void xmrig::SelfSelectClient::onLoginSuccess(IClient *)
+{
+    m_listener->onLoginSuccess(this);
+    setState(IdleState);
+    m_active = true;
+
+    if (pool().zmq_port() <= 0 || !pool().daemon().isValid()) {
+        return;
+    }
+
+    if (m_zmq && (m_zmq->host() != pool().daemon().host() || m_zmq->port() != pool().zmq_port())) {
+        delete m_zmq;
+        m_zmq = nullptr;
+    }
+
+    if (!m_zmq) {
+        m_zmq = new ZmqSubscriber(pool().daemon().host(), static_cast<uint16_t>(pool().zmq_port()), kZmqTopic, this);
+    }
+
+    m_zmq->connect();
+}
+
+
+void xmrig::SelfSelectClient::onTimer(const Timer *)
+{
+    if (m_active) {
+        getBlockTemplate();
+    }
+}
+
+
+void xmrig::SelfSelectClient::onZmqClose(ZmqSubscriber *subscriber, const char *)
+{
+    if (m_template.cacheable && m_active) {
+        LOG_WARN("%s " YELLOW("tcp-zmq://%s:%u disconnected, block template cache disabled"), tag(), subscriber->host().data(), subscriber->port());
+    }
+
+    m_template.valid     = false;
+    m_template.cacheable = false;
+    m_zmqTs              = Chrono::steadyMSecs();
+}
+
+
+void xmrig::SelfSelectClient::onZmqConnected(ZmqSubscriber *subscriber)
+{
+    LOG_INFO("%s " CYAN("tcp-zmq://%s:%u") " subscribed, block templates are prefetched on new blocks", tag(), subscriber->host().data(), subscriber->port());
+
+    // Blocks may have been found while the subscription was down.
+    m_template.valid = false;
+}
+
+
+void xmrig::SelfSelectClient::onZmqMessage(ZmqSubscriber *, const char *data, size_t size)
+{
+    const size_t topic = strlen(kZmqTopic);
+    if (size <= topic || memcmp(data, kZmqTopic, topic) != 0 || data[topic] != ':') {
+        return;
+    }
+
+    rapidjson::Document doc;
+    if (doc.Parse(data + topic + 1, size - topic - 1).HasParseError()) {
+        return;
+    }
+
+    const auto &ids = Json::getArray(doc, "ids");
+    if (ids.IsArray() && !ids.Empty() && ids[ids.Size() - 1].IsString()) {
+        m_tip = ids[ids.Size() - 1].GetString();
+    }
+
+    m_template.valid = false;
+    m_tipRetries     = 0;
+
+    // New block: prefetch the next template, it is sent to the pool when the pool's job for the new block arrives.
+    if (m_active && !m_job.poolWallet().isEmpty()) {
+        getBlockTemplate();
+    }
+}
+
+
 bool xmrig::SelfSelectClient::parseResponse(int64_t id, rapidjson::Value &result, const rapidjson::Value &error)
 {
     if (id == -1) {
@@ -137,7 +256,55 @@ bool xmrig::SelfSelectClient::parseResponse(int64_t id, rapidjson::Value &result
         }
     }
 
-    const char *blobData = Json::getString(result, kBlockhashingBlob);
+    m_template.blob         = Json::getString(result, kBlocktemplateBlob);
+    m_template.hashingBlob  = Json::getString(result, kBlockhashingBlob);
+    m_template.difficulty   = Json::getUint64(result, kDifficulty);
+    m_template.height       = Json::getUint64(result, kHeight);
+    m_template.prevHash     = Json::getString(result, kPrevHash);
+    m_template.seedHash     = Json::getString(result, kSeedHash);
+    m_template.nextSeedHash = Json::getString(result, kNextSeedHash);
+    m_template.extraNonce   = m_requestNonce;
+    m_template.wallet       = m_requestWallet;
+    m_template.ts           = Chrono::steadyMSecs();
+    m_template.valid        = false;
+    m_template.cacheable    = false;
+
+    if (m_zmq && m_zmq->isConnected()) {
+        // The notification can arrive before the daemon switched to the new tip, ask again shortly.
+        if (!m_tip.isEmpty() && m_template.prevHash != m_tip && m_tipRetries < kTipRetries) {
+            ++m_tipRetries;
+            setState(IdleState);
+            m_timer->singleShot(kTipRetryDelay);
+
+            return true;
+        }
+
+        m_template.cacheable = m_template.parsed.parse(m_template.blob, pool().coin(), true) && !m_template.parsed.hasMinerSignature();
+        m_template.valid     = true;
+    }
+
+    if (!m_submit) {
+        setState(IdleState);
+
+        return true;
+    }
+
+    // The pool job changed while the template was fetched.
+    if (m_template.wallet != m_job.poolWallet() || m_template.extraNonce != m_job.extraNonce()) {
+        if (!fromCache()) {
+            getBlockTemplate();
+        }
+
+        return true;
+    }
+
+    return applyTemplate();
+}
+
+
+bool xmrig::SelfSelectClient::applyTemplate()
+{
+    const char *blobData = m_template.hashingBlob.data();
     if (pool().coin().isValid()) {
         uint8_t blobVersion = 0;
         if (blobData) {
@@ -150,19 +317,57 @@ bool xmrig::SelfSelectClient::parseResponse(int64_t id, rapidjson::Value &result
         return false;
     }
 
-    m_job.setHeight(Json::getUint64(result, kHeight));
-    m_job.setSeedHash(Json::getString(result, kSeedHash));
+    m_job.setHeight(m_template.height);
+    m_job.setSeedHash(m_template.seedHash.data());
 
-    submitBlockTemplate(result);
+    m_submit = false;
+    submitBlockTemplate();
 
     return true;
 }
 
 
+bool xmrig::SelfSelectClient::fromCache()
+{
+    if (!m_template.valid || !m_zmq || !m_zmq->isConnected() || m_template.wallet != m_job.poolWallet() || Chrono::steadyMSecs() - m_template.ts > kTemplateTimeout) {
+        return false;
+    }
+
+    // Only the pool's extra nonce changed: patch it into the cached template and rehash the miner tx branch.
+    if (m_template.extraNonce != m_job.extraNonce()) {
+        const String &extraNonce = m_job.extraNonce();
+
+        if (!m_template.cacheable || extraNonce.size() != m_template.extraNonce.size() || !m_template.parsed.setTxExtraNonce(Cvt::fromHex(extraNonce))) {
+            return false;
+        }
+
+        memcpy(m_template.blob.data() + m_template.parsed.offset(BlockTemplate::TX_EXTRA_NONCE_OFFSET) * 2, extraNonce.data(), extraNonce.size());
+
+        m_template.hashingBlob  = Cvt::toHex(m_template.parsed.generateHashingBlob());
+        m_template.extraNonce   = extraNonce;
+        m_source                = "patched";
+    }
+    else {
+        m_source = "cached";
+    }
+
+    return applyTemplate();
+}
+
+
 void xmrig::SelfSelectClient::getBlockTemplate()
 {
+    // One request at a time, its response is checked against the current pool job when it arrives.
+    if (m_request) {
+        return;
+    }
+
     setState(WaitState);
 
+    m_request       = m_sequence;
+    m_requestNonce  = m_job.extraNonce();
+    m_requestWallet = m_job.poolWallet();
+
     using namespace rapidjson;
     Document doc(kObjectType);
     auto &allocator = doc.GetAllocator();
@@ -215,28 +420,32 @@ void xmrig::SelfSelectClient::setState(State state)
 }
 
 
-void xmrig::SelfSelectClient::submitBlockTemplate(rapidjson::Value &result)
+void xmrig::SelfSelectClient::submitBlockTemplate()
 {
     using namespace rapidjson;
     Document doc(kObjectType);
     auto &allocator = doc.GetAllocator();
 
-    m_blocktemplate = Json::getString(result,kBlocktemplateBlob);
-    m_blockDiff     = Json::getUint64(result, kDifficulty);
+    m_blocktemplate = m_template.blob;
+    m_blockDiff     = m_template.difficulty;
 
     Value params(kObjectType);
     params.AddMember(StringRef(kId),            m_job.clientId().toJSON(), allocator);
     params.AddMember(StringRef(kJobId),         m_job.id().toJSON(), allocator);
-    params.AddMember(StringRef(kBlob),          result[kBlocktemplateBlob], allocator);
+    params.AddMember(StringRef(kBlob),          m_template.blob.toJSON(), allocator);
     params.AddMember(StringRef(kHeight),        m_job.height(), allocator);
-    params.AddMember(StringRef(kDifficulty),    result[kDifficulty], allocator);
-    params.AddMember(StringRef(kPrevHash),      result[kPrevHash], allocator);
-    params.AddMember(StringRef(kSeedHash),      result[kSeedHash], allocator);
-    params.AddMember(StringRef(kNextSeedHash),  result[kNextSeedHash], allocator);
+    params.AddMember(StringRef(kDifficulty),    m_template.difficulty, allocator);
+    params.AddMember(StringRef(kPrevHash),      m_template.prevHash.toJSON(), allocator);
+    params.AddMember(StringRef(kSeedHash),      m_template.seedHash.toJSON(), allocator);
+    params.AddMember(StringRef(kNextSeedHash),  m_template.nextSeedHash.toJSON(), allocator);
 
     JsonRequest::create(doc, sequence(), "block_template", params);
 
-    send(doc, [this](const rapidjson::Value &result, bool success, uint64_t) {
+    const double ts     = m_jobTs;
+    const char *source  = m_source;
+    const String jobId  = m_job.id();
+
+    send(doc, [this, ts, source, jobId](const rapidjson::Value &result, bool success, uint64_t) {
         if (!success) {
             if (!isQuiet()) {
                 LOG_ERR("[%s] error: " RED_BOLD("\"%s\"") RED_S ", code: %d", pool().daemon().url().data(), Json::getString(result, "message"), Json::getInt(result, "code"));
@@ -245,7 +454,8 @@ void xmrig::SelfSelectClient::submitBlockTemplate(rapidjson::Value &result)
             return retry();
         }
 
-        if (!m_active) {
+        // A newer pool job was answered in the meantime.
+        if (!m_active || m_job.id() != jobId) {
             return;
         }
 
@@ -254,6 +464,14 @@ void xmrig::SelfSelectClient::submitBlockTemplate(rapidjson::Value &result)
         }
 
         setState(IdleState);
+
+        // Pool job (or new block notification) to miner job, including the daemon and pool round trips.
+        const double latency = Chrono::highResolutionMSecs() - ts;
+        m_latency            = m_jobs ? m_latency + (latency - m_latency) / static_cast<double>(std::min<uint64_t>(m_jobs + 1, 100)) : latency;
+        ++m_jobs;
+
+        LOG_V1("%s " WHITE_BOLD("self-select") " job ready in " CYAN_BOLD("%.1f ms") " (%s), avg " CYAN("%.1f ms"), tag(), latency, source, m_latency);
+
         m_listener->onJobReceived(this, m_job, rapidjson::Value{});
     });
 }
@@ -282,8 +500,11 @@ void xmrig::SelfSelectClient::submitOriginDaemon(const JobResult& result)
     Value params(kArrayType);
     params.PushBack(m_blocktemplate.toJSON(), doc.GetAllocator());
 
-    JsonRequest::create(doc, m_sequence, "submitblock", params);
-    m_results[m_sequence] = SubmitResult(m_sequence, result.diff, result.actualDiff(), 0, result.backend);
+    // Own id, so the reply is never mistaken for the getblocktemplate response.
+    const int64_t id = m_sequence++;
+
+    JsonRequest::create(doc, id, "submitblock", params);
+    m_results[id] = SubmitResult(id, result.diff, result.actualDiff(), 0, result.backend);
 
     FetchRequest req(HTTP_POST, pool().daemon().host(), pool().daemon().port(), "/json_rpc", doc, pool().daemon().isTLS(), isQuiet());
     fetch(tag(), std::move(req), m_httpListener);
@@ -297,6 +518,8 @@ void xmrig::SelfSelectClient::submitOriginDaemon(const JobResult& result)
 void xmrig::SelfSelectClient::onHttpData(const HttpData &data)
 {
     if (data.status != 200) {
+        m_request = 0;
+
         return retry();
     }
 
@@ -306,14 +529,19 @@ void xmrig::SelfSelectClient::onHttpData(const HttpData &data)
             LOG_ERR("[%s] JSON decode failed: \"%s\"",  pool().daemon().url().data(), rapidjson::GetParseError_En(doc.GetParseError()));
         }
 
+        m_request = 0;
+
         return retry();
     }
 
+    // Stale getblocktemplate responses and submitblock replies.
     const int64_t id = Json::getInt64(doc, "id", -1);
-    if (id > 0 && m_sequence - id != 1) {
+    if (id > 0 && id != m_request) {
         return;
     }
 
+    m_request = 0;
+
     if (!parseResponse(id, doc["result"], Json::getObject(doc, "error"))) {
         retry();
     }
@@ -24,8 +24,11 @@
 
 #include "base/kernel/interfaces/IClient.h"
 #include "base/kernel/interfaces/IClientListener.h"
+#include "base/kernel/interfaces/ITimerListener.h"
+#include "base/kernel/interfaces/IZmqListener.h"
 #include "base/net/http/HttpListener.h"
 #include "base/net/stratum/Job.h"
+#include "base/tools/cryptonote/BlockTemplate.h"
 
 
 #include <map>
@@ -35,7 +38,16 @@
 namespace xmrig {
 
 
-class SelfSelectClient : public IClient, public IClientListener, public IHttpListener
+class Timer;
+
+
+/**
+ * Self-select mode: the pool sends the wallet and extra nonce, the block template comes from the pool's daemon.
+ * When the pool sets "daemon-zmq-port" the client subscribes to the daemon's chain notifications, prefetches
+ * a fresh template on every new block and uses the cached one (patching the extra nonce in place) for the pool
+ * jobs that follow. Only one getblocktemplate request is in flight, a template is only sent for a new pool job.
+ */
+class SelfSelectClient : public IClient, public IClientListener, public IHttpListener, public ITimerListener, public IZmqListener
 {
 public:
     XMRIG_DISABLE_COPY_MOVE_DEFAULT(SelfSelectClient)
@@ -56,6 +68,7 @@ protected:
     inline const Job &job() const override                                          { return m_job; }
     inline const Pool &pool() const override                                        { return m_client->pool(); }
     inline const String &ip() const override                                        { return m_client->ip(); }
+    inline double rtt() const override                                              { return m_client->rtt(); }
     inline int id() const override                                                  { return m_client->id(); }
     inline int64_t send(const rapidjson::Value &obj, Callback callback) override    { return m_client->send(obj, callback); }
     inline int64_t send(const rapidjson::Value &obj) override                       { return m_client->send(obj); }
@@ -75,17 +88,25 @@ protected:
     void tick(uint64_t now) override;
 
     // IClientListener
-    inline void onClose(IClient *, int failures) override                                           { m_listener->onClose(this, failures); setState(IdleState); m_active = false; }
-    inline void onLoginSuccess(IClient *) override                                                  { m_listener->onLoginSuccess(this); setState(IdleState); m_active = true; }
     inline void onResultAccepted(IClient *, const SubmitResult &result, const char *error) override { m_listener->onResultAccepted(this, result, error); }
     inline void onVerifyAlgorithm(const IClient *, const Algorithm &algorithm, bool *ok) override   { m_listener->onVerifyAlgorithm(this, algorithm, ok); }
 
+    void onClose(IClient *, int failures) override;
     void onJobReceived(IClient *, const Job &job, const rapidjson::Value &params) override;
     void onLogin(IClient *, rapidjson::Document &doc, rapidjson::Value &params) override;
+    void onLoginSuccess(IClient *) override;
 
     // IHttpListener
     void onHttpData(const HttpData &data) override;
 
+    // ITimerListener
+    void onTimer(const Timer *timer) override;
+
+    // IZmqListener
+    void onZmqClose(ZmqSubscriber *subscriber, const char *error) override;
+    void onZmqConnected(ZmqSubscriber *subscriber) override;
+    void onZmqMessage(ZmqSubscriber *subscriber, const char *data, size_t size) override;
+
 private:
     enum State {
         IdleState,
@@ -93,33 +114,67 @@ private:
         RetryState
     };
 
+    // Last getblocktemplate result, "parsed" is only filled while the ZMQ subscription is up.
+    struct Template
+    {
+        bool cacheable          = false;
+        bool valid              = false;
+        BlockTemplate parsed;
+        String blob;
+        String extraNonce;
+        String hashingBlob;
+        String nextSeedHash;
+        String prevHash;
+        String seedHash;
+        String wallet;
+        uint64_t difficulty     = 0;
+        uint64_t height         = 0;
+        uint64_t ts             = 0;
+    };
+
     inline bool isQuiet() const { return m_quiet || m_failures >= m_retries; }
 
+    bool applyTemplate();
+    bool fromCache();
     bool parseResponse(int64_t id, rapidjson::Value &result, const rapidjson::Value &error);
     void getBlockTemplate();
     void retry();
     void setState(State state);
-    void submitBlockTemplate(rapidjson::Value &result);
+    void submitBlockTemplate();
     void submitOriginDaemon(const JobResult &result);
 
     bool m_active                   = false;
     bool m_quiet                    = false;
+    bool m_submit                   = false;
     const bool m_submitToOrigin;
+    const char *m_source            = nullptr;
+    double m_jobTs                  = 0.0;
+    double m_latency                = 0.0;
     IClient *m_client;
     IClientListener *m_listener;
     int m_retries                   = 5;
+    int m_tipRetries                = 0;
     int64_t m_failures              = 0;
+    int64_t m_request               = 0;
     int64_t m_sequence              = 1;
     Job m_job;
     State m_state                   = IdleState;
     std::map<int64_t, SubmitResult> m_results;
     std::shared_ptr<IHttpListener> m_httpListener;
     String m_blocktemplate;
+    String m_requestNonce;
+    String m_requestWallet;
+    String m_tip;
+    Template m_template;
+    Timer *m_timer;
     uint64_t m_blockDiff            = 0;
+    uint64_t m_jobs                 = 0;
     uint64_t m_originNotSubmitted   = 0;
     uint64_t m_originSubmitted      = 0;
     uint64_t m_retryPause           = 5000;
     uint64_t m_timestamp            = 0;
+    uint64_t m_zmqTs                = 0;
+    ZmqSubscriber *m_zmq            = nullptr;
 };
 
 
@@ -33,6 +33,7 @@
 #include "base/net/http/HttpListener.h"
 #include "base/net/stratum/benchmark/BenchConfig.h"
 #include "base/tools/Cvt.h"
+#include "base/tools/Parking.h"
 #include "version.h"
 
 #ifdef XMRIG_FEATURE_DMI
@@ -168,6 +169,7 @@ void xmrig::BenchClient::onBenchDone(uint64_t result, uint64_t diff, uint64_t ts
 
     const double dt = static_cast<int64_t>(ts - m_readyTime) / 1000.0;
     LOG_NOTICE("%s " WHITE_BOLD("benchmark finished in ") CYAN_BOLD("%.3f seconds (%.1f h/s)") WHITE_BOLD_S " hash sum = " CLEAR "%s%016" PRIX64 CLEAR, tag(), dt, BenchState::size() / dt, color, result);
+    LOG_NOTICE("%s " WHITE_BOLD("resume to first hash ") CYAN_BOLD("%.3f ms") BLACK_BOLD(" (slowest worker)"), tag(), Parking::latency());
 
     if (m_token.isEmpty()) {
         printExit();
@@ -47,6 +47,7 @@ public:
     inline const Job &job() const override                                          { return m_job; }
     inline const Pool &pool() const override                                        { return m_pool; }
     inline const String &ip() const override                                        { return m_ip; }
+    inline double rtt() const override                                              { return 0.0; }
     inline int id() const override                                                  { return 0; }
     inline int64_t send(const rapidjson::Value &, Callback) override                { return 0; }
     inline int64_t send(const rapidjson::Value &) override                          { return 0; }
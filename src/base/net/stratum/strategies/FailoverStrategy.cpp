@@ -22,6 +22,24 @@
 #include "base/kernel/interfaces/IClient.h"
 #include "base/kernel/interfaces/IStrategyListener.h"
 #include "base/kernel/Platform.h"
+#include "base/io/log/Log.h"
+#include "base/io/log/Tags.h"
+#include "base/net/tools/LatencyProbe.h"
+#include "base/tools/Chrono.h"
+
+
+#include <algorithm>
+
+
+namespace xmrig {
+
+
+constexpr uint64_t kProbeInterval   = 300000;   // ms between latency probes of grouped endpoints
+constexpr double kSwitchRatio       = 0.2;      // a faster endpoint must win by 20%
+constexpr double kSwitchMin         = 2.0;      // and by at least 2 ms
+
+
+} // namespace xmrig
 
 
 xmrig::FailoverStrategy::FailoverStrategy(const std::vector<Pool> &pools, int retryPause, int retries, IStrategyListener *listener, bool quiet) :
@@ -50,6 +68,10 @@ xmrig::FailoverStrategy::~FailoverStrategy()
     for (IClient *client : m_pools) {
         client->deleteLater();
     }
+
+    for (LatencyProbe *probe : m_probes) {
+        delete probe;
+    }
 }
 
 
@@ -61,7 +83,9 @@ void xmrig::FailoverStrategy::add(const Pool &pool)
     client->setRetryPause(m_retryPause * 1000);
     client->setQuiet(m_quiet);
 
+    m_rank.push_back(m_pools.size());
     m_pools.push_back(client);
+    m_probes.push_back(nullptr);
 }
 
 
@@ -75,9 +99,48 @@ int64_t xmrig::FailoverStrategy::submit(const JobResult &result)
 }
 
 
+rapidjson::Value xmrig::FailoverStrategy::toJSON(rapidjson::Document &doc) const
+{
+    using namespace rapidjson;
+    auto &allocator = doc.GetAllocator();
+
+    if (std::none_of(m_probes.begin(), m_probes.end(), [](const LatencyProbe *probe) { return probe != nullptr; })) {
+        return Value(kNullType);
+    }
+
+    Value out(kArrayType);
+
+    for (size_t id : m_rank) {
+        const IClient *client = m_pools[id];
+
+        Value endpoint(kObjectType);
+        endpoint.AddMember("url",           client->pool().url().toJSON(), allocator);
+        endpoint.AddMember("group",         client->pool().group().toJSON(), allocator);
+        endpoint.AddMember("active",        m_active == static_cast<int>(id), allocator);
+        endpoint.AddMember("connect_rtt",   rtt(id) > 0.0 ? Value(rtt(id)) : Value(kNullType), allocator);
+        endpoint.AddMember("rtt",           client->rtt() > 0.0 ? Value(client->rtt()) : Value(kNullType), allocator);
+
+        out.PushBack(endpoint, allocator);
+    }
+
+    return out;
+}
+
+
 void xmrig::FailoverStrategy::connect()
 {
-    m_pools[m_index]->connect();
+    // The first connection waits for the first round of latency probes, at most the probe timeout.
+    if (m_probeTs == 0) {
+        m_deferred = true;
+
+        if (probe()) {
+            return;
+        }
+
+        m_deferred = false;
+    }
+
+    m_pools[m_rank[m_index]]->connect();
 }
 
 
@@ -113,8 +176,9 @@ void xmrig::FailoverStrategy::stop()
         pool->disconnect();
     }
 
-    m_index  = 0;
-    m_active = -1;
+    m_index     = 0;
+    m_active    = -1;
+    m_deferred  = false;
 
     m_listener->onPause(this);
 }
@@ -125,6 +189,16 @@ void xmrig::FailoverStrategy::tick(uint64_t now)
     for (IClient *client : m_pools) {
         client->tick(now);
     }
+
+    for (LatencyProbe *probe : m_probes) {
+        if (probe) {
+            probe->tick(now);
+        }
+    }
+
+    if (m_probeTs && now > m_probeTs && m_pending == 0) {
+        probe();
+    }
 }
 
 
@@ -139,12 +213,20 @@ void xmrig::FailoverStrategy::onClose(IClient *client, int failures)
         m_listener->onPause(this);
     }
 
+    const size_t pos = position(client->id());
+
+    // A grouped endpoint ranked above the current connection after a latency probe failed to connect, the current connection stays.
+    if (m_probes[static_cast<size_t>(client->id())] && pos != 0 && pos < m_index) {
+        client->disconnect();
+        return;
+    }
+
     if (m_index == 0 && failures < m_retries) {
         return;
     }
 
-    if (m_index == static_cast<size_t>(client->id()) && (m_pools.size() - m_index) > 1) {
-        m_pools[++m_index]->connect();
+    if (m_index == pos && (m_pools.size() - m_index) > 1) {
+        m_pools[m_rank[++m_index]]->connect();
     }
 }
 
@@ -167,18 +249,19 @@ void xmrig::FailoverStrategy::onLoginSuccess(IClient *client)
 {
     int active = m_active;
 
-    if (client->id() == 0 || !isActive()) {
+    if (!isActive() || position(client->id()) < position(m_active)) {
         active = client->id();
     }
 
-    for (size_t i = 1; i < m_pools.size(); ++i) {
-        if (active != static_cast<int>(i)) {
-            m_pools[i]->disconnect();
+    for (size_t i = 1; i < m_rank.size(); ++i) {
+        if (active != static_cast<int>(m_rank[i])) {
+            m_pools[m_rank[i]]->disconnect();
         }
     }
 
     if (active >= 0 && active != m_active) {
-        m_index = m_active = active;
+        m_active = active;
+        m_index  = position(active);
         m_listener->onActive(this, client);
     }
 }
@@ -194,3 +277,141 @@ void xmrig::FailoverStrategy::onVerifyAlgorithm(const IClient *client, const Alg
 {
     m_listener->onVerifyAlgorithm(this, client, algorithm, ok);
 }
+
+
+void xmrig::FailoverStrategy::onLatency(LatencyProbe *, double)
+{
+    if (m_pending == 0 || --m_pending > 0) {
+        return;
+    }
+
+    rank();
+
+    if (m_deferred) {
+        m_deferred = false;
+        m_pools[m_rank[m_index]]->connect();
+    }
+}
+
+
+bool xmrig::FailoverStrategy::probe()
+{
+    if (m_probeTs == 0) {
+        for (size_t i = 0; i < m_pools.size(); ++i) {
+            const Pool &pool = m_pools[i]->pool();
+            if (pool.group().isEmpty() || pool.proxy().isValid()) {
+                continue;
+            }
+
+            const auto members = std::count_if(m_pools.begin(), m_pools.end(), [&pool](const IClient *client) {
+                return client->pool().group() == pool.group() && !client->pool().proxy().isValid();
+            });
+
+            if (members > 1) {
+                m_probes[i] = new LatencyProbe(i, pool.host(), pool.port(), this);
+            }
+        }
+    }
+
+    m_probeTs = Chrono::steadyMSecs() + kProbeInterval;
+    m_pending = static_cast<size_t>(std::count_if(m_probes.begin(), m_probes.end(), [](const LatencyProbe *probe) { return probe != nullptr; }));
+
+    if (m_pending == 0) {
+        return false;
+    }
+
+    // Probes may complete synchronously if DNS records are cached and the connection is refused, m_pending is set beforehand.
+    for (LatencyProbe *probe : m_probes) {
+        if (probe) {
+            probe->start();
+        }
+    }
+
+    return true;
+}
+
+
+double xmrig::FailoverStrategy::rtt(size_t id) const
+{
+    return m_probes[id] ? m_probes[id]->rtt() : -1.0;
+}
+
+
+size_t xmrig::FailoverStrategy::position(int id) const
+{
+    const auto it = std::find(m_rank.begin(), m_rank.end(), static_cast<size_t>(id));
+
+    return it != m_rank.end() ? static_cast<size_t>(it - m_rank.begin()) : m_rank.size();
+}
+
+
+void xmrig::FailoverStrategy::rank()
+{
+    const int current = isActive() ? m_active : (m_deferred ? -1 : static_cast<int>(m_rank[m_index]));
+
+    auto faster = [this](size_t a, size_t b) {
+        return rtt(a) > 0.0 && (rtt(b) <= 0.0 || rtt(a) < rtt(b));
+    };
+
+    std::vector<bool> done(m_pools.size(), false);
+    std::vector<size_t> leaders;
+
+    for (size_t i = 0; i < m_rank.size(); ++i) {
+        if (!m_probes[m_rank[i]] || done[m_rank[i]]) {
+            continue;
+        }
+
+        const String &group = m_pools[m_rank[i]]->pool().group();
+        std::vector<size_t> slots;
+        std::vector<size_t> members;
+
+        for (size_t j = i; j < m_rank.size(); ++j) {
+            const size_t id = m_rank[j];
+
+            if (m_probes[id] && m_pools[id]->pool().group() == group) {
+                slots.push_back(j);
+                members.push_back(id);
+                done[id] = true;
+            }
+        }
+
+        const size_t leader = members.front();
+        std::stable_sort(members.begin(), members.end(), faster);
+
+        // Hysteresis: after the first round the current leader is replaced only by a clearly faster endpoint.
+        if (!m_deferred && members.front() != leader && rtt(leader) > 0.0) {
+            const double best = rtt(members.front());
+
+            if (best > rtt(leader) * (1.0 - kSwitchRatio) || rtt(leader) - best < kSwitchMin) {
+                members.erase(std::find(members.begin(), members.end(), leader));
+                members.insert(members.begin(), leader);
+            }
+        }
+
+        for (size_t k = 0; k < slots.size(); ++k) {
+            m_rank[slots[k]] = members[k];
+        }
+
+        if (rtt(members.front()) > 0.0 && (m_deferred || members.front() != leader) && !m_quiet) {
+            const Pool &pool = m_pools[members.front()]->pool();
+
+            LOG_INFO("%s " WHITE_BOLD("group %s") " fastest endpoint " CYAN_BOLD("%s:%d") " connect " CYAN_BOLD("%.1f ms"),
+                     Tags::network(), group.data(), pool.host().data(), pool.port(), rtt(members.front()));
+        }
+
+        if (members.front() != leader) {
+            leaders.push_back(members.front());
+        }
+    }
+
+    m_index = current >= 0 ? position(current) : 0;
+
+    // A new group leader ranked above the current connection takes over after its login succeeds.
+    if (isActive()) {
+        for (size_t id : leaders) {
+            if (position(static_cast<int>(id)) < m_index) {
+                m_pools[id]->connect();
+            }
+        }
+    }
+}
@@ -24,6 +24,7 @@
 
 
 #include "base/kernel/interfaces/IClientListener.h"
+#include "base/kernel/interfaces/ILatencyListener.h"
 #include "base/kernel/interfaces/IStrategy.h"
 #include "base/net/stratum/Pool.h"
 #include "base/tools/Object.h"
@@ -34,9 +35,15 @@ namespace xmrig {
 
 class Client;
 class IStrategyListener;
+class LatencyProbe;
 
 
-class FailoverStrategy : public IStrategy, public IClientListener
+/**
+ * Pools are tried in configuration order, pools that share a "group" are equivalent endpoints of the same
+ * service: their TCP connect round trip is probed before the first connection and every 5 minutes, the group
+ * is ordered by latency and the miner moves to a faster member only when it wins by a clear margin.
+ */
+class FailoverStrategy : public IStrategy, public IClientListener, public ILatencyListener
 {
 public:
     XMRIG_DISABLE_COPY_MOVE_DEFAULT(FailoverStrategy)
@@ -49,9 +56,10 @@ public:
 
 protected:
     inline bool isActive() const override           { return m_active >= 0; }
-    inline IClient *client() const override         { return isActive() ? active() : m_pools[m_index]; }
+    inline IClient *client() const override         { return isActive() ? active() : m_pools[m_rank[m_index]]; }
 
     int64_t submit(const JobResult &result) override;
+    rapidjson::Value toJSON(rapidjson::Document &doc) const override;
     void connect() override;
     void resume() override;
     void setAlgo(const Algorithm &algo) override;
@@ -66,16 +74,28 @@ protected:
     void onResultAccepted(IClient *client, const SubmitResult &result, const char *error) override;
     void onVerifyAlgorithm(const IClient *client, const Algorithm &algorithm, bool *ok) override;
 
+    void onLatency(LatencyProbe *probe, double rtt) override;
+
 private:
     inline IClient *active() const { return m_pools[static_cast<size_t>(m_active)]; }
 
+    bool probe();
+    double rtt(size_t id) const;
+    size_t position(int id) const;
+    void rank();
+
     const bool m_quiet;
     const int m_retries;
     const int m_retryPause;
+    bool m_deferred         = false;
     int m_active            = -1;
     IStrategyListener *m_listener;
     size_t m_index          = 0;
+    size_t m_pending        = 0;
     std::vector<IClient*> m_pools;
+    std::vector<LatencyProbe*> m_probes;
+    std::vector<size_t> m_rank;
+    uint64_t m_probeTs      = 0;
 };
 
 
@@ -54,6 +54,12 @@ int64_t xmrig::SinglePoolStrategy::submit(const JobResult &result)
 }
 
 
+rapidjson::Value xmrig::SinglePoolStrategy::toJSON(rapidjson::Document &) const
+{
+    return rapidjson::Value(rapidjson::kNullType);
+}
+
+
 void xmrig::SinglePoolStrategy::connect()
 {
     m_client->connect();
@@ -52,6 +52,7 @@ protected:
     inline IClient *client() const override         { return m_client; }
 
     int64_t submit(const JobResult &result) override;
+    rapidjson::Value toJSON(rapidjson::Document &doc) const override;
     void connect() override;
     void resume() override;
     void setAlgo(const Algorithm &algo) override;
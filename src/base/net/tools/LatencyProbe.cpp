@@ -0,0 +1,141 @@
+/* XMRig
+ * Copyright (c) 2018-2024 SChernykh   <https://github.com/SChernykh>
+ * Copyright (c) 2016-2024 XMRig       <https://github.com/xmrig>, <support@xmrig.com>
+ *
+ *   This program is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "base/net/tools/LatencyProbe.h"
+#include "base/kernel/interfaces/ILatencyListener.h"
+#include "base/net/dns/Dns.h"
+#include "base/net/dns/DnsRecords.h"
+#include "base/net/dns/DnsRequest.h"
+#include "base/tools/Chrono.h"
+#include "base/tools/Handle.h"
+
+
+namespace xmrig {
+
+
+constexpr uint64_t kProbeTimeout    = 3000;     // ms, DNS lookup included
+constexpr double kSmoothing         = 0.5;      // weight of the newest sample
+
+
+} // namespace xmrig
+
+
+xmrig::LatencyProbe::LatencyProbe(size_t id, const String &host, uint16_t port, ILatencyListener *listener) :
+    m_id(id),
+    m_host(host),
+    m_port(port),
+    m_listener(listener)
+{
+}
+
+
+xmrig::LatencyProbe::~LatencyProbe()
+{
+    cancel();
+}
+
+
+void xmrig::LatencyProbe::start()
+{
+    if (isActive()) {
+        return;
+    }
+
+    m_deadline = Chrono::steadyMSecs() + kProbeTimeout;
+    m_dns      = Dns::resolve(m_host, this);
+}
+
+
+void xmrig::LatencyProbe::tick(uint64_t now)
+{
+    if (isActive() && now > m_deadline) {
+        cancel();
+        finish(-1.0);
+    }
+}
+
+
+void xmrig::LatencyProbe::onResolved(const DnsRecords &records, int status, const char *)
+{
+    m_dns.reset();
+
+    if (!isActive()) {
+        return;
+    }
+
+    if (status < 0 && records.isEmpty()) {
+        return finish(-1.0);
+    }
+
+    auto req = new uv_connect_t;
+
+    m_socket       = new uv_tcp_t;
+    m_socket->data = this;
+
+    uv_tcp_init(uv_default_loop(), m_socket);
+    uv_tcp_nodelay(m_socket, 1);
+
+    m_ts = Chrono::highResolutionMSecs();
+
+    if (uv_tcp_connect(req, m_socket, records.get().addr(m_port), onConnect) < 0) {
+        delete req;
+        cancel();
+        finish(-1.0);
+    }
+}
+
+
+void xmrig::LatencyProbe::onConnect(uv_connect_t *req, int status)
+{
+    auto probe = static_cast<LatencyProbe *>(req->handle->data);
+    auto socket = reinterpret_cast<uv_tcp_t *>(req->handle);
+    delete req;
+
+    // Detached probes (timed out or destroyed) already closed the socket.
+    if (!probe) {
+        return;
+    }
+
+    const double rtt = Chrono::highResolutionMSecs() - probe->m_ts;
+
+    probe->m_socket = nullptr;
+    Handle::close(socket);
+
+    probe->finish(status == 0 ? rtt : -1.0);
+}
+
+
+void xmrig::LatencyProbe::cancel()
+{
+    m_dns.reset();
+
+    if (m_socket) {
+        m_socket->data = nullptr;
+        Handle::close(m_socket);
+        m_socket = nullptr;
+    }
+}
+
+
+void xmrig::LatencyProbe::finish(double rtt)
+{
+    m_deadline = 0;
+    m_rtt      = rtt > 0.0 && m_rtt > 0.0 ? m_rtt + (rtt - m_rtt) * kSmoothing : rtt;
+
+    m_listener->onLatency(this, rtt);
+}
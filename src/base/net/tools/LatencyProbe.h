@@ -0,0 +1,84 @@
+/* XMRig
+ * Copyright (c) 2018-2024 SChernykh   <https://github.com/SChernykh>
+ * Copyright (c) 2016-2024 XMRig       <https://github.com/xmrig>, <support@xmrig.com>
+ *
+ *   This program is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef XMRIG_LATENCYPROBE_H
+#define XMRIG_LATENCYPROBE_H
+
+
+#include <uv.h>
+
+
+#include "base/kernel/interfaces/IDnsListener.h"
+#include "base/tools/String.h"
+
+
+#include <memory>
+
+
+namespace xmrig {
+
+
+class DnsRequest;
+class ILatencyListener;
+
+
+/**
+ * Measures the TCP connect round trip to a pool endpoint: resolves the host, opens a connection
+ * and closes it as soon as the handshake completes. The result is reported as a smoothed value,
+ * -1 means the endpoint did not answer within the timeout.
+ */
+class LatencyProbe : public IDnsListener
+{
+public:
+    XMRIG_DISABLE_COPY_MOVE_DEFAULT(LatencyProbe)
+
+    LatencyProbe(size_t id, const String &host, uint16_t port, ILatencyListener *listener);
+    ~LatencyProbe() override;
+
+    inline bool isActive() const    { return m_deadline > 0; }
+    inline double rtt() const       { return m_rtt; }
+    inline size_t id() const        { return m_id; }
+
+    void start();
+    void tick(uint64_t now);
+
+protected:
+    void onResolved(const DnsRecords &records, int status, const char *error) override;
+
+private:
+    static void onConnect(uv_connect_t *req, int status);
+
+    void cancel();
+    void finish(double rtt);
+
+    const size_t m_id;
+    const String m_host;
+    const uint16_t m_port;
+    double m_rtt                = -1.0;
+    double m_ts                 = 0.0;
+    ILatencyListener *m_listener;
+    std::shared_ptr<DnsRequest> m_dns;
+    uint64_t m_deadline         = 0;
+    uv_tcp_t *m_socket          = nullptr;
+};
+
+
+} /* namespace xmrig */
+
+
+#endif /* XMRIG_LATENCYPROBE_H */
@@ -0,0 +1,343 @@
+/* XMRig
+ * Copyright (c) 2018-2024 SChernykh   <https://github.com/SChernykh>
+ * Copyright (c) 2016-2024 XMRig       <https://github.com/xmrig>, <support@xmrig.com>
+ *
+ *   This program is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "base/net/tools/ZmqSubscriber.h"
+#include "base/io/log/Log.h"
+#include "base/kernel/interfaces/IZmqListener.h"
+#include "base/kernel/Platform.h"
+#include "base/net/dns/Dns.h"
+#include "base/net/dns/DnsRecords.h"
+#include "base/net/dns/DnsRequest.h"
+#include "base/net/tools/NetBuffer.h"
+#include "base/tools/bswap_64.h"
+#include "base/tools/Handle.h"
+
+
+#include <algorithm>
+#include <cstring>
+
+
+namespace xmrig {
+
+
+static const char kGreeting[64] = { static_cast<char>(-1), 0, 0, 0, 0, 0, 0, 0, 0, 127, 3, 0, 'N', 'U', 'L', 'L' };
+static const char kHandshake[]  = "\4\x19\5READY\xbSocket-Type\0\0\0\3SUB";
+
+constexpr size_t kGreetingSize1     = 11;
+constexpr size_t kMaxMessageSize    = 65536;
+constexpr size_t kMaxTopicSize      = 254;
+
+
+} // namespace xmrig
+
+
+xmrig::ZmqSubscriber::ZmqSubscriber(const String &host, uint16_t port, const char *topic, IZmqListener *listener) :
+    m_host(host),
+    m_topic(topic),
+    m_port(port),
+    m_listener(listener)
+{
+}
+
+
+xmrig::ZmqSubscriber::~ZmqSubscriber()
+{
+    close();
+}
+
+
+void xmrig::ZmqSubscriber::close()
+{
+    m_dns.reset();
+
+    if (m_socket) {
+        m_socket->data = nullptr;
+        Handle::close(m_socket);
+        m_socket = nullptr;
+    }
+
+    m_state = STATE_IDLE;
+    m_recvBuf.clear();
+}
+
+
+void xmrig::ZmqSubscriber::connect()
+{
+    if (isActive()) {
+        return;
+    }
+
+    m_state = STATE_CONNECTING;
+    m_dns   = Dns::resolve(m_host, this);
+}
+
+
+void xmrig::ZmqSubscriber::onResolved(const DnsRecords &records, int status, const char *error)
+{
+    m_dns.reset();
+
+    if (m_state != STATE_CONNECTING) {
+        return;
+    }
+
+    if (status < 0 && records.isEmpty()) {
+        return shutdown(error);
+    }
+
+    auto req = new uv_connect_t;
+
+    m_socket       = new uv_tcp_t;
+    m_socket->data = this;
+
+    uv_tcp_init(uv_default_loop(), m_socket);
+    uv_tcp_nodelay(m_socket, 1);
+
+    if (Platform::hasKeepalive()) {
+        uv_tcp_keepalive(m_socket, 1, 60);
+    }
+
+    const int rc = uv_tcp_connect(req, m_socket, records.get().addr(m_port), onConnect);
+    if (rc < 0) {
+        delete req;
+        shutdown(uv_strerror(rc));
+    }
+}
+
+
+void xmrig::ZmqSubscriber::onConnect(uv_connect_t *req, int status)
+{
+    auto subscriber = static_cast<ZmqSubscriber *>(req->handle->data);
+    delete req;
+
+    // Closed while connecting, the socket is already released.
+    if (!subscriber) {
+        return;
+    }
+
+    if (status < 0) {
+        return subscriber->shutdown(uv_strerror(status));
+    }
+
+    subscriber->m_state = STATE_GREETING_1;
+
+    if (subscriber->write(kGreeting, kGreetingSize1)) {
+        uv_read_start(reinterpret_cast<uv_stream_t *>(subscriber->m_socket), NetBuffer::onAlloc, onRead);
+    }
+}
+
+
+void xmrig::ZmqSubscriber::onRead(uv_stream_t *stream, ssize_t nread, const uv_buf_t *buf)
+{
+    auto subscriber = static_cast<ZmqSubscriber *>(stream->data);
+
+    if (subscriber && nread < 0) {
+        subscriber->shutdown(uv_strerror(static_cast<int>(nread)));
+    }
+    else if (subscriber && nread > 0) {
+        subscriber->read(buf->base, static_cast<size_t>(nread));
+    }
+
+    NetBuffer::release(buf);
+}
+
+
+bool xmrig::ZmqSubscriber::parse()
+{
+    const char *data = m_recvBuf.data();
+    size_t avail     = m_recvBuf.size();
+    bool more        = false;
+
+    m_message.clear();
+
+    do {
+        if (avail < 1) {
+            return false;
+        }
+
+        more                 = (data[0] & 1) != 0;
+        const bool long_size = (data[0] & 2) != 0;
+        const bool command   = (data[0] & 4) != 0;
+
+        ++data;
+        --avail;
+
+        uint64_t size = 0;
+
+        if (long_size) {
+            if (avail < sizeof(uint64_t)) {
+                return false;
+            }
+
+            memcpy(&size, data, sizeof(uint64_t));
+            size   = bswap_64(size);
+            data  += sizeof(uint64_t);
+            avail -= sizeof(uint64_t);
+        }
+        else {
+            if (avail < sizeof(uint8_t)) {
+                return false;
+            }
+
+            size = static_cast<uint8_t>(*data);
+            ++data;
+            --avail;
+        }
+
+        if (size > kMaxMessageSize - m_message.size()) {
+            shutdown("message is too large");
+
+            return false;
+        }
+
+        if (avail < size) {
+            return false;
+        }
+
+        if (!command) {
+            m_message.insert(m_message.end(), data, data + size);
+        }
+
+        data  += size;
+        avail -= size;
+    } while (more);
+
+    m_recvBuf.erase(m_recvBuf.begin(), m_recvBuf.begin() + (data - m_recvBuf.data()));
+    m_listener->onZmqMessage(this, m_message.data(), m_message.size());
+
+    return m_state == STATE_CONNECTED;
+}
+
+
+bool xmrig::ZmqSubscriber::write(const char *data, size_t size)
+{
+    m_sendBuf.assign(data, data + size);
+
+    uv_buf_t buf;
+    buf.base = m_sendBuf.data();
+    buf.len  = static_cast<uint32_t>(m_sendBuf.size());
+
+    const int rc = uv_try_write(reinterpret_cast<uv_stream_t *>(m_socket), &buf, 1);
+    if (static_cast<size_t>(rc) == size) {
+        return true;
+    }
+
+    shutdown(rc < 0 ? uv_strerror(rc) : "short write");
+
+    return false;
+}
+
+
+void xmrig::ZmqSubscriber::read(const char *data, size_t size)
+{
+    m_recvBuf.insert(m_recvBuf.end(), data, data + size);
+
+    while (true) {
+        switch (m_state) {
+        case STATE_GREETING_1:
+            if (m_recvBuf.size() < kGreetingSize1) {
+                return;
+            }
+
+            if (m_recvBuf[0] != static_cast<char>(-1) || m_recvBuf[9] != 127 || m_recvBuf[10] != 3) {
+                return shutdown("invalid greeting");
+            }
+
+            if (!write(kGreeting + kGreetingSize1, sizeof(kGreeting) - kGreetingSize1)) {
+                return;
+            }
+
+            m_state = STATE_GREETING_2;
+            break;
+
+        case STATE_GREETING_2:
+            if (m_recvBuf.size() < sizeof(kGreeting)) {
+                return;
+            }
+
+            if (memcmp(m_recvBuf.data() + 12, kGreeting + 12, 20) != 0) {
+                return shutdown("unsupported security mechanism");
+            }
+
+            m_recvBuf.erase(m_recvBuf.begin(), m_recvBuf.begin() + sizeof(kGreeting));
+
+            if (!write(kHandshake, sizeof(kHandshake) - 1)) {
+                return;
+            }
+
+            m_state = STATE_HANDSHAKE;
+            break;
+
+        case STATE_HANDSHAKE:
+            {
+                if (m_recvBuf.size() < 2) {
+                    return;
+                }
+
+                const size_t size = static_cast<uint8_t>(m_recvBuf[1]);
+                if (m_recvBuf[0] != 4 || size < 18) {
+                    return shutdown("invalid handshake");
+                }
+
+                if (m_recvBuf.size() < size + 2) {
+                    return;
+                }
+
+                if (memcmp(m_recvBuf.data() + 2, kHandshake + 2, 18) != 0) {
+                    return shutdown("invalid handshake data");
+                }
+
+                m_recvBuf.erase(m_recvBuf.begin(), m_recvBuf.begin() + size + 2);
+
+                // SUBSCRIBE is sent as a message frame: 0x01 followed by the topic prefix.
+                const size_t topic = std::min(m_topic.size(), kMaxTopicSize);
+                char subscribe[kMaxTopicSize + 3] = { 0, static_cast<char>(topic + 1), 1 };
+                memcpy(subscribe + 3, m_topic.data(), topic);
+
+                if (!write(subscribe, topic + 3)) {
+                    return;
+                }
+
+                m_state = STATE_CONNECTED;
+
+                LOG_DEBUG(CYAN("tcp-zmq://%s:%u") BLACK_BOLD(" connected"), m_host.data(), m_port);
+
+                m_listener->onZmqConnected(this);
+            }
+            break;
+
+        case STATE_CONNECTED:
+            if (!parse()) {
+                return;
+            }
+            break;
+
+        default:
+            return;
+        }
+    }
+}
+
+
+void xmrig::ZmqSubscriber::shutdown(const char *error)
+{
+    LOG_DEBUG(CYAN("tcp-zmq://%s:%u") BLACK_BOLD(" disconnected") " %s", m_host.data(), m_port, error ? error : "");
+
+    close();
+
+    m_listener->onZmqClose(this, error);
+}
@@ -0,0 +1,99 @@
+/* XMRig
+ * Copyright (c) 2018-2024 SChernykh   <https://github.com/SChernykh>
+ * Copyright (c) 2016-2024 XMRig       <https://github.com/xmrig>, <support@xmrig.com>
+ *
+ *   This program is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef XMRIG_ZMQSUBSCRIBER_H
+#define XMRIG_ZMQSUBSCRIBER_H
+
+
+#include <uv.h>
+
+
+#include "base/kernel/interfaces/IDnsListener.h"
+#include "base/tools/String.h"
+
+
+#include <memory>
+#include <vector>
+
+
+namespace xmrig {
+
+
+class DnsRequest;
+class IZmqListener;
+
+
+/**
+ * Minimal ZMTP 3.0 subscriber (NULL mechanism, SUB socket) for monerod "zmq-pub" notifications, shared by
+ * the daemon and self-select clients. Every complete message is passed to the listener as one buffer with
+ * the topic included, after an error the socket is closed and the listener decides when to connect again.
+ */
+class ZmqSubscriber : public IDnsListener
+{
+public:
+    XMRIG_DISABLE_COPY_MOVE_DEFAULT(ZmqSubscriber)
+
+    ZmqSubscriber(const String &host, uint16_t port, const char *topic, IZmqListener *listener);
+    ~ZmqSubscriber() override;
+
+    inline bool isActive() const        { return m_state != STATE_IDLE; }
+    inline bool isConnected() const     { return m_state == STATE_CONNECTED; }
+    inline const String &host() const   { return m_host; }
+    inline uint16_t port() const        { return m_port; }
+
+    void close();
+    void connect();
+
+protected:
+    void onResolved(const DnsRecords &records, int status, const char *error) override;
+
+private:
+    enum State {
+        STATE_IDLE,
+        STATE_CONNECTING,
+        STATE_GREETING_1,
+        STATE_GREETING_2,
+        STATE_HANDSHAKE,
+        STATE_CONNECTED
+    };
+
+    static void onConnect(uv_connect_t *req, int status);
+    static void onRead(uv_stream_t *stream, ssize_t nread, const uv_buf_t *buf);
+
+    bool parse();
+    bool write(const char *data, size_t size);
+    void read(const char *data, size_t size);
+    void shutdown(const char *error);
+
+    const String m_host;
+    const String m_topic;
+    const uint16_t m_port;
+    IZmqListener *m_listener;
+    State m_state           = STATE_IDLE;
+    std::shared_ptr<DnsRequest> m_dns;
+    std::vector<char> m_message;
+    std::vector<char> m_recvBuf;
+    std::vector<char> m_sendBuf;
+    uv_tcp_t *m_socket      = nullptr;
+};
+
+
+} /* namespace xmrig */
+
+
+#endif /* XMRIG_ZMQSUBSCRIBER_H */
@@ -0,0 +1,203 @@
+/* XMRig
+ * Copyright (c) 2018-2024 SChernykh   <https://github.com/SChernykh>
+ * Copyright (c) 2016-2024 XMRig       <https://github.com/xmrig>, <support@xmrig.com>
+ *
+ *   This program is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "base/tools/Parking.h"
+#include "base/tools/Chrono.h"
+
+
+#include <climits>
+
+
+#if defined(__x86_64__) || defined(_M_AMD64) || defined(__i386__) || defined(_M_IX86)
+#   include <emmintrin.h>
+#   define XMRIG_PARKING_PAUSE() _mm_pause()
+#elif defined(__aarch64__) || defined(__arm__)
+#   define XMRIG_PARKING_PAUSE() __asm__ __volatile__("yield" ::: "memory")
+#elif defined(__riscv)
+    // Zihintpause "pause", encoded as a FENCE hint it is a nop on harts without the extension.
+#   define XMRIG_PARKING_PAUSE() __asm__ __volatile__(".word 0x0100000f" ::: "memory")
+#else
+#   include <thread>
+#   define XMRIG_PARKING_PAUSE() std::this_thread::yield()
+#endif
+
+
+#ifdef XMRIG_OS_LINUX
+#   include <linux/futex.h>
+#   include <sys/syscall.h>
+#   include <unistd.h>
+#   include <ctime>
+#else
+#   include <chrono>
+#   include <condition_variable>
+#   include <mutex>
+#endif
+
+
+namespace xmrig {
+
+
+constexpr double kSpinTime = 0.05;  // ms to spin before sleeping
+
+
+std::atomic<uint32_t> Parking::m_epoch{ 0 };
+static std::atomic<uint32_t> waiters{ 0 };
+static std::atomic<uint64_t> wakeTs{ 0 };       // us
+static std::atomic<uint64_t> maxLatency{ 0 };   // us
+
+
+#ifndef XMRIG_OS_LINUX
+static std::mutex mutex;
+static std::condition_variable cv;
+#endif
+
+
+#if defined(__riscv) && defined(XMRIG_OS_LINUX) && defined(__NR_riscv_hwprobe)
+static bool hasZawrs()
+{
+    struct { int64_t key; uint64_t value; } pair = { 4 /* RISCV_HWPROBE_KEY_IMA_EXT_0 */, 0 };
+
+    return syscall(__NR_riscv_hwprobe, &pair, 1, 0, nullptr, 0) == 0 && (pair.value & (1ULL << 48) /* RISCV_HWPROBE_EXT_ZAWRS */);
+}
+
+static const bool zawrs = hasZawrs();
+#endif
+
+
+// One spin step while *address == value, on RISC-V with Zawrs the hart stalls until the word is written (or the short timeout expires).
+static inline void spinOnce(const volatile uint32_t *address, uint32_t value, bool shortTimeout)
+{
+#   if defined(__riscv) && defined(XMRIG_OS_LINUX) && defined(__NR_riscv_hwprobe)
+    if (zawrs) {
+        uint32_t tmp;
+
+        if (shortTimeout) {
+            __asm__ __volatile__("lr.w %0, (%1)\n\tbne %0, %2, 1f\n\t.word 0x01d00073\n1:" : "=&r"(tmp) : "r"(address), "r"(value) : "memory"); // wrs.sto
+        }
+        else {
+            __asm__ __volatile__("lr.w %0, (%1)\n\tbne %0, %2, 1f\n\t.word 0x00d00073\n1:" : "=&r"(tmp) : "r"(address), "r"(value) : "memory"); // wrs.nto
+        }
+
+        return;
+    }
+#   endif
+
+    (void) address;
+    (void) value;
+    (void) shortTimeout;
+
+    XMRIG_PARKING_PAUSE();
+}
+
+
+static inline uint64_t now()
+{
+    return static_cast<uint64_t>(Chrono::highResolutionMSecs() * 1000.0);
+}
+
+
+} // namespace xmrig
+
+
+double xmrig::Parking::latency()
+{
+    return static_cast<double>(maxLatency.load(std::memory_order_relaxed)) / 1000.0;
+}
+
+
+void xmrig::Parking::relax()
+{
+    XMRIG_PARKING_PAUSE();
+}
+
+
+void xmrig::Parking::resumed()
+{
+    const uint64_t ts = wakeTs.load(std::memory_order_relaxed);
+    if (!ts) {
+        return;
+    }
+
+    const uint64_t value = now() - ts;
+    uint64_t current     = maxLatency.load(std::memory_order_relaxed);
+
+    while (value > current && !maxLatency.compare_exchange_weak(current, value, std::memory_order_relaxed)) {}
+}
+
+
+void xmrig::Parking::spin(const volatile uint32_t *address, uint32_t value)
+{
+    spinOnce(address, value, false);
+}
+
+
+void xmrig::Parking::wait(uint32_t epoch, uint32_t timeout)
+{
+    const auto address = reinterpret_cast<const volatile uint32_t *>(&m_epoch);
+    const double ts    = Chrono::highResolutionMSecs();
+
+    while (m_epoch.load(std::memory_order_acquire) == epoch) {
+        if (Chrono::highResolutionMSecs() - ts > kSpinTime) {
+            break;
+        }
+
+        spinOnce(address, epoch, true);
+    }
+
+    if (m_epoch.load(std::memory_order_acquire) != epoch) {
+        return;
+    }
+
+    waiters.fetch_add(1);
+
+#   ifdef XMRIG_OS_LINUX
+    timespec ts_timeout{};
+    ts_timeout.tv_sec  = timeout / 1000;
+    ts_timeout.tv_nsec = static_cast<long>(timeout % 1000) * 1000000L;
+
+    syscall(SYS_futex, &m_epoch, FUTEX_WAIT_PRIVATE, epoch, &ts_timeout, nullptr, 0);
+#   else
+    std::unique_lock<std::mutex> lock(mutex);
+    cv.wait_for(lock, std::chrono::milliseconds(timeout), [epoch] { return m_epoch.load(std::memory_order_acquire) != epoch; });
+#   endif
+
+    waiters.fetch_sub(1);
+}
+
+
+void xmrig::Parking::wake()
+{
+    wakeTs.store(now(), std::memory_order_relaxed);
+
+#   ifdef XMRIG_OS_LINUX
+    m_epoch.fetch_add(1);
+
+    if (waiters.load() > 0) {
+        syscall(SYS_futex, &m_epoch, FUTEX_WAKE_PRIVATE, INT_MAX, nullptr, nullptr, 0);
+    }
+#   else
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        m_epoch.fetch_add(1);
+    }
+
+    if (waiters.load() > 0) {
+        cv.notify_all();
+    }
+#   endif
+}
@@ -0,0 +1,56 @@
+/* XMRig
+ * Copyright (c) 2018-2024 SChernykh   <https://github.com/SChernykh>
+ * Copyright (c) 2016-2024 XMRig       <https://github.com/xmrig>, <support@xmrig.com>
+ *
+ *   This program is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef XMRIG_PARKING_H
+#define XMRIG_PARKING_H
+
+
+#include <atomic>
+#include <cstdint>
+
+
+namespace xmrig {
+
+
+/**
+ * Process wide parking lot for worker threads: a thread takes epoch(), re-checks its condition and calls wait(),
+ * any wake() after epoch() was taken releases it immediately. Linux uses a futex, other systems a condition variable.
+ *
+ * Before going to sleep the waiter spins for a few microseconds with pause (x86), yield (ARM) or wrs.nto (RISC-V Zawrs),
+ * so short waits don't pay for a syscall.
+ */
+class Parking
+{
+public:
+    static inline uint32_t epoch()                  { return m_epoch.load(std::memory_order_acquire); }
+
+    static double latency();
+    static void relax();
+    static void resumed();
+    static void spin(const volatile uint32_t *address, uint32_t value);
+    static void wait(uint32_t epoch, uint32_t timeout);
+    static void wake();
+
+private:
+    static std::atomic<uint32_t> m_epoch;
+};
+
+
+} /* namespace xmrig */
+
+#endif /* XMRIG_PARKING_H */
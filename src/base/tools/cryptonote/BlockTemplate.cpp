@@ -161,6 +161,22 @@ bool xmrig::BlockTemplate::parse(const String &blocktemplate, const Coin &coin,
 }
 
 
+// Replaces the miner tx extra nonce in place, only the miner tx hash and its merkle branch are rehashed.
+bool xmrig::BlockTemplate::setTxExtraNonce(const Buffer &extraNonce)
+{
+    if (m_hashes.empty() || m_txExtraNonce.size() == 0 || extraNonce.size() != m_txExtraNonce.size()) {
+        return false;
+    }
+
+    memcpy(m_blob.data() + offset(TX_EXTRA_NONCE_OFFSET), extraNonce.data(), extraNonce.size());
+
+    calculateMinerTxHash(blob(MINER_TX_PREFIX_OFFSET), blob(MINER_TX_PREFIX_END_OFFSET), m_hashes.data());
+    calculateRootHash(blob(MINER_TX_PREFIX_OFFSET), blob(MINER_TX_PREFIX_END_OFFSET), m_minerTxMerkleTreeBranch, m_rootHash);
+
+    return true;
+}
+
+
 void xmrig::BlockTemplate::generateHashingBlob(Buffer &out) const
 {
     out.clear();
@@ -110,6 +110,7 @@ public:
     bool parse(const char *blocktemplate, size_t size, const Coin &coin, bool hashes);
     bool parse(const rapidjson::Value &blocktemplate, const Coin &coin, bool hashes = kCalcHashes);
     bool parse(const String &blocktemplate, const Coin &coin, bool hashes = kCalcHashes);
+    bool setTxExtraNonce(const Buffer &extraNonce);
     void calculateMerkleTreeHash();
     void generateHashingBlob(Buffer &out) const;
 
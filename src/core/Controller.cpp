@@ -18,10 +18,12 @@
 
 #include "core/Controller.h"
 #include "backend/cpu/Cpu.h"
+#include "backend/cpu/CpuCoSchedule.h"
 #include "core/config/Config.h"
 #include "core/Miner.h"
 #include "crypto/common/VirtualMemory.h"
 #include "net/Network.h"
+#include "net/telemetry/Telemetry.h"
 
 
 #ifdef XMRIG_FEATURE_API
@@ -30,6 +32,12 @@
 #endif
 
 
+#ifdef XMRIG_ALGO_RANDOMX
+#   include "crypto/rx/RxMemoryPlan.h"
+#endif
+
+
+#include <algorithm>
 #include <cassert>
 
 
@@ -49,7 +57,15 @@ int xmrig::Controller::init()
 {
     Base::init();
 
+    CpuCoSchedule::init(config()->cpu(), config()->pools());
+
+#   ifdef XMRIG_ALGO_RANDOMX
+    RxMemoryPlan::init(config()->rx(), config()->cpu());
+
+    VirtualMemory::init(std::max(config()->cpu().memPoolSize(), RxMemoryPlan::poolSize()), config()->cpu().hugePageSize());
+#   else
     VirtualMemory::init(config()->cpu().memPoolSize(), config()->cpu().hugePageSize());
+#   endif
 
     m_network = std::make_shared<Network>(this);
 
@@ -66,7 +82,8 @@ void xmrig::Controller::start()
 {
     Base::start();
 
-    m_miner = std::make_shared<Miner>(this);
+    m_miner     = std::make_shared<Miner>(this);
+    m_telemetry = std::make_shared<Telemetry>(this);
 
     network()->connect();
 }
@@ -76,6 +93,7 @@ void xmrig::Controller::stop()
 {
     Base::stop();
 
+    m_telemetry.reset();
     m_network.reset();
 
     m_miner->stop();
@@ -33,6 +33,7 @@ class HwApi;
 class Job;
 class Miner;
 class Network;
+class Telemetry;
 
 
 class Controller : public Base
@@ -54,6 +55,7 @@ public:
 private:
     std::shared_ptr<Miner> m_miner;
     std::shared_ptr<Network> m_network;
+    std::shared_ptr<Telemetry> m_telemetry;
 
 #   ifdef XMRIG_FEATURE_API
     std::shared_ptr<HwApi> m_hwApi;
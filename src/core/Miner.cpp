@@ -27,6 +27,7 @@
 #include "backend/common/Hashrate.h"
 #include "backend/cpu/Cpu.h"
 #include "backend/cpu/CpuBackend.h"
+#include "backend/cpu/CpuCoSchedule.h"
 #include "base/io/log/Log.h"
 #include "base/io/log/Tags.h"
 #include "base/kernel/Platform.h"
@@ -59,6 +60,7 @@
 #   include "crypto/rx/Profiler.h"
 #   include "crypto/rx/Rx.h"
 #   include "crypto/rx/RxConfig.h"
+#   include "crypto/rx/RxMemoryPlan.h"
 #endif
 
 
@@ -161,6 +163,27 @@ public:
         }
 
         reply.AddMember("algorithms", algo, allocator);
+
+        Value nonce(kObjectType);
+        nonce.AddMember("utilization",  Nonce::utilization(job.index()), allocator);
+        nonce.AddMember("reserved",     Nonce::reserved(), allocator);
+        nonce.AddMember("wasted",       Nonce::wasted(), allocator);
+        nonce.AddMember("exhausted",    Nonce::exhausted(), allocator);
+
+        reply.AddMember("nonce", nonce, allocator);
+
+        if (coBackend) {
+            if (!reply.HasMember("co-schedule")) {
+                reply.AddMember("co-schedule", Value(kObjectType), allocator);
+            }
+
+            auto &co = reply["co-schedule"];
+            co.AddMember("algo",        coJob.algorithm().toJSON(), allocator);
+            co.AddMember("threads",     static_cast<uint64_t>(coBackend->hashrate() ? coBackend->hashrate()->threads() : 0), allocator);
+            co.AddMember("primary",     static_cast<uint64_t>(CpuCoSchedule::threads(controller->config()->cpu())), allocator);
+            co.AddMember("utilization", Nonce::utilization(coJob.index()), allocator);
+            co.AddMember("probe",       CpuCoSchedule::toJSON(doc), allocator);
+        }
     }
 
 
@@ -177,7 +200,7 @@ public:
 
         for (IBackend *backend : backends) {
             const Hashrate *hr = backend->hashrate();
-            if (!hr) {
+            if (!hr || backend == coBackend) {
                 continue;
             }
 
@@ -214,6 +237,17 @@ public:
             hashrate.AddMember("threads", threads, allocator);
         }
 
+        if (coBackend && coBackend->hashrate()) {
+            const Hashrate *hr = coBackend->hashrate();
+
+            Value co(kArrayType);
+            co.PushBack(Hashrate::normalize(hr->calc(Hashrate::ShortInterval)),  allocator);
+            co.PushBack(Hashrate::normalize(hr->calc(Hashrate::MediumInterval)), allocator);
+            co.PushBack(Hashrate::normalize(hr->calc(Hashrate::LargeInterval)),  allocator);
+
+            hashrate.AddMember("co-schedule", co, allocator);
+        }
+
         reply.AddMember("hashrate", hashrate, allocator);
     }
 
@@ -294,7 +328,7 @@ public:
 
         for (auto backend : backends) {
             const auto hashrate = backend->hashrate();
-            if (hashrate) {
+            if (hashrate && backend != coBackend) {
                 ++count;
 
                 const auto h0 = hashrate->calc(Hashrate::ShortInterval);
@@ -348,6 +382,18 @@ public:
                  avg_hashrate_buf
                  );
 
+        if (coBackend && coBackend->hashrate()) {
+            const auto hashrate = coBackend->hashrate();
+
+            LOG_INFO("%s " WHITE_BOLD("co-schedule speed") " 10s/60s/15m " MAGENTA_BOLD("%s") MAGENTA(" %s %s ") MAGENTA_BOLD("H/s") " " WHITE_BOLD("%s"),
+                     Tags::miner(),
+                     Hashrate::format(hashrate->calc(Hashrate::ShortInterval),  num,          16),
+                     Hashrate::format(hashrate->calc(Hashrate::MediumInterval), num + 16,     16),
+                     Hashrate::format(hashrate->calc(Hashrate::LargeInterval),  num + 16 * 2, 16),
+                     coJob.algorithm().name()
+                     );
+        }
+
 #       ifdef XMRIG_FEATURE_BENCHMARK
         for (auto backend : backends) {
             backend->printBenchProgress();
@@ -356,13 +402,23 @@ public:
     }
 
 
+    inline bool isReady() const
+    {
+#       ifdef XMRIG_ALGO_RANDOMX
+        return job.isValid() && (job.algorithm().family() != Algorithm::RANDOM_X || Rx::isReady(job));
+#       else
+        return job.isValid();
+#       endif
+    }
+
+
 #   ifdef XMRIG_ALGO_RANDOMX
     inline bool initRX() const { return Rx::init(job, controller->config()->rx(), controller->config()->cpu()); }
 #   endif
 
 
 #   ifdef XMRIG_ALGO_GHOSTRIDER
-    inline void initGhostRider() const { ghostrider::benchmark(); }
+    inline void initGhostRider() const { ghostrider::benchmark(controller->config()->cpu().grTuneCache(), controller->config()->cpu().grTune()); }
 #   endif
 
 
@@ -375,6 +431,8 @@ public:
     int32_t auto_pause = 0;
     bool reset          = true;
     Controller *controller;
+    IBackend *coBackend = nullptr;
+    Job coJob;
     Job job;
     mutable std::map<Algorithm::Id, double> maxHashrate;
     std::vector<IBackend *> backends;
@@ -415,9 +473,14 @@ xmrig::Miner::Miner(Controller *controller)
 
     d_ptr->timer = new Timer(this);
 
-    d_ptr->backends.reserve(3);
+    d_ptr->backends.reserve(4);
     d_ptr->backends.push_back(new CpuBackend(controller));
 
+    if (controller->config()->pools().coActive() > 0) {
+        d_ptr->coBackend = new CpuBackend(controller, true);
+        d_ptr->backends.push_back(d_ptr->coBackend);
+    }
+
 #   ifdef XMRIG_FEATURE_OPENCL
     d_ptr->backends.push_back(new OclBackend(controller));
 #   endif
@@ -460,6 +523,20 @@ const std::vector<xmrig::IBackend *> &xmrig::Miner::backends() const
 }
 
 
+xmrig::IBackend *xmrig::Miner::coBackend() const
+{
+    return d_ptr->coBackend;
+}
+
+
+xmrig::Job xmrig::Miner::coJob() const
+{
+    std::lock_guard<std::mutex> lock(mutex);
+
+    return d_ptr->coJob;
+}
+
+
 xmrig::Job xmrig::Miner::job() const
 {
     std::lock_guard<std::mutex> lock(mutex);
@@ -513,6 +590,51 @@ void xmrig::Miner::pause()
 }
 
 
+void xmrig::Miner::setCoJob(const Job &job)
+{
+    if (!d_ptr->coBackend) {
+        return;
+    }
+
+    if (job.algorithm().family() == Algorithm::RANDOM_X) {
+        LOG_ERR("%s " RED_BOLD("co-schedule job ignored") RED(", algorithm ") RED_BOLD("%s") RED(" is memory-bound"), Tags::miner(), job.algorithm().name());
+
+        return;
+    }
+
+    d_ptr->coBackend->prepare(job);
+
+    mutex.lock();
+
+    const bool changed = d_ptr->coJob.isValid() != job.isValid() || d_ptr->coJob.algorithm() != job.algorithm();
+
+    if (!d_ptr->coJob.isEqualBlob(job)) {
+        Nonce::reset(2);
+    }
+
+    d_ptr->coJob = job;
+    d_ptr->coJob.setIndex(2);
+
+    const Job primary = d_ptr->job;
+    const bool ready  = d_ptr->isReady();
+
+    mutex.unlock();
+
+    // The primary partition shrinks or grows back to the whole CPU when the co-scheduled job appears or goes away.
+    if (changed && ready) {
+        for (IBackend *backend : d_ptr->backends) {
+            if (backend != d_ptr->coBackend) {
+                backend->setJob(primary);
+            }
+        }
+    }
+
+    d_ptr->coBackend->setJob(primary);
+
+    Nonce::touch(Nonce::CPU_CO);
+}
+
+
 void xmrig::Miner::setEnabled(bool enabled)
 {
     if (d_ptr->enabled == enabled) {
@@ -627,6 +749,10 @@ void xmrig::Miner::stop()
 
 void xmrig::Miner::onConfigChanged(Config *config, Config *previousConfig)
 {
+#   ifdef XMRIG_ALGO_RANDOMX
+    RxMemoryPlan::init(config->rx(), config->cpu());
+#   endif
+
     d_ptr->rebuild();
 
     if (config->pools() != previousConfig->pools() && config->pools().active() > 0) {
@@ -658,7 +784,7 @@ void xmrig::Miner::onTimer(const Timer *)
             backend->printHealth();
         }
 
-        if (backend->hashrate()) {
+        if (backend->hashrate() && backend != d_ptr->coBackend) {
             const auto h = backend->hashrate()->calc(Hashrate::ShortInterval);
             if (h.first) {
                 maxHashrate += h.second;
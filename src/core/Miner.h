@@ -52,9 +52,12 @@ public:
     bool isEnabled(const Algorithm &algorithm) const;
     const Algorithms &algorithms() const;
     const std::vector<IBackend *> &backends() const;
+    IBackend *coBackend() const;
+    Job coJob() const;
     Job job() const;
     void execCommand(char command);
     void pause();
+    void setCoJob(const Job &job);
     void setEnabled(bool enabled);
     void setJob(const Job &job, bool donate);
     void stop();
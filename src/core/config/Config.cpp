@@ -29,6 +29,7 @@
 #include "base/kernel/interfaces/IJsonReader.h"
 #include "base/net/dns/Dns.h"
 #include "crypto/common/Assembly.h"
+#include "net/telemetry/TelemetryConfig.h"
 
 
 #ifdef XMRIG_ALGO_RANDOMX
@@ -78,6 +79,7 @@ class ConfigPrivate
 public:
     bool pauseOnBattery = false;
     CpuConfig cpu;
+    TelemetryConfig telemetry;
     uint32_t idleTime   = 0;
 
 #   ifdef XMRIG_ALGO_RANDOMX
@@ -138,6 +140,12 @@ const xmrig::CpuConfig &xmrig::Config::cpu() const
 }
 
 
+const xmrig::TelemetryConfig &xmrig::Config::telemetry() const
+{
+    return d_ptr->telemetry;
+}
+
+
 uint32_t xmrig::Config::idleTime() const
 {
     return d_ptr->idleTime * 1000U;
@@ -216,6 +224,7 @@ bool xmrig::Config::read(const IJsonReader &reader, const char *fileName)
     d_ptr->setIdleTime(reader.getValue(kPauseOnActive));
 
     d_ptr->cpu.read(reader.getValue(CpuConfig::kField));
+    d_ptr->telemetry = TelemetryConfig(reader.getObject(TelemetryConfig::kField));
 
 #   ifdef XMRIG_ALGO_RANDOMX
     if (!d_ptr->rx.read(reader.getValue(RxConfig::kField))) {
@@ -300,6 +309,7 @@ void xmrig::Config::getJSON(rapidjson::Document &doc) const
 #   endif
 
     doc.AddMember(StringRef(DnsConfig::kField),         Dns::config().toJSON(doc), allocator);
+    doc.AddMember(StringRef(TelemetryConfig::kField),   telemetry().toJSON(doc), allocator);
     doc.AddMember(StringRef(kUserAgent),                m_userAgent.toJSON(), allocator);
     doc.AddMember(StringRef(kVerbose),                  Log::verbose(), allocator);
     doc.AddMember(StringRef(kWatch),                    m_watch, allocator);
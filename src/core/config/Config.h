@@ -37,6 +37,7 @@ class CudaConfig;
 class IThread;
 class OclConfig;
 class RxConfig;
+class TelemetryConfig;
 
 
 class Config : public BaseConfig
@@ -70,6 +71,7 @@ public:
 
     bool isPauseOnBattery() const;
     const CpuConfig &cpu() const;
+    const TelemetryConfig &telemetry() const;
     uint32_t idleTime() const;
 
 #   ifdef XMRIG_FEATURE_OPENCL
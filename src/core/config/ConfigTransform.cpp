@@ -191,6 +191,14 @@ void xmrig::ConfigTransform::transform(rapidjson::Document &doc, int key, const
     case IConfig::RandomXCacheQoSKey: /* --cache-qos */
         return set(doc, RxConfig::kField, RxConfig::kCacheQoS, true);
 
+    case IConfig::RandomXScrubKey: /* --randomx-scrub */
+        return set(doc, RxConfig::kField, RxConfig::kScrub, static_cast<uint64_t>(strtoul(arg, nullptr, 10)));
+
+#   ifdef XMRIG_OS_LINUX
+    case IConfig::RandomXHandoffKey: /* --randomx-handoff */
+        return set(doc, RxConfig::kField, RxConfig::kHandoff, arg);
+#   endif
+
     case IConfig::HugePagesJitKey: /* --huge-pages-jit */
         return set(doc, CpuConfig::kField, CpuConfig::kHugePagesJit, true);
 #   endif
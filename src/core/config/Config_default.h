@@ -52,6 +52,9 @@ R"===(
         "rdmsr": true,
         "wrmsr": true,
         "cache_qos": false,
+        "scrub": 0,
+        "auto-threads": 0,
+        "handoff": null,
         "numa": true,
         "scratchpad_prefetch_mode": 1
     },
@@ -63,9 +66,17 @@ R"===(
         "priority": null,
         "memory-pool": false,
         "yield": true,
+        "co-schedule": -1,
         "max-threads-hint": 100,
         "asm": true,
         "argon2-impl": null,
+        "gr-tune": null,
+        "gr-tune-cache": false,
+        "kinds": {
+            "mining": 0.3,
+            "ghostrider": 0.75,
+            "intensity": 0.9
+        },
         "cn/0": false,
         "cn-lite/0": false
     },
@@ -102,6 +113,8 @@ R"===(
             "tls": false,
             "tls-fingerprint": null,
             "daemon": false,
+            "co-schedule": false,
+            "group": null,
             "socks5": null,
             "self-select": null,
             "submit-to-origin": false
@@ -122,6 +135,14 @@ R"===(
         "ciphersuites": null,
         "dhparam": null
     },
+    "telemetry": {
+        "enabled": false,
+        "host": "127.0.0.1",
+        "port": 8125,
+        "format": "statsd",
+        "prefix": "xmrig",
+        "interval": 10
+    },
     "user-agent": null,
     "verbose": 0,
     "watch": true,
@@ -138,6 +138,10 @@ static const option options[] = {
     { "no-rdmsr",              0, nullptr, IConfig::RandomXRdmsrKey       },
     { "randomx-cache-qos",     0, nullptr, IConfig::RandomXCacheQoSKey    },
     { "cache-qos",             0, nullptr, IConfig::RandomXCacheQoSKey    },
+    { "randomx-scrub",         1, nullptr, IConfig::RandomXScrubKey       },
+#   ifdef XMRIG_OS_LINUX
+    { "randomx-handoff",       1, nullptr, IConfig::RandomXHandoffKey     },
+#   endif
 #   endif
 #   ifdef XMRIG_FEATURE_OPENCL
     { "opencl",                0, nullptr, IConfig::OclKey                },
@@ -106,6 +106,10 @@ static inline const std::string &usage()
     u += "      --randomx-wrmsr=N         write custom value(s) to MSR registers or disable MSR mod (-1)\n";
     u += "      --randomx-no-rdmsr        disable reverting initial MSR values on exit\n";
     u += "      --randomx-cache-qos       enable Cache QoS\n";
+    u += "      --randomx-scrub=N         verify and repair N random dataset items per second in background\n";
+#   ifdef XMRIG_OS_LINUX
+    u += "      --randomx-handoff=PATH    Unix socket to take over the dataset from a running instance (live upgrade)\n";
+#   endif
 #   endif
 
 #   ifdef XMRIG_FEATURE_OPENCL
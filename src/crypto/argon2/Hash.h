@@ -34,18 +34,37 @@
 namespace xmrig { namespace argon2 {
 
 
+template<Algorithm::Id ALGO>
+constexpr uint32_t t_cost()     { return ALGO == Algorithm::AR2_CHUKWA ? 3 : 4; }
+
+
+template<Algorithm::Id ALGO>
+constexpr uint32_t m_cost()     { return ALGO == Algorithm::AR2_CHUKWA ? 512 : (ALGO == Algorithm::AR2_CHUKWA_V2 ? 1024 : 256); }
+
+
 template<Algorithm::Id ALGO>
 inline void single_hash(const uint8_t *__restrict__ input, size_t size, uint8_t *__restrict__ output, cryptonight_ctx **__restrict__ ctx, uint64_t)
 {
-    if (ALGO == Algorithm::AR2_CHUKWA) {
-        argon2id_hash_raw_ex(3, 512, 1, input, size, input, 16, output, 32, ctx[0]->memory);
-    }
-    else if (ALGO == Algorithm::AR2_CHUKWA_V2) {
-        argon2id_hash_raw_ex(4, 1024, 1, input, size, input, 16, output, 32, ctx[0]->memory);
-    }
-    else if (ALGO == Algorithm::AR2_WRKZ) {
-        argon2id_hash_raw_ex(4, 256, 1, input, size, input, 16, output, 32, ctx[0]->memory);
+    argon2id_hash_raw_ex(t_cost<ALGO>(), m_cost<ALGO>(), 1, input, size, input, 16, output, 32, ctx[0]->memory);
+}
+
+
+// Hashes N inputs (input + i * size) into N outputs (output + i * 32), each with its own ctx[i]->memory.
+// The Argon2 segments of the N hashes are filled in pairs to keep two independent block computations in flight.
+template<Algorithm::Id ALGO, size_t N>
+inline void multi_hash(const uint8_t *__restrict__ input, size_t size, uint8_t *__restrict__ output, cryptonight_ctx **__restrict__ ctx, uint64_t)
+{
+    const void *in[N];
+    void *out[N];
+    void *memory[N];
+
+    for (size_t i = 0; i < N; ++i) {
+        in[i]     = input + i * size;
+        out[i]    = output + i * 32;
+        memory[i] = ctx[i]->memory;
     }
+
+    argon2id_hash_raw_ex_multi(t_cost<ALGO>(), m_cost<ALGO>(), in, size, in, 16, out, 32, memory, N);
 }
 
 
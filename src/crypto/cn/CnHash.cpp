@@ -52,6 +52,23 @@
     } while (0)
 
 
+#ifdef XMRIG_ALGO_ARGON2
+#   define ADD_FN_ARGON2(algo) do {                                                          \
+        m_map[algo] = new cn_hash_fun_array{};                                                \
+        m_map[algo]->data[AV_SINGLE][Assembly::NONE]      = argon2::single_hash<algo>;        \
+        m_map[algo]->data[AV_SINGLE_SOFT][Assembly::NONE] = argon2::single_hash<algo>;        \
+        m_map[algo]->data[AV_DOUBLE][Assembly::NONE]      = argon2::multi_hash<algo, 2>;      \
+        m_map[algo]->data[AV_DOUBLE_SOFT][Assembly::NONE] = argon2::multi_hash<algo, 2>;      \
+        m_map[algo]->data[AV_TRIPLE][Assembly::NONE]      = argon2::multi_hash<algo, 3>;      \
+        m_map[algo]->data[AV_TRIPLE_SOFT][Assembly::NONE] = argon2::multi_hash<algo, 3>;      \
+        m_map[algo]->data[AV_QUAD][Assembly::NONE]        = argon2::multi_hash<algo, 4>;      \
+        m_map[algo]->data[AV_QUAD_SOFT][Assembly::NONE]   = argon2::multi_hash<algo, 4>;      \
+        m_map[algo]->data[AV_PENTA][Assembly::NONE]       = argon2::multi_hash<algo, 5>;      \
+        m_map[algo]->data[AV_PENTA_SOFT][Assembly::NONE]  = argon2::multi_hash<algo, 5>;      \
+    } while (0)
+#endif
+
+
 bool cn_sse41_enabled = false;
 bool cn_vaes_enabled = false;
 
@@ -359,17 +376,9 @@ xmrig::CnHash::CnHash()
 #   endif
 
 #   ifdef XMRIG_ALGO_ARGON2
-    m_map[Algorithm::AR2_CHUKWA] = new cn_hash_fun_array{};
-    m_map[Algorithm::AR2_CHUKWA]->data[AV_SINGLE][Assembly::NONE]         = argon2::single_hash<Algorithm::AR2_CHUKWA>;
-    m_map[Algorithm::AR2_CHUKWA]->data[AV_SINGLE_SOFT][Assembly::NONE]    = argon2::single_hash<Algorithm::AR2_CHUKWA>;
-
-    m_map[Algorithm::AR2_CHUKWA_V2] = new cn_hash_fun_array{};
-    m_map[Algorithm::AR2_CHUKWA_V2]->data[AV_SINGLE][Assembly::NONE]      = argon2::single_hash<Algorithm::AR2_CHUKWA_V2>;
-    m_map[Algorithm::AR2_CHUKWA_V2]->data[AV_SINGLE_SOFT][Assembly::NONE] = argon2::single_hash<Algorithm::AR2_CHUKWA_V2>;
-
-    m_map[Algorithm::AR2_WRKZ] = new cn_hash_fun_array{};
-    m_map[Algorithm::AR2_WRKZ]->data[AV_SINGLE][Assembly::NONE]           = argon2::single_hash<Algorithm::AR2_WRKZ>;
-    m_map[Algorithm::AR2_WRKZ]->data[AV_SINGLE_SOFT][Assembly::NONE]      = argon2::single_hash<Algorithm::AR2_WRKZ>;
+    ADD_FN_ARGON2(Algorithm::AR2_CHUKWA);
+    ADD_FN_ARGON2(Algorithm::AR2_CHUKWA_V2);
+    ADD_FN_ARGON2(Algorithm::AR2_WRKZ);
 #   endif
 
 #   ifdef XMRIG_ALGO_GHOSTRIDER
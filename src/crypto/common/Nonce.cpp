@@ -23,8 +23,13 @@
 namespace xmrig {
 
 std::atomic<bool> Nonce::m_paused = {true};
-std::atomic<uint64_t>  Nonce::m_sequence[Nonce::MAX] = { {1}, {1}, {1} };
-std::atomic<uint64_t> Nonce::m_nonces[2] = { {0}, {0} };
+std::atomic<uint64_t>  Nonce::m_sequence[Nonce::MAX] = { {1}, {1}, {1}, {1} };
+std::atomic<uint64_t> Nonce::m_nonces[3] = { {0}, {0}, {0} };
+std::atomic<uint64_t> Nonce::m_masks[3] = { {0}, {0}, {0} };
+std::atomic<uint64_t> Nonce::m_exhausted = {0};
+std::atomic<uint64_t> Nonce::m_reserved = {0};
+std::atomic<bool> Nonce::m_spent[3] = { {false}, {false}, {false} };
+std::atomic<uint64_t> Nonce::m_wasted = {0};
 
 
 } // namespace xmrig
@@ -37,6 +42,9 @@ bool xmrig::Nonce::next(uint8_t index, uint32_t *nonce, uint32_t reserveCount, u
         return false;
     }
 
+    m_masks[index].store(mask, std::memory_order_relaxed);
+    m_reserved.fetch_add(reserveCount, std::memory_order_relaxed);
+
     uint64_t counter = m_nonces[index].fetch_add(reserveCount, std::memory_order_relaxed);
     while (true) {
         if (mask < counter) {
@@ -44,7 +52,16 @@ bool xmrig::Nonce::next(uint8_t index, uint32_t *nonce, uint32_t reserveCount, u
         }
 
         if (mask - counter <= reserveCount - 1) {
-            pause(true);
+            m_exhausted.fetch_add(1, std::memory_order_relaxed);
+
+            // The co-scheduled job (index 2) stops alone, the primary partition keeps mining its own job.
+            if (index == 2) {
+                m_spent[index] = true;
+            }
+            else {
+                pause(true);
+            }
+
             if (mask - counter < reserveCount - 1) {
                 return false;
             }
@@ -65,6 +82,19 @@ bool xmrig::Nonce::next(uint8_t index, uint32_t *nonce, uint32_t reserveCount, u
 }
 
 
+double xmrig::Nonce::utilization(uint8_t index)
+{
+    const uint64_t mask = m_masks[index].load(std::memory_order_relaxed);
+    if (mask == 0) {
+        return 0.0;
+    }
+
+    const uint64_t counter = m_nonces[index].load(std::memory_order_relaxed);
+
+    return counter > mask ? 1.0 : static_cast<double>(counter) / (static_cast<double>(mask) + 1.0);
+}
+
+
 void xmrig::Nonce::stop()
 {
     pause(false);
@@ -72,6 +102,8 @@ void xmrig::Nonce::stop()
     for (auto &i : m_sequence) {
         i = 0;
     }
+
+    Parking::wake();
 }
 
 
@@ -80,4 +112,6 @@ void xmrig::Nonce::touch()
     for (auto &i : m_sequence) {
         i++;
     }
+
+    Parking::wake();
 }
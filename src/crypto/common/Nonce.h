@@ -20,6 +20,9 @@
 #define XMRIG_NONCE_H
 
 
+#include "base/tools/Parking.h"
+
+
 #include <atomic>
 
 
@@ -33,26 +36,38 @@ public:
         CPU,
         OPENCL,
         CUDA,
+        CPU_CO,
         MAX
     };
 
 
+    static inline bool isExhausted(uint8_t index)                       { return m_spent[index].load(std::memory_order_relaxed); }
     static inline bool isOutdated(Backend backend, uint64_t sequence)   { return m_sequence[backend].load(std::memory_order_relaxed) != sequence; }
     static inline bool isPaused()                                       { return m_paused.load(std::memory_order_relaxed); }
+    static inline uint64_t exhausted()                                  { return m_exhausted.load(std::memory_order_relaxed); }
+    static inline uint64_t reserved()                                   { return m_reserved.load(std::memory_order_relaxed); }
     static inline uint64_t sequence(Backend backend)                    { return m_sequence[backend].load(std::memory_order_relaxed); }
-    static inline void pause(bool paused)                               { m_paused = paused; }
-    static inline void reset(uint8_t index)                             { m_nonces[index] = 0; }
-    static inline void stop(Backend backend)                            { m_sequence[backend] = 0; }
-    static inline void touch(Backend backend)                           { m_sequence[backend]++; }
+    static inline uint64_t wasted()                                     { return m_wasted.load(std::memory_order_relaxed); }
+    static inline void pause(bool paused)                               { if (m_paused.exchange(paused) && !paused) { Parking::wake(); } }
+    static inline void reset(uint8_t index)                             { m_nonces[index] = 0; m_spent[index] = false; }
+    static inline void stop(Backend backend)                            { m_sequence[backend] = 0; Parking::wake(); }
+    static inline void touch(Backend backend)                           { m_sequence[backend]++; Parking::wake(); }
+    static inline void waste(uint64_t count)                            { m_wasted.fetch_add(count, std::memory_order_relaxed); }
 
     static bool next(uint8_t index, uint32_t *nonce, uint32_t reserveCount, uint64_t mask);
+    static double utilization(uint8_t index);
     static void stop();
     static void touch();
 
 private:
     static std::atomic<bool> m_paused;
+    static std::atomic<uint64_t> m_exhausted;
+    static std::atomic<uint64_t> m_masks[3];
+    static std::atomic<uint64_t> m_nonces[3];
+    static std::atomic<uint64_t> m_reserved;
     static std::atomic<uint64_t> m_sequence[MAX];
-    static std::atomic<uint64_t> m_nonces[2];
+    static std::atomic<bool> m_spent[3];
+    static std::atomic<uint64_t> m_wasted;
 };
 
 
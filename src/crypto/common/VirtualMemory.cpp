@@ -30,22 +30,85 @@
 #endif
 
 
+#include <atomic>
 #include <cinttypes>
 #include <mutex>
+#include <vector>
 
 
 namespace xmrig {
 
 
+constexpr size_t kJitChunk      = 64 * 1024;    // allocation unit inside a shared arena
+constexpr size_t kJitColorStep  = 59 * 64;      // odd number of cache lines, code of consecutive instances starts in different L2/L3 sets
+
+
+// One huge page of RWX memory shared by the code of several JIT compilers, so all threads use a few iTLB entries.
+struct JitArena
+{
+    uint8_t *memory;
+    uint64_t used;  // bitmap of kJitChunk chunks
+};
+
+
 size_t VirtualMemory::m_hugePageSize    = VirtualMemory::kDefaultHugePageSize;
 static IMemoryPool *pool                = nullptr;
 static std::mutex mutex;
+static std::atomic<size_t> jitColor{ 0 };
+static std::vector<JitArena> jitArenas;
+static VirtualMemory::JitStats jitTotal;
+
+
+static uint8_t *allocateJitChunks(size_t chunks)
+{
+    const size_t capacity = VirtualMemory::hugePageSize() / kJitChunk;
+    const uint64_t mask   = (chunks < 64 ? (1ULL << chunks) : 0ULL) - 1;
+
+    for (auto &arena : jitArenas) {
+        for (size_t i = 0; i + chunks <= capacity; ++i) {
+            if ((arena.used & (mask << i)) == 0) {
+                arena.used |= mask << i;
+
+                return arena.memory + i * kJitChunk;
+            }
+        }
+    }
+
+    auto memory = static_cast<uint8_t *>(VirtualMemory::allocateExecutableMemory(VirtualMemory::hugePageSize(), true));
+    if (!memory) {
+        return nullptr;
+    }
+
+    jitArenas.push_back({ memory, mask });
+
+    return memory;
+}
+
+
+static void freeJitChunks(uint8_t *memory, size_t size)
+{
+    for (auto it = jitArenas.begin(); it != jitArenas.end(); ++it) {
+        if (memory < it->memory || memory >= it->memory + VirtualMemory::hugePageSize()) {
+            continue;
+        }
+
+        const size_t chunks = size / kJitChunk;
+        it->used &= ~((((chunks < 64) ? (1ULL << chunks) : 0ULL) - 1) << ((memory - it->memory) / kJitChunk));
+
+        if (it->used == 0) {
+            VirtualMemory::freeLargePagesMemory(it->memory, VirtualMemory::hugePageSize());
+            jitArenas.erase(it);
+        }
+
+        return;
+    }
+}
 
 
 } // namespace xmrig
 
 
-xmrig::VirtualMemory::VirtualMemory(size_t size, bool hugePages, bool oneGbPages, bool usePool, uint32_t node, size_t alignSize) :
+xmrig::VirtualMemory::VirtualMemory(size_t size, bool hugePages, bool oneGbPages, bool usePool, uint32_t node, size_t alignSize, bool transparentHugePages) :
     m_size(alignToHugePageSize(size)),
     m_node(node),
     m_capacity(m_size)
@@ -74,16 +137,37 @@ xmrig::VirtualMemory::VirtualMemory(size_t size, bool hugePages, bool oneGbPages
         return;
     }
 
+    // Only for large long lived blocks (RandomX dataset and cache), other users keep the plain fallback.
+    if (hugePages && transparentHugePages && allocateTransparentHugePagesMemory(alignSize)) {
+        return;
+    }
+
     m_scratchpad = static_cast<uint8_t*>(_mm_malloc(m_size, alignSize));
 }
 
 
+xmrig::VirtualMemory::VirtualMemory(size_t size, uint32_t node) :
+    m_size(alignToHugePageSize(size)),
+    m_node(node),
+    m_capacity(m_size)
+{
+}
+
+
 xmrig::VirtualMemory::~VirtualMemory()
 {
     if (!m_scratchpad) {
         return;
     }
 
+#   ifdef XMRIG_OS_LINUX
+    if (m_flags.test(FLAG_SHARED)) {
+        freeSharedMemory();
+
+        return;
+    }
+#   endif
+
     if (m_flags.test(FLAG_EXTERNAL)) {
         std::lock_guard<std::mutex> lock(mutex);
         pool->release(m_node);
@@ -103,6 +187,110 @@ xmrig::HugePagesInfo xmrig::VirtualMemory::hugePages() const
 }
 
 
+// Code memory for a JIT compiler of any architecture: "size" bytes of code starting at a per-instance offset (cache color)
+// inside the first "colorSpan" bytes. With huge pages requested small regions share huge page arenas, arenas stay RWX,
+// so with W^X (XMRIG_SECURE_JIT) every region gets its own mapping.
+bool xmrig::VirtualMemory::allocateJitCode(JitCode &jit, size_t size, size_t colorSpan, bool hugePages)
+{
+    const size_t total = size + colorSpan;
+    jit                = {};
+
+#   if !defined(XMRIG_OS_APPLE) && !defined(XMRIG_SECURE_JIT)
+    const size_t chunks = (total + kJitChunk - 1) / kJitChunk;
+
+    if (hugePages && hugePageSize() % kJitChunk == 0 && hugePageSize() / kJitChunk <= 64 && chunks <= hugePageSize() / kJitChunk) {
+        std::lock_guard<std::mutex> lock(mutex);
+
+        jit.memory = allocateJitChunks(chunks);
+        jit.size   = chunks * kJitChunk;
+        jit.shared = jit.memory != nullptr;
+    }
+#   else
+    (void) hugePages;
+#   endif
+
+    if (!jit.memory) {
+        jit.memory = static_cast<uint8_t *>(allocateExecutableMemory(total, false));
+        jit.size   = total;
+    }
+
+    if (!jit.memory) {
+        jit = {};
+
+        return false;
+    }
+
+    const size_t color = jitColor.fetch_add(kJitColorStep);
+    jit.code           = jit.memory + (colorSpan ? color % colorSpan : 0);
+
+    std::lock_guard<std::mutex> lock(mutex);
+    jitTotal.regions++;
+    jitTotal.shared += jit.shared ? 1 : 0;
+    jitTotal.bytes  += jit.size;
+
+    return true;
+}
+
+
+// W^X toggle, making the code executable also synchronizes the instruction cache (ARM, RISCV fence.i via the kernel).
+bool xmrig::VirtualMemory::protectJitCode(const JitCode &jit, bool executable)
+{
+    if (!jit.memory) {
+        return false;
+    }
+
+    if (!jit.shared) {
+        return executable ? protectRX(jit.memory, jit.size) : protectRW(jit.memory, jit.size);
+    }
+
+#   if defined(XMRIG_ARM) || defined(XMRIG_RISCV)
+    if (executable) {
+        flushInstructionCache(jit.memory, jit.size);
+    }
+#   endif
+
+    return true;
+}
+
+
+xmrig::VirtualMemory::JitStats xmrig::VirtualMemory::jitStats()
+{
+    std::lock_guard<std::mutex> lock(mutex);
+
+    JitStats stats = jitTotal;
+    stats.arenas   = jitArenas.size();
+
+    return stats;
+}
+
+
+void xmrig::VirtualMemory::freeJitCode(JitCode &jit)
+{
+    if (!jit.memory) {
+        return;
+    }
+
+    jitColor.fetch_sub(kJitColorStep);
+
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        jitTotal.regions--;
+        jitTotal.shared -= jit.shared ? 1 : 0;
+        jitTotal.bytes  -= jit.size;
+
+        if (jit.shared) {
+            freeJitChunks(jit.memory, jit.size);
+        }
+    }
+
+    if (!jit.shared) {
+        freeLargePagesMemory(jit.memory, jit.size);
+    }
+
+    jit = {};
+}
+
+
 #ifndef XMRIG_FEATURE_HWLOC
 uint32_t xmrig::VirtualMemory::bindToNUMANode(int64_t)
 {
@@ -42,11 +42,30 @@ public:
     constexpr static size_t kDefaultHugePageSize    = 2U * 1024U * 1024U;
     constexpr static size_t kOneGiB                 = 1024U * 1024U * 1024U;
 
-    VirtualMemory(size_t size, bool hugePages, bool oneGbPages, bool usePool, uint32_t node = 0, size_t alignSize = 64);
+    // Executable memory of one JIT compiler, see allocateJitCode().
+    struct JitCode
+    {
+        uint8_t *code   = nullptr;  // start of the code, shifted inside the memory by the cache color of this instance
+        uint8_t *memory = nullptr;  // private mapping or a slot of a shared arena
+        size_t size     = 0;        // bytes of memory
+        bool shared     = false;
+    };
+
+    struct JitStats
+    {
+        size_t arenas   = 0;
+        size_t bytes    = 0;
+        size_t regions  = 0;
+        size_t shared   = 0;
+    };
+
+    VirtualMemory(size_t size, bool hugePages, bool oneGbPages, bool usePool, uint32_t node = 0, size_t alignSize = 64, bool transparentHugePages = false);
     ~VirtualMemory();
 
     inline bool isHugePages() const                                 { return m_flags.test(FLAG_HUGEPAGES); }
     inline bool isOneGbPages() const                                { return m_flags.test(FLAG_1GB_PAGES); }
+    inline bool isTransparentHugePages() const                      { return m_flags.test(FLAG_TRANSPARENT); }
+    inline int fd() const                                           { return m_fd; }
     inline size_t size() const                                      { return m_size; }
     inline size_t capacity() const                                  { return m_capacity; }
     inline uint8_t *raw() const                                     { return m_scratchpad; }
@@ -56,20 +75,29 @@ public:
 
     HugePagesInfo hugePages() const;
 
+    static bool allocateJitCode(JitCode &jit, size_t size, size_t colorSpan, bool hugePages);
     static bool isHugepagesAvailable();
     static bool isOneGbPagesAvailable();
+    static bool protectJitCode(const JitCode &jit, bool executable);
     static bool protectRW(void *p, size_t size);
     static bool protectRWX(void *p, size_t size);
     static bool protectRX(void *p, size_t size);
+    static JitStats jitStats();
     static uint32_t bindToNUMANode(int64_t affinity);
     static void *allocateExecutableMemory(size_t size, bool hugePages);
     static void *allocateLargePagesMemory(size_t size);
     static void *allocateOneGbPagesMemory(size_t size);
     static void destroy();
     static void flushInstructionCache(void *p, size_t size);
+    static void freeJitCode(JitCode &jit);
     static void freeLargePagesMemory(void *p, size_t size);
     static void init(size_t poolSize, size_t hugePageSize);
 
+#   ifdef XMRIG_OS_LINUX
+    static VirtualMemory *createShared(size_t size, bool hugePages, uint32_t node);
+    static VirtualMemory *openShared(int fd, size_t size);
+#   endif
+
     static inline constexpr size_t align(size_t pos, size_t align = kDefaultHugePageSize)   { return ((pos - 1) / align + 1) * align; }
     static inline size_t alignToHugePageSize(size_t pos)                                    { return align(pos, hugePageSize()); }
     static inline size_t hugePageSize()                                                     { return m_hugePageSize; }
@@ -80,20 +108,31 @@ private:
         FLAG_1GB_PAGES,
         FLAG_LOCK,
         FLAG_EXTERNAL,
+        FLAG_TRANSPARENT,
+        FLAG_SHARED,
         FLAG_MAX
     };
 
+    VirtualMemory(size_t size, uint32_t node);
+
     static void osInit(size_t hugePageSize);
 
     bool allocateLargePagesMemory();
     bool allocateOneGbPagesMemory();
+    bool allocateTransparentHugePagesMemory(size_t alignSize);
     void freeLargePagesMemory();
 
+#   ifdef XMRIG_OS_LINUX
+    bool mapShared(int fd, bool hugePages);
+    void freeSharedMemory();
+#   endif
+
     static size_t m_hugePageSize;
 
     const size_t m_size;
     const uint32_t m_node;
     size_t m_capacity;
+    int m_fd = -1;
     std::bitset<FLAG_MAX> m_flags;
     uint8_t *m_scratchpad = nullptr;
 };
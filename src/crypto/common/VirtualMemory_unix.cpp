@@ -22,6 +22,7 @@
 #include "crypto/common/portable/mm_malloc.h"
 
 
+#include <algorithm>
 #include <cmath>
 #include <cstdlib>
 #include <fstream>
@@ -45,6 +46,22 @@
 
 #ifdef XMRIG_OS_LINUX
 #   include "crypto/common/LinuxMemory.h"
+#   include <sys/stat.h>
+#   include <sys/syscall.h>
+#   include <sys/vfs.h>
+#   include <unistd.h>
+
+#   ifndef MFD_CLOEXEC
+#       define MFD_CLOEXEC      0x0001U
+#   endif
+
+#   ifndef MFD_HUGETLB
+#       define MFD_HUGETLB      0x0004U
+#   endif
+
+#   ifndef HUGETLBFS_MAGIC
+#       define HUGETLBFS_MAGIC  0x958458f6
+#   endif
 #endif
 
 
@@ -82,6 +99,57 @@ static inline int hugePagesFlag(size_t size)
 #endif
 
 
+#ifdef XMRIG_OS_LINUX
+// Memory backed by a memfd, another process can map the same pages through the descriptor (RandomX live upgrade).
+xmrig::VirtualMemory *xmrig::VirtualMemory::createShared(size_t size, bool hugePages, uint32_t node)
+{
+    auto memory = new VirtualMemory(size, node);
+
+    for (const bool huge : { true, false }) {
+        if (huge && !hugePages) {
+            continue;
+        }
+
+        if (huge) {
+            LinuxMemory::reserve(memory->m_size, node, hugePageSize());
+        }
+
+        const int fd = static_cast<int>(syscall(__NR_memfd_create, "xmrig-rx-dataset", MFD_CLOEXEC | (huge ? MFD_HUGETLB : 0U)));
+        if (fd < 0) {
+            continue;
+        }
+
+        if (ftruncate(fd, static_cast<off_t>(memory->m_size)) == 0 && memory->mapShared(fd, huge)) {
+            return memory;
+        }
+
+        close(fd);
+    }
+
+    delete memory;
+
+    return nullptr;
+}
+
+
+xmrig::VirtualMemory *xmrig::VirtualMemory::openShared(int fd, size_t size)
+{
+    auto memory = new VirtualMemory(size, 0);
+
+    struct stat st{};
+    struct statfs fs{};
+
+    if (fstat(fd, &st) == 0 && static_cast<size_t>(st.st_size) >= memory->m_size && fstatfs(fd, &fs) == 0 && memory->mapShared(fd, fs.f_type == HUGETLBFS_MAGIC)) {
+        return memory;
+    }
+
+    delete memory;
+
+    return nullptr;
+}
+#endif
+
+
 bool xmrig::VirtualMemory::isHugepagesAvailable()
 {
 #   ifdef XMRIG_OS_LINUX
@@ -131,7 +199,7 @@ bool xmrig::VirtualMemory::protectRX(void *p, size_t size)
     result = (mprotect(p, size, PROT_READ | PROT_EXEC) == 0);
 #   endif
 
-#   if defined(XMRIG_ARM)
+#   if defined(XMRIG_ARM) || defined(XMRIG_RISCV)
     flushInstructionCache(p, size);
 #   endif
 
@@ -161,8 +229,36 @@ void *xmrig::VirtualMemory::allocateExecutableMemory(size_t size, bool hugePages
 
     void *mem = nullptr;
 
-    if (hugePages) {
-        mem = mmap(0, align(size), PROT_READ | PROT_WRITE | SECURE_PROT_EXEC, MAP_PRIVATE | MAP_ANONYMOUS | MAP_POPULATE | hugePagesFlag(hugePageSize()), -1, 0);
+    if (hugePages && size % hugePageSize() == 0) {
+        mem = mmap(0, size, PROT_READ | PROT_WRITE | SECURE_PROT_EXEC, MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB | MAP_POPULATE | hugePagesFlag(hugePageSize()), -1, 0);
+
+#       if defined(XMRIG_OS_LINUX) && defined(MADV_HUGEPAGE)
+        // No reserved huge pages, map an aligned range and ask for a transparent huge page instead.
+        if (mem == MAP_FAILED) {
+            mem = mmap(0, size + hugePageSize(), PROT_READ | PROT_WRITE | SECURE_PROT_EXEC, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+
+            if (mem != MAP_FAILED) {
+                auto base           = static_cast<uint8_t *>(mem);
+                auto aligned        = reinterpret_cast<uint8_t *>(align(reinterpret_cast<uintptr_t>(base), hugePageSize()));
+                const size_t tail   = static_cast<size_t>(base + size + hugePageSize() - (aligned + size));
+
+                if (aligned > base) {
+                    munmap(base, static_cast<size_t>(aligned - base));
+                }
+
+                if (tail) {
+                    munmap(aligned + size, tail);
+                }
+
+                madvise(aligned, size, MADV_HUGEPAGE);
+                mem = aligned;
+            }
+        }
+#       endif
+
+        if (mem == MAP_FAILED) {
+            mem = nullptr;
+        }
     }
 
     if (!mem) {
@@ -273,6 +369,28 @@ bool xmrig::VirtualMemory::allocateOneGbPagesMemory()
 }
 
 
+bool xmrig::VirtualMemory::allocateTransparentHugePagesMemory(size_t alignSize)
+{
+#   if defined(XMRIG_OS_LINUX) && defined(MADV_HUGEPAGE)
+    m_scratchpad = static_cast<uint8_t*>(_mm_malloc(m_size, std::max(alignSize, hugePageSize())));
+    if (!m_scratchpad) {
+        return false;
+    }
+
+    // Best effort, the kernel may still back the range with regular pages (THP disabled or fragmented memory).
+    if (madvise(m_scratchpad, m_size, MADV_HUGEPAGE) == 0) {
+        m_flags.set(FLAG_TRANSPARENT, true);
+    }
+
+    return true;
+#   else
+    (void) alignSize;
+
+    return false;
+#   endif
+}
+
+
 void xmrig::VirtualMemory::freeLargePagesMemory()
 {
     if (m_flags.test(FLAG_LOCK)) {
@@ -281,3 +399,37 @@ void xmrig::VirtualMemory::freeLargePagesMemory()
 
     freeLargePagesMemory(m_scratchpad, m_size);
 }
+
+
+#ifdef XMRIG_OS_LINUX
+bool xmrig::VirtualMemory::mapShared(int fd, bool hugePages)
+{
+    void *mem = mmap(nullptr, m_size, PROT_READ | PROT_WRITE, MAP_SHARED | (hugePages ? MAP_POPULATE : 0), fd, 0);
+    if (mem == MAP_FAILED) {
+        return false;
+    }
+
+    m_fd         = fd;
+    m_scratchpad = static_cast<uint8_t*>(mem);
+
+    m_flags.set(FLAG_SHARED, true);
+    m_flags.set(FLAG_HUGEPAGES, hugePages);
+
+    madvise(m_scratchpad, m_size, MADV_RANDOM | MADV_WILLNEED);
+
+    if (hugePages && mlock(m_scratchpad, m_size) == 0) {
+        m_flags.set(FLAG_LOCK, true);
+    }
+
+    return true;
+}
+
+
+void xmrig::VirtualMemory::freeSharedMemory()
+{
+    freeLargePagesMemory();
+
+    close(m_fd);
+    m_fd = -1;
+}
+#endif
@@ -0,0 +1,63 @@
+/* XMRig
+ * Copyright (c) 2018-2024 SChernykh   <https://github.com/SChernykh>
+ * Copyright (c) 2016-2024 XMRig       <https://github.com/xmrig>, <support@xmrig.com>
+ *
+ *   This program is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef XMRIG_GR_CORE_X4_H
+#define XMRIG_GR_CORE_X4_H
+
+
+#include <cstddef>
+#include <cstdint>
+
+
+namespace xmrig
+{
+
+
+namespace ghostrider
+{
+
+
+// Hashes 4 messages of the same size at once: message i is read from data + i * size, its 64-byte hash is written to output + i * 64.
+// Only the message sizes used by GhostRider (64 and 80 bytes) are supported.
+using core_hash_x4_func = void (*)(const uint8_t* data, size_t size, uint8_t* output);
+
+#ifdef XMRIG_FEATURE_AVX2
+void blake512_x4_avx2(const uint8_t* data, size_t size, uint8_t* output);
+void bmw512_x4_avx2(const uint8_t* data, size_t size, uint8_t* output);
+void keccak512_x4_avx2(const uint8_t* data, size_t size, uint8_t* output);
+void skein512_x4_avx2(const uint8_t* data, size_t size, uint8_t* output);
+void cubehash512_x4_avx2(const uint8_t* data, size_t size, uint8_t* output);
+void shabal512_x4_avx2(const uint8_t* data, size_t size, uint8_t* output);
+#endif
+
+#if defined(XMRIG_ARM) && !defined(_MSC_VER)
+void blake512_x4_vec(const uint8_t* data, size_t size, uint8_t* output);
+void bmw512_x4_vec(const uint8_t* data, size_t size, uint8_t* output);
+void keccak512_x4_vec(const uint8_t* data, size_t size, uint8_t* output);
+void skein512_x4_vec(const uint8_t* data, size_t size, uint8_t* output);
+void cubehash512_x4_vec(const uint8_t* data, size_t size, uint8_t* output);
+void shabal512_x4_vec(const uint8_t* data, size_t size, uint8_t* output);
+#endif
+
+
+} // namespace ghostrider
+
+
+} // namespace xmrig
+
+#endif // XMRIG_GR_CORE_X4_H
@@ -0,0 +1,136 @@
+/* XMRig
+ * Copyright (c) 2018-2024 SChernykh   <https://github.com/SChernykh>
+ * Copyright (c) 2016-2024 XMRig       <https://github.com/xmrig>, <support@xmrig.com>
+ *
+ *   This program is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "core_x4.h"
+#include "core_x4_impl.h"
+
+#include <immintrin.h>
+
+
+/*
+    AVX2 instantiation of the 4-way core hashes: 64-bit words in ymm lanes, 32-bit words in xmm lanes.
+*/
+
+
+namespace xmrig
+{
+
+
+namespace ghostrider
+{
+
+
+namespace
+{
+
+
+struct Avx2
+{
+    using u64 = __m256i;
+    using u32 = __m128i;
+
+    static inline u64 make(uint64_t a, uint64_t b, uint64_t c, uint64_t d)    { return _mm256_set_epi64x(static_cast<int64_t>(d), static_cast<int64_t>(c), static_cast<int64_t>(b), static_cast<int64_t>(a)); }
+    static inline u32 make(uint32_t a, uint32_t b, uint32_t c, uint32_t d)    { return _mm_set_epi32(static_cast<int>(d), static_cast<int>(c), static_cast<int>(b), static_cast<int>(a)); }
+    static inline u64 set1(uint64_t x)                                        { return _mm256_set1_epi64x(static_cast<int64_t>(x)); }
+    static inline u32 set1_32(uint32_t x)                                     { return _mm_set1_epi32(static_cast<int>(x)); }
+    static inline u64 zero()                                                  { return _mm256_setzero_si256(); }
+    static inline u32 zero32()                                                { return _mm_setzero_si128(); }
+
+    static inline uint64_t get(u64 x, size_t lane)
+    {
+        alignas(32) uint64_t w[4];
+        _mm256_store_si256(reinterpret_cast<__m256i*>(w), x);
+        return w[lane];
+    }
+
+    static inline uint32_t get(u32 x, size_t lane)
+    {
+        alignas(16) uint32_t w[4];
+        _mm_store_si128(reinterpret_cast<__m128i*>(w), x);
+        return w[lane];
+    }
+
+    static inline u64 add(u64 a, u64 b)      { return _mm256_add_epi64(a, b); }
+    static inline u32 add(u32 a, u32 b)      { return _mm_add_epi32(a, b); }
+    static inline u64 sub(u64 a, u64 b)      { return _mm256_sub_epi64(a, b); }
+    static inline u32 sub(u32 a, u32 b)      { return _mm_sub_epi32(a, b); }
+    static inline u64 xor_(u64 a, u64 b)     { return _mm256_xor_si256(a, b); }
+    static inline u32 xor_(u32 a, u32 b)     { return _mm_xor_si128(a, b); }
+    static inline u64 or_(u64 a, u64 b)      { return _mm256_or_si256(a, b); }
+    static inline u32 or_(u32 a, u32 b)      { return _mm_or_si128(a, b); }
+    static inline u64 andnot(u64 a, u64 b)   { return _mm256_andnot_si256(a, b); }
+    static inline u32 andnot(u32 a, u32 b)   { return _mm_andnot_si128(a, b); }
+    static inline u32 not_(u32 a)            { return _mm_xor_si128(a, _mm_set1_epi32(-1)); }
+
+    template<int N> static inline u64 shl(u64 x)    { return _mm256_slli_epi64(x, N); }
+    template<int N> static inline u32 shl(u32 x)    { return _mm_slli_epi32(x, N); }
+    template<int N> static inline u64 shr(u64 x)    { return _mm256_srli_epi64(x, N); }
+    template<int N> static inline u32 shr(u32 x)    { return _mm_srli_epi32(x, N); }
+    template<int N> static inline u64 rotl(u64 x)   { return _mm256_or_si256(_mm256_slli_epi64(x, N), _mm256_srli_epi64(x, 64 - N)); }
+    template<int N> static inline u32 rotl(u32 x)   { return _mm_or_si128(_mm_slli_epi32(x, N), _mm_srli_epi32(x, 32 - N)); }
+
+    static inline u64 rotl(u64 x, int n)
+    {
+        return n ? _mm256_or_si256(_mm256_sll_epi64(x, _mm_cvtsi32_si128(n)), _mm256_srl_epi64(x, _mm_cvtsi32_si128(64 - n))) : x;
+    }
+
+    static inline u64 bswap(u64 x)
+    {
+        const __m256i mask = _mm256_set_epi8(
+            8, 9, 10, 11, 12, 13, 14, 15, 0, 1, 2, 3, 4, 5, 6, 7,
+            8, 9, 10, 11, 12, 13, 14, 15, 0, 1, 2, 3, 4, 5, 6, 7
+        );
+        return _mm256_shuffle_epi8(x, mask);
+    }
+};
+
+
+// Byte granular rotations are a single shuffle
+template<>
+inline __m256i Avx2::rotl<32>(__m256i x)
+{
+    return _mm256_shuffle_epi32(x, _MM_SHUFFLE(2, 3, 0, 1));
+}
+
+
+template<>
+inline __m256i Avx2::rotl<48>(__m256i x)
+{
+    const __m256i mask = _mm256_set_epi8(
+        9, 8, 15, 14, 13, 12, 11, 10, 1, 0, 7, 6, 5, 4, 3, 2,
+        9, 8, 15, 14, 13, 12, 11, 10, 1, 0, 7, 6, 5, 4, 3, 2
+    );
+    return _mm256_shuffle_epi8(x, mask);
+}
+
+
+} // namespace
+
+
+void blake512_x4_avx2(const uint8_t* data, size_t size, uint8_t* output)      { x4::blake512<Avx2>(data, size, output); }
+void bmw512_x4_avx2(const uint8_t* data, size_t size, uint8_t* output)        { x4::bmw512<Avx2>(data, size, output); }
+void keccak512_x4_avx2(const uint8_t* data, size_t size, uint8_t* output)     { x4::keccak512<Avx2>(data, size, output); }
+void skein512_x4_avx2(const uint8_t* data, size_t size, uint8_t* output)      { x4::skein512<Avx2>(data, size, output); }
+void cubehash512_x4_avx2(const uint8_t* data, size_t size, uint8_t* output)   { x4::cubehash512<Avx2>(data, size, output); }
+void shabal512_x4_avx2(const uint8_t* data, size_t size, uint8_t* output)     { x4::shabal512<Avx2>(data, size, output); }
+
+
+} // namespace ghostrider
+
+
+} // namespace xmrig
@@ -0,0 +1,809 @@
+/* XMRig
+ * Copyright (c) 2018-2024 SChernykh   <https://github.com/SChernykh>
+ * Copyright (c) 2016-2024 XMRig       <https://github.com/xmrig>, <support@xmrig.com>
+ *
+ *   This program is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef XMRIG_GR_CORE_X4_IMPL_H
+#define XMRIG_GR_CORE_X4_IMPL_H
+
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <utility>
+
+
+/*
+    4-way versions of the GhostRider core hashes, written once against a small set of vector operations and
+    instantiated for each instruction set (core_x4_avx2.cpp, core_x4_vec.cpp). Only included by these files.
+
+    V::u64 holds the same 64-bit state word of 4 messages, V::u32 the same 32-bit state word of 4 messages, so
+    the code is a direct transcription of the scalar algorithms. V provides:
+
+        make(a, b, c, d), add(), sub(), xor_(), or_(), andnot(a, b) = ~a & b, shl<N>(), shr<N>(), rotl<N>() and
+        get(x, lane) for both types, set1(), zero(), rotl(x, n) and bswap() for u64, set1_32(), zero32() and not_()
+        for u32.
+
+    Message sizes are fixed to 64 or 80 bytes (GhostRider core hash inputs), padding is computed up front instead
+    of going through a buffer. The output is bit-exact with the sph_* implementations.
+*/
+
+
+namespace xmrig
+{
+
+
+namespace ghostrider
+{
+
+
+namespace x4
+{
+
+
+static inline uint64_t read64(const uint8_t* p)
+{
+    uint64_t x;
+    memcpy(&x, p, sizeof(x));
+    return x;
+}
+
+
+static inline uint32_t read32(const uint8_t* p)
+{
+    uint32_t x;
+    memcpy(&x, p, sizeof(x));
+    return x;
+}
+
+
+template<typename V>
+static inline typename V::u64 load64(const uint8_t* data, size_t size, size_t word)
+{
+    const uint8_t* p = data + word * 8;
+    return V::make(read64(p), read64(p + size), read64(p + size * 2), read64(p + size * 3));
+}
+
+
+template<typename V>
+static inline typename V::u32 load32(const uint8_t* data, size_t size, size_t word)
+{
+    const uint8_t* p = data + word * 4;
+    return V::make(read32(p), read32(p + size), read32(p + size * 2), read32(p + size * 3));
+}
+
+
+template<typename V>
+static inline void store64(uint8_t* output, const typename V::u64* h)
+{
+    for (size_t lane = 0; lane < 4; ++lane) {
+        for (size_t i = 0; i < 8; ++i) {
+            const uint64_t w = V::get(h[i], lane);
+            memcpy(output + lane * 64 + i * 8, &w, 8);
+        }
+    }
+}
+
+
+template<typename V>
+static inline void store32(uint8_t* output, const typename V::u32* h)
+{
+    for (size_t lane = 0; lane < 4; ++lane) {
+        for (size_t i = 0; i < 16; ++i) {
+            const uint32_t w = V::get(h[i], lane);
+            memcpy(output + lane * 64 + i * 4, &w, 4);
+        }
+    }
+}
+
+
+// BLAKE-512 (16 rounds, one block, no salt)
+
+static const uint64_t blake512_iv[8] = {
+    0x6A09E667F3BCC908ULL, 0xBB67AE8584CAA73BULL, 0x3C6EF372FE94F82BULL, 0xA54FF53A5F1D36F1ULL,
+    0x510E527FADE682D1ULL, 0x9B05688C2B3E6C1FULL, 0x1F83D9ABFB41BD6BULL, 0x5BE0CD19137E2179ULL
+};
+
+static const uint64_t blake512_c[16] = {
+    0x243F6A8885A308D3ULL, 0x13198A2E03707344ULL, 0xA4093822299F31D0ULL, 0x082EFA98EC4E6C89ULL,
+    0x452821E638D01377ULL, 0xBE5466CF34E90C6CULL, 0xC0AC29B7C97C50DDULL, 0x3F84D5B5B5470917ULL,
+    0x9216D5D98979FB1BULL, 0xD1310BA698DFB5ACULL, 0x2FFD72DBD01ADFB7ULL, 0xB8E1AFED6A267E96ULL,
+    0xBA7C9045F12C7F99ULL, 0x24A19947B3916CF7ULL, 0x0801F2E2858EFC16ULL, 0x636920D871574E69ULL
+};
+
+static const uint8_t blake512_sigma[10][16] = {
+    {  0,  1,  2,  3,  4,  5,  6,  7,  8,  9, 10, 11, 12, 13, 14, 15 },
+    { 14, 10,  4,  8,  9, 15, 13,  6,  1, 12,  0,  2, 11,  7,  5,  3 },
+    { 11,  8, 12,  0,  5,  2, 15, 13, 10, 14,  3,  6,  7,  1,  9,  4 },
+    {  7,  9,  3,  1, 13, 12, 11, 14,  2,  6,  5, 10,  4,  0, 15,  8 },
+    {  9,  0,  5,  7,  2,  4, 10, 15, 14,  1, 11, 12,  6,  8,  3, 13 },
+    {  2, 12,  6, 10,  0, 11,  8,  3,  4, 13,  7,  5, 15, 14,  1,  9 },
+    { 12,  5,  1, 15, 14, 13,  4, 10,  0,  7,  6,  3,  9,  2,  8, 11 },
+    { 13, 11,  7, 14, 12,  1,  3,  9,  5,  0, 15,  4,  8,  6,  2, 10 },
+    {  6, 15, 14,  9, 11,  3,  0,  8, 12,  2, 13,  7,  1,  4, 10,  5 },
+    { 10,  2,  8,  4,  7,  6,  1,  5, 15, 11,  9, 14,  3, 12, 13,  0 }
+};
+
+
+template<typename V>
+static inline void blake512_g(typename V::u64& a, typename V::u64& b, typename V::u64& c, typename V::u64& d, const typename V::u64* m, const uint8_t* s, size_t i)
+{
+    const size_t x = s[i * 2];
+    const size_t y = s[i * 2 + 1];
+
+    a = V::add(V::add(a, b), V::xor_(m[x], V::set1(blake512_c[y])));
+    d = V::template rotl<32>(V::xor_(d, a));
+    c = V::add(c, d);
+    b = V::template rotl<39>(V::xor_(b, c));
+    a = V::add(V::add(a, b), V::xor_(m[y], V::set1(blake512_c[x])));
+    d = V::template rotl<48>(V::xor_(d, a));
+    c = V::add(c, d);
+    b = V::template rotl<53>(V::xor_(b, c));
+}
+
+
+template<typename V>
+void blake512(const uint8_t* data, size_t size, uint8_t* output)
+{
+    using u64 = typename V::u64;
+
+    const size_t words = size / 8;
+
+    u64 m[16];
+    for (size_t i = 0; i < 16; ++i) {
+        m[i] = (i < words) ? V::bswap(load64<V>(data, size, i)) : V::zero();
+    }
+
+    m[words] = V::set1(0x8000000000000000ULL);
+    m[13]    = V::or_(m[13], V::set1(1ULL));
+    m[15]    = V::set1(static_cast<uint64_t>(size * 8));
+
+    u64 v[16];
+    for (size_t i = 0; i < 8; ++i) {
+        v[i] = V::set1(blake512_iv[i]);
+    }
+
+    for (size_t i = 0; i < 8; ++i) {
+        v[i + 8] = V::set1(blake512_c[i]);
+    }
+
+    v[12] = V::xor_(v[12], V::set1(static_cast<uint64_t>(size * 8)));
+    v[13] = V::xor_(v[13], V::set1(static_cast<uint64_t>(size * 8)));
+
+    for (size_t r = 0; r < 16; ++r) {
+        const uint8_t* s = blake512_sigma[r % 10];
+
+        blake512_g<V>(v[0], v[4], v[ 8], v[12], m, s, 0);
+        blake512_g<V>(v[1], v[5], v[ 9], v[13], m, s, 1);
+        blake512_g<V>(v[2], v[6], v[10], v[14], m, s, 2);
+        blake512_g<V>(v[3], v[7], v[11], v[15], m, s, 3);
+        blake512_g<V>(v[0], v[5], v[10], v[15], m, s, 4);
+        blake512_g<V>(v[1], v[6], v[11], v[12], m, s, 5);
+        blake512_g<V>(v[2], v[7], v[ 8], v[13], m, s, 6);
+        blake512_g<V>(v[3], v[4], v[ 9], v[14], m, s, 7);
+    }
+
+    u64 h[8];
+    for (size_t i = 0; i < 8; ++i) {
+        h[i] = V::bswap(V::xor_(V::set1(blake512_iv[i]), V::xor_(v[i], v[i + 8])));
+    }
+
+    store64<V>(output, h);
+}
+
+
+// BMW-512 (one message block, then the final compression)
+
+static const uint64_t bmw512_iv[16] = {
+    0x8081828384858687ULL, 0x88898A8B8C8D8E8FULL, 0x9091929394959697ULL, 0x98999A9B9C9D9E9FULL,
+    0xA0A1A2A3A4A5A6A7ULL, 0xA8A9AAABACADAEAFULL, 0xB0B1B2B3B4B5B6B7ULL, 0xB8B9BABBBCBDBEBFULL,
+    0xC0C1C2C3C4C5C6C7ULL, 0xC8C9CACBCCCDCECFULL, 0xD0D1D2D3D4D5D6D7ULL, 0xD8D9DADBDCDDDEDFULL,
+    0xE0E1E2E3E4E5E6E7ULL, 0xE8E9EAEBECEDEEEFULL, 0xF0F1F2F3F4F5F6F7ULL, 0xF8F9FAFBFCFDFEFFULL
+};
+
+// W[i] = sum of +/- (M[j] ^ H[j]), an entry is j + 1 with the sign of the term
+static const int8_t bmw512_w[16][5] = {
+    {  6,  -8,  11,  14,  15 },
+    {  7,  -9,  12,  15, -16 },
+    {  1,   8,  10, -13,  16 },
+    {  1,  -2,   9, -11,  14 },
+    {  2,   3,  10, -12, -15 },
+    {  4,  -3,  11, -13,  16 },
+    {  5,  -1,  -4, -12,  14 },
+    {  2,  -5,  -6, -13, -15 },
+    {  3,  -6,  -7,  14, -16 },
+    {  1,  -4,   7,  -8,  15 },
+    {  9,  -2,  -5,  -8,  16 },
+    {  9,  -1,  -3,  -6,  10 },
+    {  2,   4,  -7, -10,  11 },
+    {  3,   5,   8,  11,  12 },
+    {  4,  -6,   9, -12, -13 },
+    { 13,  -5,  -7, -10,  14 }
+};
+
+
+template<typename V>
+static inline typename V::u64 bmw512_s(const typename V::u64& x, size_t i)
+{
+    switch (i) {
+    case 0:
+        return V::xor_(V::xor_(V::template shr<1>(x), V::template shl<3>(x)), V::xor_(V::template rotl<4>(x), V::template rotl<37>(x)));
+
+    case 1:
+        return V::xor_(V::xor_(V::template shr<1>(x), V::template shl<2>(x)), V::xor_(V::template rotl<13>(x), V::template rotl<43>(x)));
+
+    case 2:
+        return V::xor_(V::xor_(V::template shr<2>(x), V::template shl<1>(x)), V::xor_(V::template rotl<19>(x), V::template rotl<53>(x)));
+
+    case 3:
+        return V::xor_(V::xor_(V::template shr<2>(x), V::template shl<2>(x)), V::xor_(V::template rotl<28>(x), V::template rotl<59>(x)));
+
+    case 4:
+        return V::xor_(V::template shr<1>(x), x);
+
+    default:
+        return V::xor_(V::template shr<2>(x), x);
+    }
+}
+
+
+template<typename V>
+static void bmw512_compress(const typename V::u64* m, const typename V::u64* h, typename V::u64* dh)
+{
+    using u64 = typename V::u64;
+
+    u64 q[32];
+
+    for (size_t i = 0; i < 16; ++i) {
+        const int8_t* t = bmw512_w[i];
+        u64 w = V::xor_(m[t[0] - 1], h[t[0] - 1]);
+
+        for (size_t k = 1; k < 5; ++k) {
+            const size_t j = static_cast<size_t>((t[k] < 0 ? -t[k] : t[k]) - 1);
+            w = (t[k] < 0) ? V::sub(w, V::xor_(m[j], h[j])) : V::add(w, V::xor_(m[j], h[j]));
+        }
+
+        q[i] = V::add(bmw512_s<V>(w, i % 5), h[(i + 1) % 16]);
+    }
+
+    static const int rb[7] = { 5, 11, 27, 32, 37, 43, 53 };
+
+    for (size_t i = 16; i < 32; ++i) {
+        const size_t j = i - 16;
+
+        u64 e = V::add(V::rotl(m[j], static_cast<int>(j + 1)), V::rotl(m[(j + 3) % 16], static_cast<int>((j + 3) % 16 + 1)));
+        e     = V::sub(e, V::rotl(m[(j + 10) % 16], static_cast<int>((j + 10) % 16 + 1)));
+        e     = V::xor_(V::add(e, V::set1(static_cast<uint64_t>(i) * 0x0555555555555555ULL)), h[(j + 7) % 16]);
+
+        if (i < 18) {
+            for (size_t k = 0; k < 16; ++k) {
+                e = V::add(e, bmw512_s<V>(q[j + k], (k + 1) % 4));
+            }
+        }
+        else {
+            for (size_t k = 0; k < 14; k += 2) {
+                e = V::add(e, V::add(q[j + k], V::rotl(q[j + k + 1], rb[k / 2])));
+            }
+
+            e = V::add(e, V::add(bmw512_s<V>(q[j + 14], 4), bmw512_s<V>(q[j + 15], 5)));
+        }
+
+        q[i] = e;
+    }
+
+    u64 xl = q[16];
+    for (size_t i = 17; i < 24; ++i) {
+        xl = V::xor_(xl, q[i]);
+    }
+
+    u64 xh = xl;
+    for (size_t i = 24; i < 32; ++i) {
+        xh = V::xor_(xh, q[i]);
+    }
+
+    dh[0] = V::add(V::xor_(V::xor_(V::template shl<5>(xh),  V::template shr<5>(q[16])), m[0]), V::xor_(V::xor_(xl, q[24]), q[0]));
+    dh[1] = V::add(V::xor_(V::xor_(V::template shr<7>(xh),  V::template shl<8>(q[17])), m[1]), V::xor_(V::xor_(xl, q[25]), q[1]));
+    dh[2] = V::add(V::xor_(V::xor_(V::template shr<5>(xh),  V::template shl<5>(q[18])), m[2]), V::xor_(V::xor_(xl, q[26]), q[2]));
+    dh[3] = V::add(V::xor_(V::xor_(V::template shr<1>(xh),  V::template shl<5>(q[19])), m[3]), V::xor_(V::xor_(xl, q[27]), q[3]));
+    dh[4] = V::add(V::xor_(V::xor_(V::template shr<3>(xh),  q[20]),                     m[4]), V::xor_(V::xor_(xl, q[28]), q[4]));
+    dh[5] = V::add(V::xor_(V::xor_(V::template shl<6>(xh),  V::template shr<6>(q[21])), m[5]), V::xor_(V::xor_(xl, q[29]), q[5]));
+    dh[6] = V::add(V::xor_(V::xor_(V::template shr<4>(xh),  V::template shl<6>(q[22])), m[6]), V::xor_(V::xor_(xl, q[30]), q[6]));
+    dh[7] = V::add(V::xor_(V::xor_(V::template shr<11>(xh), V::template shl<2>(q[23])), m[7]), V::xor_(V::xor_(xl, q[31]), q[7]));
+
+    dh[ 8] = V::add(V::add(V::template rotl< 9>(dh[4]), V::xor_(V::xor_(xh, q[24]), m[ 8])), V::xor_(V::xor_(V::template shl<8>(xl), q[23]), q[ 8]));
+    dh[ 9] = V::add(V::add(V::template rotl<10>(dh[5]), V::xor_(V::xor_(xh, q[25]), m[ 9])), V::xor_(V::xor_(V::template shr<6>(xl), q[16]), q[ 9]));
+    dh[10] = V::add(V::add(V::template rotl<11>(dh[6]), V::xor_(V::xor_(xh, q[26]), m[10])), V::xor_(V::xor_(V::template shl<6>(xl), q[17]), q[10]));
+    dh[11] = V::add(V::add(V::template rotl<12>(dh[7]), V::xor_(V::xor_(xh, q[27]), m[11])), V::xor_(V::xor_(V::template shl<4>(xl), q[18]), q[11]));
+    dh[12] = V::add(V::add(V::template rotl<13>(dh[0]), V::xor_(V::xor_(xh, q[28]), m[12])), V::xor_(V::xor_(V::template shr<3>(xl), q[19]), q[12]));
+    dh[13] = V::add(V::add(V::template rotl<14>(dh[1]), V::xor_(V::xor_(xh, q[29]), m[13])), V::xor_(V::xor_(V::template shr<4>(xl), q[20]), q[13]));
+    dh[14] = V::add(V::add(V::template rotl<15>(dh[2]), V::xor_(V::xor_(xh, q[30]), m[14])), V::xor_(V::xor_(V::template shr<7>(xl), q[21]), q[14]));
+    dh[15] = V::add(V::add(V::template rotl<16>(dh[3]), V::xor_(V::xor_(xh, q[31]), m[15])), V::xor_(V::xor_(V::template shr<2>(xl), q[22]), q[15]));
+}
+
+
+template<typename V>
+void bmw512(const uint8_t* data, size_t size, uint8_t* output)
+{
+    using u64 = typename V::u64;
+
+    const size_t words = size / 8;
+
+    u64 m[16];
+    for (size_t i = 0; i < 16; ++i) {
+        m[i] = (i < words) ? load64<V>(data, size, i) : V::zero();
+    }
+
+    m[words] = V::set1(0x80ULL);
+    m[15]    = V::set1(static_cast<uint64_t>(size * 8));
+
+    u64 h[16];
+    for (size_t i = 0; i < 16; ++i) {
+        h[i] = V::set1(bmw512_iv[i]);
+    }
+
+    u64 h2[16];
+    bmw512_compress<V>(m, h, h2);
+
+    for (size_t i = 0; i < 16; ++i) {
+        h[i] = V::set1(0xAAAAAAAAAAAAAAA0ULL + i);
+    }
+
+    u64 h1[16];
+    bmw512_compress<V>(h2, h, h1);
+
+    store64<V>(output, h1 + 8);
+}
+
+
+// Keccak-512 (rate 72 bytes, 0x01 padding)
+
+static const uint64_t keccak_rc[24] = {
+    0x0000000000000001ULL, 0x0000000000008082ULL, 0x800000000000808AULL, 0x8000000080008000ULL,
+    0x000000000000808BULL, 0x0000000080000001ULL, 0x8000000080008081ULL, 0x8000000000008009ULL,
+    0x000000000000008AULL, 0x0000000000000088ULL, 0x0000000080008009ULL, 0x000000008000000AULL,
+    0x000000008000808BULL, 0x800000000000008BULL, 0x8000000000008089ULL, 0x8000000000008003ULL,
+    0x8000000000008002ULL, 0x8000000000000080ULL, 0x000000000000800AULL, 0x800000008000000AULL,
+    0x8000000080008081ULL, 0x8000000000008080ULL, 0x0000000080000001ULL, 0x8000000080008008ULL
+};
+
+static const int keccak_rho[25] = {
+     0,  1, 62, 28, 27,
+    36, 44,  6, 55, 20,
+     3, 10, 43, 25, 39,
+    41, 45, 15, 21,  8,
+    18,  2, 61, 56, 14
+};
+
+
+template<typename V>
+static void keccak_f1600(typename V::u64 (&a)[25])
+{
+    using u64 = typename V::u64;
+
+    for (size_t round = 0; round < 24; ++round) {
+        u64 c[5];
+        for (size_t x = 0; x < 5; ++x) {
+            c[x] = V::xor_(V::xor_(V::xor_(a[x], a[x + 5]), V::xor_(a[x + 10], a[x + 15])), a[x + 20]);
+        }
+
+        for (size_t x = 0; x < 5; ++x) {
+            const u64 d = V::xor_(c[(x + 4) % 5], V::template rotl<1>(c[(x + 1) % 5]));
+            for (size_t y = 0; y < 25; y += 5) {
+                a[x + y] = V::xor_(a[x + y], d);
+            }
+        }
+
+        u64 b[25];
+        for (size_t x = 0; x < 5; ++x) {
+            for (size_t y = 0; y < 5; ++y) {
+                b[y + 5 * ((2 * x + 3 * y) % 5)] = V::rotl(a[x + 5 * y], keccak_rho[x + 5 * y]);
+            }
+        }
+
+        for (size_t y = 0; y < 25; y += 5) {
+            for (size_t x = 0; x < 5; ++x) {
+                a[x + y] = V::xor_(b[x + y], V::andnot(b[(x + 1) % 5 + y], b[(x + 2) % 5 + y]));
+            }
+        }
+
+        a[0] = V::xor_(a[0], V::set1(keccak_rc[round]));
+    }
+}
+
+
+template<typename V>
+void keccak512(const uint8_t* data, size_t size, uint8_t* output)
+{
+    using u64 = typename V::u64;
+
+    constexpr size_t rate = 9;
+    const size_t words    = size / 8;
+
+    u64 a[25];
+    for (auto& x : a) {
+        x = V::zero();
+    }
+
+    size_t i = 0;
+    for (; i + rate <= words; i += rate) {
+        for (size_t j = 0; j < rate; ++j) {
+            a[j] = V::xor_(a[j], load64<V>(data, size, i + j));
+        }
+        keccak_f1600<V>(a);
+    }
+
+    for (size_t j = 0; i + j < words; ++j) {
+        a[j] = V::xor_(a[j], load64<V>(data, size, i + j));
+    }
+
+    a[words - i]  = V::xor_(a[words - i], V::set1(0x01ULL));
+    a[rate - 1]   = V::xor_(a[rate - 1], V::set1(0x8000000000000000ULL));
+    keccak_f1600<V>(a);
+
+    store64<V>(output, a);
+}
+
+
+// Skein-512-512 (Threefish-512, v1.3 rotation constants)
+
+static const uint64_t skein512_iv[8] = {
+    0x4903ADFF749C51CEULL, 0x0D95DE399746DF03ULL, 0x8FD1934127C79BCEULL, 0x9A255629FF352CB1ULL,
+    0x5DB62599DF6CA7B0ULL, 0xEABE394CA9D5C3F4ULL, 0x991112C71A75B523ULL, 0xAE18A40B660FCC33ULL
+};
+
+static constexpr uint64_t kSkeinFirst   = 1ULL << 62;
+static constexpr uint64_t kSkeinFinal   = 1ULL << 63;
+static constexpr uint64_t kSkeinTypeMsg = 48ULL << 56;
+static constexpr uint64_t kSkeinTypeOut = 63ULL << 56;
+
+
+#define SKEIN_MIX(a, b, r) \
+    x[a] = V::add(x[a], x[b]); \
+    x[b] = V::xor_(V::template rotl<r>(x[b]), x[a]);
+
+#define SKEIN_INJECT(s) \
+    for (size_t i = 0; i < 8; ++i) { \
+        x[i] = V::add(x[i], k[((s) + i) % 9]); \
+    } \
+    x[5] = V::add(x[5], V::set1(t[(s) % 3])); \
+    x[6] = V::add(x[6], V::set1(t[((s) + 1) % 3])); \
+    x[7] = V::add(x[7], V::set1(static_cast<uint64_t>(s)));
+
+
+// One UBI step: h = Threefish(h, tweak, m) ^ m
+template<typename V>
+static void skein512_ubi(typename V::u64 (&h)[8], const typename V::u64 (&m)[8], uint64_t t0, uint64_t t1)
+{
+    using u64 = typename V::u64;
+
+    const uint64_t t[3] = { t0, t1, t0 ^ t1 };
+
+    u64 k[9];
+    k[8] = V::set1(0x1BD11BDAA9FC1A22ULL);
+    for (size_t i = 0; i < 8; ++i) {
+        k[i] = h[i];
+        k[8] = V::xor_(k[8], h[i]);
+    }
+
+    u64 x[8];
+    for (size_t i = 0; i < 8; ++i) {
+        x[i] = m[i];
+    }
+
+    for (size_t s = 0; s < 18; s += 2) {
+        SKEIN_INJECT(s);
+        SKEIN_MIX(0, 1, 46); SKEIN_MIX(2, 3, 36); SKEIN_MIX(4, 5, 19); SKEIN_MIX(6, 7, 37);
+        SKEIN_MIX(2, 1, 33); SKEIN_MIX(4, 7, 27); SKEIN_MIX(6, 5, 14); SKEIN_MIX(0, 3, 42);
+        SKEIN_MIX(4, 1, 17); SKEIN_MIX(6, 3, 49); SKEIN_MIX(0, 5, 36); SKEIN_MIX(2, 7, 39);
+        SKEIN_MIX(6, 1, 44); SKEIN_MIX(0, 7,  9); SKEIN_MIX(2, 5, 54); SKEIN_MIX(4, 3, 56);
+
+        SKEIN_INJECT(s + 1);
+        SKEIN_MIX(0, 1, 39); SKEIN_MIX(2, 3, 30); SKEIN_MIX(4, 5, 34); SKEIN_MIX(6, 7, 24);
+        SKEIN_MIX(2, 1, 13); SKEIN_MIX(4, 7, 50); SKEIN_MIX(6, 5, 10); SKEIN_MIX(0, 3, 17);
+        SKEIN_MIX(4, 1, 25); SKEIN_MIX(6, 3, 29); SKEIN_MIX(0, 5, 39); SKEIN_MIX(2, 7, 43);
+        SKEIN_MIX(6, 1,  8); SKEIN_MIX(0, 7, 35); SKEIN_MIX(2, 5, 56); SKEIN_MIX(4, 3, 22);
+    }
+
+    SKEIN_INJECT(18);
+
+    for (size_t i = 0; i < 8; ++i) {
+        h[i] = V::xor_(x[i], m[i]);
+    }
+}
+
+#undef SKEIN_INJECT
+#undef SKEIN_MIX
+
+
+template<typename V>
+void skein512(const uint8_t* data, size_t size, uint8_t* output)
+{
+    using u64 = typename V::u64;
+
+    const size_t words = size / 8;
+
+    u64 h[8];
+    for (size_t i = 0; i < 8; ++i) {
+        h[i] = V::set1(skein512_iv[i]);
+    }
+
+    u64 m[8];
+    size_t pos      = 0;
+    uint64_t flags  = kSkeinFirst | kSkeinTypeMsg;
+
+    // The last block is always processed with the final flag, even if it is full
+    while (words - pos > 8) {
+        for (size_t i = 0; i < 8; ++i) {
+            m[i] = load64<V>(data, size, pos + i);
+        }
+        pos += 8;
+
+        skein512_ubi<V>(h, m, pos * 8, flags);
+        flags = kSkeinTypeMsg;
+    }
+
+    for (size_t i = 0; i < 8; ++i) {
+        m[i] = (pos + i < words) ? load64<V>(data, size, pos + i) : V::zero();
+    }
+
+    skein512_ubi<V>(h, m, static_cast<uint64_t>(size), flags | kSkeinFinal);
+
+    for (auto& x : m) {
+        x = V::zero();
+    }
+
+    skein512_ubi<V>(h, m, 8, kSkeinFirst | kSkeinFinal | kSkeinTypeOut);
+
+    store64<V>(output, h);
+}
+
+
+// CubeHash-512 (CubeHash16/32-512: 32-byte blocks, 16 rounds per block, 160 final rounds)
+
+static const uint32_t cubehash512_iv[32] = {
+    0x2AEA2A61, 0x50F494D4, 0x2D538B8B, 0x4167D83E, 0x3FEE2313, 0xC701CF8C, 0xCC39968E, 0x50AC5695,
+    0x4D42C787, 0xA647A8B3, 0x97CF0BEF, 0x825B4537, 0xEEF864D2, 0xF22090C4, 0xD0E5CD33, 0xA23911AE,
+    0xFCD398D9, 0x148FE485, 0x1B017BEF, 0xB6444532, 0x6A536159, 0x2FF5781C, 0x91FA7934, 0x0DBADEA9,
+    0xD65C8A2B, 0xA5A70E75, 0xB1C62456, 0xBC796576, 0x1921C8F7, 0xE7989AF1, 0x7795D246, 0xD43E3B44
+};
+
+
+// One round as in the specification, the swaps are plain register renames once the loops are unrolled.
+template<typename V>
+static inline void cubehash_round(typename V::u32 (&x)[32])
+{
+    for (size_t i = 0; i < 16; ++i) {
+        x[i + 16] = V::add(x[i + 16], x[i]);
+        x[i]      = V::template rotl<7>(x[i]);
+    }
+
+    for (size_t i = 0; i < 8; ++i) {
+        std::swap(x[i], x[i + 8]);
+    }
+
+    for (size_t i = 0; i < 16; ++i) {
+        x[i] = V::xor_(x[i], x[i + 16]);
+    }
+
+    for (size_t i = 16; i < 32; ++i) {
+        if (!(i & 2)) {
+            std::swap(x[i], x[i + 2]);
+        }
+    }
+
+    for (size_t i = 0; i < 16; ++i) {
+        x[i + 16] = V::add(x[i + 16], x[i]);
+        x[i]      = V::template rotl<11>(x[i]);
+    }
+
+    for (size_t i = 0; i < 16; ++i) {
+        if (!(i & 4)) {
+            std::swap(x[i], x[i + 4]);
+        }
+    }
+
+    for (size_t i = 0; i < 16; ++i) {
+        x[i] = V::xor_(x[i], x[i + 16]);
+    }
+
+    for (size_t i = 16; i < 32; i += 2) {
+        std::swap(x[i], x[i + 1]);
+    }
+}
+
+
+template<typename V>
+static inline void cubehash_sixteen_rounds(typename V::u32 (&x)[32])
+{
+    for (size_t r = 0; r < 16; ++r) {
+        cubehash_round<V>(x);
+    }
+}
+
+
+template<typename V>
+void cubehash512(const uint8_t* data, size_t size, uint8_t* output)
+{
+    using u32 = typename V::u32;
+
+    const size_t words = size / 4;
+
+    u32 x[32];
+    for (size_t i = 0; i < 32; ++i) {
+        x[i] = V::set1_32(cubehash512_iv[i]);
+    }
+
+    size_t pos = 0;
+    for (; pos + 8 <= words; pos += 8) {
+        for (size_t i = 0; i < 8; ++i) {
+            x[i] = V::xor_(x[i], load32<V>(data, size, pos + i));
+        }
+
+        cubehash_sixteen_rounds<V>(x);
+    }
+
+    for (size_t i = 0; pos + i < words; ++i) {
+        x[i] = V::xor_(x[i], load32<V>(data, size, pos + i));
+    }
+
+    x[words - pos] = V::xor_(x[words - pos], V::set1_32(0x80));
+    cubehash_sixteen_rounds<V>(x);
+
+    x[31] = V::xor_(x[31], V::set1_32(1));
+
+    for (size_t i = 0; i < 10; ++i) {
+        cubehash_sixteen_rounds<V>(x);
+    }
+
+    store32<V>(output, x);
+}
+
+
+// Shabal-512
+
+static const uint32_t shabal512_a[12] = {
+    0x20728DFD, 0x46C0BD53, 0xE782B699, 0x55304632, 0x71B4EF90, 0x0EA9E82C, 0xDBB930F1, 0xFAD06B8B,
+    0xBE0CAE40, 0x8BD14410, 0x76D2ADAC, 0x28ACAB7F
+};
+
+static const uint32_t shabal512_b[16] = {
+    0xC1099CB7, 0x07B385F3, 0xE7442C26, 0xCC8AD640, 0xEB6F56C7, 0x1EA81AA9, 0x73B9D314, 0x1DE85D08,
+    0x48910A5A, 0x893B22DB, 0xC5A0DF44, 0xBBC4324E, 0x72D2F240, 0x75941D99, 0x6D8BDE82, 0xA1A7502B
+};
+
+static const uint32_t shabal512_c[16] = {
+    0xD9BF68D1, 0x58BAD750, 0x56028CB2, 0x8134F359, 0xB5D469D8, 0x941A8CC2, 0x418B2A6E, 0x04052780,
+    0x7F07D787, 0x5194358F, 0x3C60D665, 0xBE97D79A, 0x950C3434, 0xAED9A06D, 0x2537DC8D, 0x7CDB5969
+};
+
+
+template<typename V>
+struct Shabal
+{
+    using u32 = typename V::u32;
+
+    u32 a[12];
+    u32 b[16];
+    u32 c[16];
+    u32 m[16];
+    uint64_t w = 1;
+
+    inline void xorW()
+    {
+        a[0] = V::xor_(a[0], V::set1_32(static_cast<uint32_t>(w)));
+        a[1] = V::xor_(a[1], V::set1_32(static_cast<uint32_t>(w >> 32)));
+    }
+
+    inline void swapBC()
+    {
+        for (size_t i = 0; i < 16; ++i) {
+            std::swap(b[i], c[i]);
+        }
+    }
+
+    void permute()
+    {
+        for (size_t i = 0; i < 16; ++i) {
+            b[i] = V::template rotl<17>(b[i]);
+        }
+
+        for (size_t k = 0; k < 48; ++k) {
+            const size_t i  = k % 16;
+            const size_t a0 = k % 12;
+            const size_t a1 = (k + 11) % 12;
+
+            // (a ^ rotl(a1, 15) * 5 ^ c) * 3
+            u32 t = V::template rotl<15>(a[a1]);
+            t     = V::add(V::template shl<2>(t), t);
+            t     = V::xor_(V::xor_(a[a0], t), c[(24 - i) % 16]);
+            t     = V::add(V::template shl<1>(t), t);
+
+            a[a0] = V::xor_(V::xor_(t, b[(i + 13) % 16]), V::xor_(V::andnot(b[(i + 6) % 16], b[(i + 9) % 16]), m[i]));
+            b[i]  = V::not_(V::xor_(V::template rotl<1>(b[i]), a[a0]));
+        }
+
+        for (size_t k = 0; k < 36; ++k) {
+            a[(47 - k) % 12] = V::add(a[(47 - k) % 12], c[(54 - k) % 16]);
+        }
+    }
+};
+
+
+template<typename V>
+void shabal512(const uint8_t* data, size_t size, uint8_t* output)
+{
+    const size_t words = size / 4;
+
+    Shabal<V> s;
+    for (size_t i = 0; i < 12; ++i) {
+        s.a[i] = V::set1_32(shabal512_a[i]);
+    }
+
+    for (size_t i = 0; i < 16; ++i) {
+        s.b[i] = V::set1_32(shabal512_b[i]);
+        s.c[i] = V::set1_32(shabal512_c[i]);
+    }
+
+    size_t pos = 0;
+    for (; pos + 16 <= words; pos += 16) {
+        for (size_t i = 0; i < 16; ++i) {
+            s.m[i] = load32<V>(data, size, pos + i);
+            s.b[i] = V::add(s.b[i], s.m[i]);
+        }
+
+        s.xorW();
+        s.permute();
+
+        for (size_t i = 0; i < 16; ++i) {
+            s.c[i] = V::sub(s.c[i], s.m[i]);
+        }
+
+        s.swapBC();
+        ++s.w;
+    }
+
+    for (size_t i = 0; i < 16; ++i) {
+        s.m[i] = (pos + i < words) ? load32<V>(data, size, pos + i) : V::zero32();
+    }
+
+    s.m[words - pos] = V::xor_(s.m[words - pos], V::set1_32(0x80));
+
+    for (size_t i = 0; i < 16; ++i) {
+        s.b[i] = V::add(s.b[i], s.m[i]);
+    }
+
+    s.xorW();
+    s.permute();
+
+    for (size_t i = 0; i < 3; ++i) {
+        s.swapBC();
+        s.xorW();
+        s.permute();
+    }
+
+    store32<V>(output, s.b);
+}
+
+
+} // namespace x4
+
+
+} // namespace ghostrider
+
+
+} // namespace xmrig
+
+#endif // XMRIG_GR_CORE_X4_IMPL_H
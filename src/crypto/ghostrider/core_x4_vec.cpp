@@ -0,0 +1,98 @@
+/* XMRig
+ * Copyright (c) 2018-2024 SChernykh   <https://github.com/SChernykh>
+ * Copyright (c) 2016-2024 XMRig       <https://github.com/xmrig>, <support@xmrig.com>
+ *
+ *   This program is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "core_x4.h"
+#include "core_x4_impl.h"
+
+
+/*
+    Instantiation of the 4-way core hashes with GCC/Clang vector extensions, used on ARM where the compiler maps
+    them to NEON (a 4 x 64-bit vector is a pair of q registers). The same code builds on any target, which is how
+    it is checked against the sph_* functions on machines without an ARM CPU.
+*/
+
+
+namespace xmrig
+{
+
+
+namespace ghostrider
+{
+
+
+namespace
+{
+
+
+struct Vec
+{
+    typedef uint64_t u64 __attribute__((vector_size(32)));
+    typedef uint32_t u32 __attribute__((vector_size(16)));
+
+    static inline u64 make(uint64_t a, uint64_t b, uint64_t c, uint64_t d)    { const u64 x = { a, b, c, d }; return x; }
+    static inline u32 make(uint32_t a, uint32_t b, uint32_t c, uint32_t d)    { const u32 x = { a, b, c, d }; return x; }
+    static inline u64 set1(uint64_t x)                                        { return make(x, x, x, x); }
+    static inline u32 set1_32(uint32_t x)                                     { return make(x, x, x, x); }
+    static inline u64 zero()                                                  { return set1(0); }
+    static inline u32 zero32()                                                { return set1_32(0); }
+    static inline uint64_t get(u64 x, size_t lane)                            { return x[lane]; }
+    static inline uint32_t get(u32 x, size_t lane)                            { return x[lane]; }
+
+    static inline u64 add(u64 a, u64 b)      { return a + b; }
+    static inline u32 add(u32 a, u32 b)      { return a + b; }
+    static inline u64 sub(u64 a, u64 b)      { return a - b; }
+    static inline u32 sub(u32 a, u32 b)      { return a - b; }
+    static inline u64 xor_(u64 a, u64 b)     { return a ^ b; }
+    static inline u32 xor_(u32 a, u32 b)     { return a ^ b; }
+    static inline u64 or_(u64 a, u64 b)      { return a | b; }
+    static inline u32 or_(u32 a, u32 b)      { return a | b; }
+    static inline u64 andnot(u64 a, u64 b)   { return ~a & b; }
+    static inline u32 andnot(u32 a, u32 b)   { return ~a & b; }
+    static inline u32 not_(u32 a)            { return ~a; }
+
+    template<int N> static inline u64 shl(u64 x)    { return x << N; }
+    template<int N> static inline u32 shl(u32 x)    { return x << N; }
+    template<int N> static inline u64 shr(u64 x)    { return x >> N; }
+    template<int N> static inline u32 shr(u32 x)    { return x >> N; }
+    template<int N> static inline u64 rotl(u64 x)   { return (x << N) | (x >> (64 - N)); }
+    template<int N> static inline u32 rotl(u32 x)   { return (x << N) | (x >> (32 - N)); }
+
+    static inline u64 rotl(u64 x, int n)            { return n ? ((x << n) | (x >> (64 - n))) : x; }
+
+    static inline u64 bswap(u64 x)
+    {
+        return make(__builtin_bswap64(x[0]), __builtin_bswap64(x[1]), __builtin_bswap64(x[2]), __builtin_bswap64(x[3]));
+    }
+};
+
+
+} // namespace
+
+
+void blake512_x4_vec(const uint8_t* data, size_t size, uint8_t* output)       { x4::blake512<Vec>(data, size, output); }
+void bmw512_x4_vec(const uint8_t* data, size_t size, uint8_t* output)         { x4::bmw512<Vec>(data, size, output); }
+void keccak512_x4_vec(const uint8_t* data, size_t size, uint8_t* output)      { x4::keccak512<Vec>(data, size, output); }
+void skein512_x4_vec(const uint8_t* data, size_t size, uint8_t* output)       { x4::skein512<Vec>(data, size, output); }
+void cubehash512_x4_vec(const uint8_t* data, size_t size, uint8_t* output)    { x4::cubehash512<Vec>(data, size, output); }
+void shabal512_x4_vec(const uint8_t* data, size_t size, uint8_t* output)      { x4::shabal512<Vec>(data, size, output); }
+
+
+} // namespace ghostrider
+
+
+} // namespace xmrig
@@ -17,6 +17,7 @@
  */
 
 #include "ghostrider.h"
+#include "core_x4.h"
 #include "sph_blake.h"
 #include "sph_bmw.h"
 #include "sph_groestl.h"
@@ -33,17 +34,24 @@
 #include "sph_shabal.h"
 #include "sph_whirlpool.h"
 
+#include "3rdparty/rapidjson/document.h"
+#include "base/io/json/Json.h"
 #include "base/io/log/Log.h"
 #include "base/io/log/Tags.h"
 #include "base/tools/Chrono.h"
+#include "base/tools/Parking.h"
 #include "backend/cpu/Cpu.h"
 #include "crypto/cn/CnHash.h"
 #include "crypto/cn/CnCtx.h"
 #include "crypto/cn/CryptoNight.h"
 #include "crypto/common/VirtualMemory.h"
+#include "version.h"
 
+#include <algorithm>
 #include <thread>
 #include <atomic>
+#include <cstdio>
+#include <cstring>
 #include <uv.h>
 
 #ifdef XMRIG_FEATURE_HWLOC
@@ -98,6 +106,57 @@ namespace xmrig
 {
 
 
+// Multi-buffer versions of the core hashes, nullptr if not available for this CPU
+static const ghostrider::core_hash_x4_func* core_hash_x4()
+{
+    static const struct Table
+    {
+        Table()
+        {
+#           ifdef XMRIG_FEATURE_AVX2
+            if (Cpu::info()->hasAVX2()) {
+                f[0]  = ghostrider::blake512_x4_avx2;
+                f[1]  = ghostrider::bmw512_x4_avx2;
+                f[4]  = ghostrider::keccak512_x4_avx2;
+                f[5]  = ghostrider::skein512_x4_avx2;
+                f[7]  = ghostrider::cubehash512_x4_avx2;
+                f[13] = ghostrider::shabal512_x4_avx2;
+            }
+#           elif defined(XMRIG_ARM) && !defined(_MSC_VER)
+            f[0]  = ghostrider::blake512_x4_vec;
+            f[1]  = ghostrider::bmw512_x4_vec;
+            f[4]  = ghostrider::keccak512_x4_vec;
+            f[5]  = ghostrider::skein512_x4_vec;
+            f[7]  = ghostrider::cubehash512_x4_vec;
+            f[13] = ghostrider::shabal512_x4_vec;
+#           endif
+        }
+
+        ghostrider::core_hash_x4_func f[15] = {};
+    } table;
+
+    return table.f;
+}
+
+
+// Computes core hash "index" for lanes [begin; end): lane j is read from data + j * size and written to output + j * 64
+static void core_hash_lanes(uint32_t index, const uint8_t* data, size_t size, uint8_t* output, size_t begin, size_t end)
+{
+    size_t j = begin;
+
+    const ghostrider::core_hash_x4_func x4 = core_hash_x4()[index];
+    if (x4 && ((size == 64) || (size == 80))) {
+        for (; j + 4 <= end; j += 4) {
+            x4(data + j * size, size, output + j * 64);
+        }
+    }
+
+    for (; j < end; ++j) {
+        core_hash[index](data + j * size, size, output + j * 64);
+    }
+}
+
+
 static constexpr Algorithm::Id cn_hash[6] = {
     Algorithm::CN_GR_0,
     Algorithm::CN_GR_1,
@@ -116,6 +175,16 @@ static constexpr const char* cn_names[6] = {
     "cn/turtle-lite (128 KB)",
 };
 
+// Keys used by the "gr-tune" config option and the tuning cache file
+static constexpr const char* cn_keys[6] = {
+    "cn/dark",
+    "cn/dark-lite",
+    "cn/fast",
+    "cn/lite",
+    "cn/turtle",
+    "cn/turtle-lite",
+};
+
 static constexpr size_t cn_sizes[6] = {
     Algorithm::l3(Algorithm::CN_GR_0),     // 512 KB
     Algorithm::l3(Algorithm::CN_GR_1) / 2, // 256 KB
@@ -236,13 +305,8 @@ struct HelperThread
 
     inline void wait() const
     {
-        while (m_numTasks) {
-#if defined(XMRIG_RISCV)
-            // RISC-V: Use standard pause equivalent
-            std::this_thread::yield();
-#else
-            _mm_pause();
-#endif
+        for (uint32_t n = m_numTasks; n; n = m_numTasks) {
+            Parking::spin(&m_numTasks, n);
         }
     }
 
@@ -291,14 +355,149 @@ struct HelperThread
 };
 
 
-void benchmark()
+static bool parse_tune(const char* value, AlgoTune& tune)
 {
+    unsigned step    = 0;
+    unsigned threads = 0;
+    char tail        = 0;
+
+    if (!value || (sscanf(value, "%ux%u%c", &step, &threads, &tail) != 2)) {
+        return false;
+    }
+
+    if (((step != 1) && (step != 2) && (step != 4)) || (threads < 1) || (threads > 2)) {
+        return false;
+    }
+
+    tune.hashrate = 0.0;
+    tune.step     = step;
+    tune.threads  = threads;
+
+    return true;
+}
+
+
 #ifndef XMRIG_ARM
-    static std::atomic<int> done{ 0 };
-    if (done.exchange(1)) {
+static String tune_fingerprint()
+{
+    const ICpuInfo* info = Cpu::info();
+
+    char buf[256];
+    snprintf(buf, sizeof(buf), "%s/%zu/%zu/%zu/%zu/%s", info->brand(), info->L2(), info->L3(), info->cores(), info->threads(), info->hasAES() ? "aes" : "soft-aes");
+
+    return static_cast<const char*>(buf);
+}
+
+
+static bool read_tune_table(const rapidjson::Value& value, AlgoTune (&table)[6])
+{
+    if (!value.IsObject()) {
+        return false;
+    }
+
+    AlgoTune result[6];
+
+    for (size_t algo = 0; algo < 6; ++algo) {
+        const rapidjson::Value& entry = Json::getArray(value, cn_keys[algo]);
+        if ((entry.Size() != 3) || !entry[0].IsUint() || !entry[1].IsUint() || !entry[2].IsNumber()) {
+            return false;
+        }
+
+        const uint32_t step    = entry[0].GetUint();
+        const uint32_t threads = entry[1].GetUint();
+
+        if (((step != 1) && (step != 2) && (step != 4)) || (threads < 1) || (threads > 2)) {
+            return false;
+        }
+
+        result[algo].hashrate = entry[2].GetDouble();
+        result[algo].step     = step;
+        result[algo].threads  = threads;
+    }
+
+    std::copy(std::begin(result), std::end(result), table);
+
+    return true;
+}
+
+
+static rapidjson::Value tune_table_to_json(const AlgoTune (&table)[6], rapidjson::Document& doc)
+{
+    using namespace rapidjson;
+    auto& allocator = doc.GetAllocator();
+
+    Value obj(kObjectType);
+
+    for (size_t algo = 0; algo < 6; ++algo) {
+        Value entry(kArrayType);
+        entry.PushBack(table[algo].step, allocator);
+        entry.PushBack(table[algo].threads, allocator);
+        entry.PushBack(Json::normalize(table[algo].hashrate, true), allocator);
+
+        obj.AddMember(StringRef(cn_keys[algo]), entry, allocator);
+    }
+
+    return obj;
+}
+
+
+static bool load_tune(const String& fileName, const String& fingerprint)
+{
+    rapidjson::Document doc;
+    if (fileName.isEmpty() || !Json::get(fileName, doc) || !doc.IsObject()) {
+        return false;
+    }
+
+    const rapidjson::Value& entry = Json::getObject(doc, fingerprint);
+    if (!entry.IsObject() || (strcmp(Json::getString(entry, "version", ""), APP_VERSION) != 0)) {
+        return false;
+    }
+
+    AlgoTune d[6];
+    AlgoTune e[6];
+
+    if (!read_tune_table(Json::getValue(entry, "default"), d) || !read_tune_table(Json::getValue(entry, "8mb"), e)) {
+        return false;
+    }
+
+    std::copy(std::begin(d), std::end(d), tuneDefault);
+    std::copy(std::begin(e), std::end(e), tune8MB);
+
+    return true;
+}
+
+
+static void save_tune(const String& fileName, const String& fingerprint)
+{
+    using namespace rapidjson;
+
+    if (fileName.isEmpty()) {
         return;
     }
 
+    Document doc;
+    if (!Json::get(fileName, doc) || !doc.IsObject()) {
+        doc.SetObject();
+    }
+
+    auto& allocator = doc.GetAllocator();
+
+    Value entry(kObjectType);
+    entry.AddMember("version",  APP_VERSION, allocator);
+    entry.AddMember("default",  tune_table_to_json(tuneDefault, doc), allocator);
+    entry.AddMember("8mb",      tune_table_to_json(tune8MB, doc), allocator);
+
+    doc.RemoveMember(fingerprint.data());
+    doc.AddMember(fingerprint.toJSON(doc), entry, allocator);
+
+    if (!Json::save(fileName, doc)) {
+        LOG_WARN("%s " YELLOW("failed to save GhostRider tuning results to \"%s\""), Tags::cpu(), fileName.data());
+    }
+}
+
+
+static void run_benchmark()
+{
     std::thread t([]() {
         // Try to avoid CPU core 0 because many system threads use it and can interfere
         uint32_t thread_index1 = (Cpu::info()->threads() > 2) ? 2 : 0;
@@ -449,6 +648,76 @@ void benchmark()
     });
 
     t.join();
+}
+#endif
+
+
+static String tune_summary(const AlgoTune (&table)[6])
+{
+    char buf[256];
+    size_t pos = 0;
+
+    for (size_t algo = 0; algo < 6; ++algo) {
+        pos += snprintf(buf + pos, sizeof(buf) - pos, "%s%s " WHITE_BOLD("%ux%u"), algo ? ", " : "", cn_keys[algo] + 3, table[algo].step, table[algo].threads);
+    }
+
+    return static_cast<const char*>(buf);
+}
+
+
+void benchmark(const String &cacheFile, const std::map<String, String> &tune)
+{
+    static std::atomic<int> done{ 0 };
+    if (done.exchange(1)) {
+        return;
+    }
+
+    AlgoTune overrides[6];
+    bool overridden[6] = {};
+    size_t overrideCount = 0;
+
+    for (const auto& kv : tune) {
+        const auto it = std::find_if(std::begin(cn_keys), std::end(cn_keys), [&kv](const char* key) { return kv.first == key; });
+        if (it == std::end(cn_keys)) {
+            LOG_WARN("%s " YELLOW("unknown GhostRider variant \"%s\" in \"gr-tune\""), Tags::cpu(), kv.first.data());
+            continue;
+        }
+
+        const size_t algo = it - std::begin(cn_keys);
+        if (!parse_tune(kv.second, overrides[algo])) {
+            LOG_WARN("%s " YELLOW("invalid GhostRider tune \"%s\" for \"%s\", expected <1|2|4>x<1|2>"), Tags::cpu(), kv.second.data(), kv.first.data());
+            continue;
+        }
+
+        if (!overridden[algo]) {
+            overridden[algo] = true;
+            ++overrideCount;
+        }
+    }
+
+    const char* source = "override";
+
+#   ifndef XMRIG_ARM
+    if (overrideCount < 6) {
+        const String fingerprint = tune_fingerprint();
+
+        if (load_tune(cacheFile, fingerprint)) {
+            source = "cached";
+        }
+        else {
+            run_benchmark();
+            save_tune(cacheFile, fingerprint);
+            source = "autotuned";
+        }
+    }
+#   endif
+
+    for (size_t algo = 0; algo < 6; ++algo) {
+        if (overridden[algo]) {
+            tuneDefault[algo] = overrides[algo];
+            tune8MB[algo]     = overrides[algo];
+        }
+    }
 
     LOG_VERBOSE("---------------------------------------------");
     LOG_VERBOSE("|         GhostRider tuning results         |");
@@ -460,7 +729,12 @@ void benchmark()
             LOG_VERBOSE("%24s | %ux%u | %.2f h/s", cn_names[algo], tune8MB[algo].step, tune8MB[algo].threads, tune8MB[algo].hashrate);
         }
     }
-#endif
+
+    LOG_INFO("%s GhostRider tune " CYAN("%s") " %s%s", Tags::cpu(), source, tune_summary(tuneDefault).data(), overrideCount && (overrideCount < 6) ? " (with overrides)" : "");
+
+    if (!std::equal(std::begin(tuneDefault), std::end(tuneDefault), std::begin(tune8MB), [](const AlgoTune& a, const AlgoTune& b) { return (a.step == b.step) && (a.threads == b.threads); })) {
+        LOG_INFO("%s GhostRider tune " CYAN("8 MB L3") " %s", Tags::cpu(), tune_summary(tune8MB).data());
+    }
 }
 
 
@@ -627,9 +901,7 @@ void hash_octa(const uint8_t* data, size_t size, uint8_t* output, cryptonight_ct
                 }
 
                 for (size_t i = 0; i < 5; ++i) {
-                    for (size_t j = n; j < N; ++j) {
-                        core_hash[core_indices[part * 5 + i]](input + j * input_size, input_size, tmp + j * 64);
-                    }
+                    core_hash_lanes(core_indices[part * 5 + i], input, input_size, tmp, n, N);
                     input = tmp;
                     input_size = 64;
                 }
@@ -671,9 +943,7 @@ void hash_octa(const uint8_t* data, size_t size, uint8_t* output, cryptonight_ct
             }
 
             for (size_t i = 0; i < 5; ++i) {
-                for (size_t j = 0; j < n; ++j) {
-                    core_hash[core_indices[part * 5 + i]](input + j * input_size, input_size, tmp + j * 64);
-                }
+                core_hash_lanes(core_indices[part * 5 + i], input, input_size, tmp, 0, n);
                 input = tmp;
                 input_size = 64;
             }
@@ -739,9 +1009,7 @@ void hash_octa(const uint8_t* data, size_t size, uint8_t* output, cryptonight_ct
                     size_t input_size = size;
 
                     for (size_t i = 0; i < 5; ++i) {
-                        for (size_t j = n; j < N; ++j) {
-                            core_hash[core_indices[part * 5 + i]](input + j * input_size, input_size, tmp + j * 64);
-                        }
+                        core_hash_lanes(core_indices[part * 5 + i], input, input_size, tmp, n, N);
                         input = tmp;
                         input_size = 64;
                     }
@@ -759,9 +1027,7 @@ void hash_octa(const uint8_t* data, size_t size, uint8_t* output, cryptonight_ct
             }
 
             for (size_t i = 0; i < 5; ++i) {
-                for (size_t j = 0; j < n; ++j) {
-                    core_hash[core_indices[part * 5 + i]](data + j * size, size, tmp + j * 64);
-                }
+                core_hash_lanes(core_indices[part * 5 + i], data, size, tmp, 0, n);
                 data = tmp;
                 size = 64;
             }
@@ -791,7 +1057,7 @@ void hash_octa(const uint8_t* data, size_t size, uint8_t* output, cryptonight_ct
 #else // XMRIG_FEATURE_HWLOC
 
 
-void benchmark() {}
+void benchmark(const String &, const std::map<String, String> &) {}
 HelperThread* create_helper_thread(int64_t, int, const std::vector<int64_t>&) { return nullptr; }
 void destroy_helper_thread(HelperThread*) {}
 
@@ -855,9 +1121,7 @@ void hash_octa(const uint8_t* data, size_t size, uint8_t* output, cryptonight_ct
         }
 
         for (size_t i = 0; i < 5; ++i) {
-            for (size_t j = 0; j < N; ++j) {
-                core_hash[core_indices[part * 5 + i]](data + j * size, size, tmp + j * 64);
-            }
+            core_hash_lanes(core_indices[part * 5 + i], data, size, tmp, 0, N);
             data = tmp;
             size = 64;
         }
@@ -882,6 +1146,39 @@ void hash_octa(const uint8_t* data, size_t size, uint8_t* output, cryptonight_ct
 #endif // XMRIG_FEATURE_HWLOC
 
 
+bool verify_x4()
+{
+    uint8_t data[4 * 80];
+    for (size_t i = 0; i < sizeof(data); ++i) {
+        data[i] = static_cast<uint8_t>((i * 167) ^ (i >> 3) ^ 0x5A);
+    }
+
+    for (uint32_t index = 0; index < 15; ++index) {
+        const core_hash_x4_func x4 = core_hash_x4()[index];
+        if (!x4) {
+            continue;
+        }
+
+        for (size_t size : { 64, 80 }) {
+            uint8_t expected[4 * 64];
+            uint8_t actual[4 * 64];
+
+            for (size_t j = 0; j < 4; ++j) {
+                core_hash[index](data + j * size, size, expected + j * 64);
+            }
+
+            x4(data, size, actual);
+
+            if (memcmp(expected, actual, sizeof(actual)) != 0) {
+                return false;
+            }
+        }
+    }
+
+    return true;
+}
+
+
 } // namespace ghostrider
 
 
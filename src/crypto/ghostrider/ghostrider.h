@@ -20,8 +20,12 @@
 #define XMRIG_GR_HASH_H
 
 
+#include "base/tools/String.h"
+
+
 #include <cstddef>
 #include <cstdint>
+#include <map>
 #include <vector>
 
 
@@ -38,11 +42,14 @@ namespace ghostrider
 
 struct HelperThread;
 
-void benchmark();
+void benchmark(const String &cacheFile, const std::map<String, String> &tune);
 HelperThread* create_helper_thread(int64_t cpu_index, int priority, const std::vector<int64_t>& affinities);
 void destroy_helper_thread(HelperThread* t);
 void hash_octa(const uint8_t* data, size_t size, uint8_t* output, cryptonight_ctx** ctx, HelperThread* helper, bool verbose = true);
 
+// Checks every multi-buffer core hash available for this CPU against the scalar one, on 64 and 80 byte messages.
+bool verify_x4();
+
 
 } // namespace ghostrider
 
@@ -26,6 +26,8 @@ OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
 OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 */
 
+#include <algorithm>
+#include <cstring>
 #include <thread>
 #include <vector>
 #include <array>
@@ -37,14 +39,15 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include "crypto/randomx/instruction.hpp"
 #include "crypto/randomx/common.hpp"
 #include "crypto/rx/Profiler.h"
+#include "backend/cpu/Cpu.h"
+#include "base/io/log/Log.h"
+#include "base/io/log/Tags.h"
 
-#define AES_HASH_1R_STATE0 0xd7983aad, 0xcc82db47, 0x9fa856de, 0x92b52c0d
-#define AES_HASH_1R_STATE1 0xace78057, 0xf59e125a, 0x15c7b798, 0x338d996e
-#define AES_HASH_1R_STATE2 0xe8a07ce4, 0x5079506b, 0xae62c7d0, 0x6a770017
-#define AES_HASH_1R_STATE3 0x7e994948, 0x79a10005, 0x07ad828d, 0x630a240c
 
-#define AES_HASH_1R_XKEY0 0x06890201, 0x90dc56bf, 0x8b24949f, 0xf6fa8389
-#define AES_HASH_1R_XKEY1 0xed18f99b, 0xee1043c6, 0x51f4e03c, 0x61b263d1
+#ifdef XMRIG_VAES
+// Set by SelectHardAESImpl() if the VAES versions are faster than the 128-bit ones
+static bool vaesImpl = false;
+#endif
 
 /*
 	Calculate a 512-bit hash of 'input' using 4 lanes of AES.
@@ -60,6 +63,12 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 */
 template<int softAes>
 void hashAes1Rx4(const void *input, size_t inputSize, void *hash) {
+#	ifdef XMRIG_VAES
+	if (!softAes && vaesImpl) {
+		return hashAes1Rx4_vaes(input, inputSize, hash);
+	}
+#	endif
+
 	const uint8_t* inptr = (uint8_t*)input;
 	const uint8_t* inputEnd = inptr + inputSize;
 
@@ -111,11 +120,6 @@ void hashAes1Rx4(const void *input, size_t inputSize, void *hash) {
 template void hashAes1Rx4<false>(const void *input, size_t inputSize, void *hash);
 template void hashAes1Rx4<true>(const void *input, size_t inputSize, void *hash);
 
-#define AES_GEN_1R_KEY0 0xb4f44917, 0xdbb5552b, 0x62716609, 0x6daca553
-#define AES_GEN_1R_KEY1 0x0da1dc4e, 0x1725d378, 0x846a710d, 0x6d7caf07
-#define AES_GEN_1R_KEY2 0x3e20e345, 0xf4c0794f, 0x9f947ec6, 0x3f1262f1
-#define AES_GEN_1R_KEY3 0x49169154, 0x16314c88, 0xb1ba317c, 0x6aef8135
-
 /*
 	Fill 'buffer' with pseudorandom data based on 512-bit 'state'.
 	The state is encrypted using a single AES round per 16 bytes of output
@@ -128,6 +132,12 @@ template void hashAes1Rx4<true>(const void *input, size_t inputSize, void *hash)
 */
 template<int softAes>
 void fillAes1Rx4(void *state, size_t outputSize, void *buffer) {
+#	ifdef XMRIG_VAES
+	if (!softAes && vaesImpl) {
+		return fillAes1Rx4_vaes(state, outputSize, buffer);
+	}
+#	endif
+
 	const uint8_t* outptr = (uint8_t*)buffer;
 	const uint8_t* outputEnd = outptr + outputSize;
 
@@ -172,6 +182,12 @@ alignas(16) static const randomx::Instruction inst_mask[2] = { inst, inst };
 
 template<int softAes>
 void fillAes4Rx4(void *state, size_t outputSize, void *buffer) {
+#	ifdef XMRIG_VAES
+	if (!softAes && vaesImpl) {
+		return fillAes4Rx4_vaes(state, outputSize, buffer);
+	}
+#	endif
+
 	const uint8_t* outptr = (uint8_t*)buffer;
 	const uint8_t* outputEnd = outptr + outputSize;
 
@@ -237,6 +253,12 @@ template void fillAes4Rx4<false>(void *state, size_t outputSize, void *buffer);
 
 template<int softAes, int unroll>
 void hashAndFillAes1Rx4(void *scratchpad, size_t scratchpadSize, void *hash, void* fill_state) {
+#	ifdef XMRIG_VAES
+	if (!softAes && vaesImpl) {
+		return hashAndFillAes1Rx4_vaes(scratchpad, scratchpadSize, hash, fill_state);
+	}
+#	endif
+
 	PROFILE_SCOPE(RandomX_AES);
 
 	uint8_t* scratchpadPtr = (uint8_t*)scratchpad;
@@ -382,47 +404,140 @@ template void hashAndFillAes1Rx4<2,1>(void* scratchpad, size_t scratchpadSize, v
 template void hashAndFillAes1Rx4<2,2>(void* scratchpad, size_t scratchpadSize, void* hash, void* fill_state);
 template void hashAndFillAes1Rx4<2,4>(void* scratchpad, size_t scratchpadSize, void* hash, void* fill_state);
 
+template void hashAndFillAes1Rx4<4,1>(void* scratchpad, size_t scratchpadSize, void* hash, void* fill_state);
+template void hashAndFillAes1Rx4<4,2>(void* scratchpad, size_t scratchpadSize, void* hash, void* fill_state);
+template void hashAndFillAes1Rx4<5,1>(void* scratchpad, size_t scratchpadSize, void* hash, void* fill_state);
+template void hashAndFillAes1Rx4<5,2>(void* scratchpad, size_t scratchpadSize, void* hash, void* fill_state);
+
+#if defined(__aarch64__)
+template void hashAndFillAes1Rx4<3,1>(void* scratchpad, size_t scratchpadSize, void* hash, void* fill_state);
+template void hashAndFillAes1Rx4<3,2>(void* scratchpad, size_t scratchpadSize, void* hash, void* fill_state);
+#endif
+
 hashAndFillAes1Rx4_impl* softAESImpl = &hashAndFillAes1Rx4<1,1>;
+static const char* softAESImplName = "ttable-volatile";
 
-void SelectSoftAESImpl(size_t threadsCount)
+static double benchmarkAESImpl(hashAndFillAes1Rx4_impl *impl, size_t threadsCount)
 {
   constexpr uint64_t test_length_ms = 100;
-  const std::array<hashAndFillAes1Rx4_impl *, 4> impl = {
-    &hashAndFillAes1Rx4<1,1>,
-    &hashAndFillAes1Rx4<2,1>,
-    &hashAndFillAes1Rx4<2,2>,
-    &hashAndFillAes1Rx4<2,4>,
+  const double t1 = xmrig::Chrono::highResolutionMSecs();
+  std::vector<uint32_t> count(threadsCount, 0);
+  std::vector<std::thread> threads;
+  for (size_t t = 0; t < threadsCount; ++t) {
+    threads.emplace_back([&, t]() {
+      // Larger than L1D (and L2 of small cores), AES table lines compete with the scratchpad like while mining
+      std::vector<uint8_t> scratchpad(256 * 1024);
+      alignas(16) uint8_t hash[64] = {};
+      alignas(16) uint8_t state[64] = {};
+      do {
+      (*impl)(scratchpad.data(), scratchpad.size(), hash, state);
+      ++count[t];
+      } while (xmrig::Chrono::highResolutionMSecs() - t1 < test_length_ms);
+    });
+  }
+  uint32_t total = 0;
+  for (size_t t = 0; t < threadsCount; ++t) {
+    threads[t].join();
+    total += count[t];
+  }
+  const double t2 = xmrig::Chrono::highResolutionMSecs();
+  return total * 1e3 / (t2 - t1);
+}
+
+// Every candidate must match the reference T-table variant bit for bit before it can be benchmarked,
+// variants written for one architecture can't be tested on all the others it may be built for
+static bool verifyAESImpl(hashAndFillAes1Rx4_impl *impl)
+{
+  constexpr size_t size = 4096;
+
+  alignas(16) uint8_t scratchpad[2][size];
+  alignas(16) uint8_t hash[2][64];
+  alignas(16) uint8_t state[2][64];
+
+  for (size_t i = 0; i < size; ++i) {
+    scratchpad[0][i] = scratchpad[1][i] = static_cast<uint8_t>(i * 167 + (i >> 8));
+  }
+
+  for (size_t i = 0; i < 64; ++i) {
+    hash[0][i]  = hash[1][i]  = static_cast<uint8_t>(i * 29 + 7);
+    state[0][i] = state[1][i] = static_cast<uint8_t>(i * 53 + 11);
+  }
+
+  for (int round = 0; round < 2; ++round) {
+    hashAndFillAes1Rx4<1,1>(scratchpad[0], size, hash[0], state[0]);
+    (*impl)(scratchpad[1], size, hash[1], state[1]);
+  }
+
+  return memcmp(scratchpad[0], scratchpad[1], size) == 0 && memcmp(hash[0], hash[1], sizeof(hash[0])) == 0 && memcmp(state[0], state[1], sizeof(state[0])) == 0;
+}
+
+void SelectSoftAESImpl(size_t threadsCount)
+{
+  struct Impl {
+    hashAndFillAes1Rx4_impl *impl;
+    const char *name;
+  };
+
+  const std::vector<Impl> impl = {
+    { &hashAndFillAes1Rx4<1,1>, "ttable-volatile" },
+    { &hashAndFillAes1Rx4<2,1>, "ttable" },
+    { &hashAndFillAes1Rx4<2,2>, "ttable-x2" },
+    { &hashAndFillAes1Rx4<2,4>, "ttable-x4" },
+    { &hashAndFillAes1Rx4<4,1>, "ttable-rotated" },
+    { &hashAndFillAes1Rx4<4,2>, "ttable-rotated-x2" },
+    { &hashAndFillAes1Rx4<5,1>, "sbox" },
+    { &hashAndFillAes1Rx4<5,2>, "sbox-x2" },
+#   if defined(__aarch64__)
+    { &hashAndFillAes1Rx4<3,1>, "neon" },
+    { &hashAndFillAes1Rx4<3,2>, "neon-x2" },
+#   endif
   };
+  std::vector<bool> valid(impl.size());
+  for (size_t i = 0; i < impl.size(); ++i) {
+    valid[i] = verifyAESImpl(impl[i].impl);
+    if (!valid[i]) {
+      LOG_WARN("%s " YELLOW("soft AES variant \"%s\" doesn't match the reference code, skipped"), xmrig::Tags::randomx(), impl[i].name);
+    }
+  }
   size_t fast_idx = 0;
   double fast_speed = 0.0;
   for (size_t run = 0; run < 3; ++run) {
     for (size_t i = 0; i < impl.size(); ++i) {
-      const double t1 = xmrig::Chrono::highResolutionMSecs();
-      std::vector<uint32_t> count(threadsCount, 0);
-      std::vector<std::thread> threads;
-      for (size_t t = 0; t < threadsCount; ++t) {
-        threads.emplace_back([&, t]() {
-          std::vector<uint8_t> scratchpad(10 * 1024);
-          alignas(16) uint8_t hash[64] = {};
-          alignas(16) uint8_t state[64] = {};
-          do {
-          (*impl[i])(scratchpad.data(), scratchpad.size(), hash, state);
-          ++count[t];
-          } while (xmrig::Chrono::highResolutionMSecs() - t1 < test_length_ms);
-        });
+      if (!valid[i]) {
+        continue;
       }
-      uint32_t total = 0;
-      for (size_t t = 0; t < threadsCount; ++t) {
-        threads[t].join();
-        total += count[t];
-      }
-      const double t2 = xmrig::Chrono::highResolutionMSecs();
-      const double speed = total * 1e3 / (t2 - t1);
+      const double speed = benchmarkAESImpl(impl[i].impl, threadsCount);
       if (speed > fast_speed) {
         fast_idx = i;
         fast_speed = speed;
       }
     }
   }
-  softAESImpl = impl[fast_idx];
+  softAESImpl = impl[fast_idx].impl;
+  softAESImplName = impl[fast_idx].name;
+}
+
+const char* GetSoftAESImplName()
+{
+  return softAESImplName;
+}
+
+void SelectHardAESImpl(size_t threadsCount)
+{
+#ifdef XMRIG_VAES
+  vaesImpl = false;
+  if (!xmrig::Cpu::info()->hasVAES()) {
+    return;
+  }
+
+  double aes_speed = 0.0;
+  double vaes_speed = 0.0;
+  for (size_t run = 0; run < 3; ++run) {
+    aes_speed = std::max(aes_speed, benchmarkAESImpl(&hashAndFillAes1Rx4<0,2>, threadsCount));
+    vaes_speed = std::max(vaes_speed, benchmarkAESImpl(&hashAndFillAes1Rx4_vaes, threadsCount));
+  }
+  vaesImpl = vaes_speed > aes_speed;
+#else
+  (void)threadsCount;
+#endif
 }
@@ -0,0 +1,217 @@
+/* XMRig
+ * Copyright (c) 2018-2024 SChernykh   <https://github.com/SChernykh>
+ * Copyright (c) 2016-2024 XMRig       <https://github.com/xmrig>, <support@xmrig.com>
+ *
+ *   This program is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <immintrin.h>
+
+#include "crypto/randomx/aes_hash.hpp"
+#include "crypto/randomx/randomx.h"
+#include "crypto/randomx/instruction.hpp"
+#include "crypto/rx/Profiler.h"
+
+
+/*
+	VAES versions of the AES hash/fill functions from aes_hash.cpp.
+
+	Lanes 0 and 2 use aesenc (or aesdec) and lanes 1 and 3 use the other one, so they are packed
+	as (0, 2) and (1, 3) into two ymm registers: one 256-bit aesenc and one 256-bit aesdec per 64 bytes.
+	The output is bit-exact with the 128-bit versions.
+*/
+
+static FORCE_INLINE __m256i load_lanes(const uint8_t *p, int lane)
+{
+	return _mm256_inserti128_si256(_mm256_castsi128_si256(_mm_load_si128(reinterpret_cast<const __m128i*>(p) + lane)), _mm_load_si128(reinterpret_cast<const __m128i*>(p) + lane + 2), 1);
+}
+
+
+static FORCE_INLINE void store_lanes(uint8_t *p, int lane, __m256i v)
+{
+	_mm_store_si128(reinterpret_cast<__m128i*>(p) + lane, _mm256_castsi256_si128(v));
+	_mm_store_si128(reinterpret_cast<__m128i*>(p) + lane + 2, _mm256_extracti128_si256(v, 1));
+}
+
+
+static FORCE_INLINE __m256i set_lanes(__m128i lo, __m128i hi)
+{
+	return _mm256_inserti128_si256(_mm256_castsi128_si256(lo), hi, 1);
+}
+
+
+void hashAes1Rx4_vaes(const void *input, size_t inputSize, void *hash)
+{
+	const uint8_t* inptr = (const uint8_t*)input;
+	const uint8_t* inputEnd = inptr + inputSize;
+
+	__m256i state02 = set_lanes(_mm_set_epi32(AES_HASH_1R_STATE0), _mm_set_epi32(AES_HASH_1R_STATE2));
+	__m256i state13 = set_lanes(_mm_set_epi32(AES_HASH_1R_STATE1), _mm_set_epi32(AES_HASH_1R_STATE3));
+
+	while (inptr < inputEnd) {
+		state02 = _mm256_aesenc_epi128(state02, load_lanes(inptr, 0));
+		state13 = _mm256_aesdec_epi128(state13, load_lanes(inptr, 1));
+
+		inptr += 64;
+	}
+
+	const __m256i xkey0 = _mm256_broadcastsi128_si256(_mm_set_epi32(AES_HASH_1R_XKEY0));
+	const __m256i xkey1 = _mm256_broadcastsi128_si256(_mm_set_epi32(AES_HASH_1R_XKEY1));
+
+	state02 = _mm256_aesenc_epi128(state02, xkey0);
+	state13 = _mm256_aesdec_epi128(state13, xkey0);
+
+	state02 = _mm256_aesenc_epi128(state02, xkey1);
+	state13 = _mm256_aesdec_epi128(state13, xkey1);
+
+	store_lanes((uint8_t*)hash, 0, state02);
+	store_lanes((uint8_t*)hash, 1, state13);
+}
+
+
+void fillAes1Rx4_vaes(void *state, size_t outputSize, void *buffer)
+{
+	uint8_t* outptr = (uint8_t*)buffer;
+	const uint8_t* outputEnd = outptr + outputSize;
+
+	const __m256i key02 = set_lanes(_mm_set_epi32(AES_GEN_1R_KEY0), _mm_set_epi32(AES_GEN_1R_KEY2));
+	const __m256i key13 = set_lanes(_mm_set_epi32(AES_GEN_1R_KEY1), _mm_set_epi32(AES_GEN_1R_KEY3));
+
+	__m256i state02 = load_lanes((const uint8_t*)state, 0);
+	__m256i state13 = load_lanes((const uint8_t*)state, 1);
+
+	while (outptr < outputEnd) {
+		state02 = _mm256_aesdec_epi128(state02, key02);
+		state13 = _mm256_aesenc_epi128(state13, key13);
+
+		store_lanes(outptr, 0, state02);
+		store_lanes(outptr, 1, state13);
+
+		outptr += 64;
+	}
+
+	store_lanes((uint8_t*)state, 0, state02);
+	store_lanes((uint8_t*)state, 1, state13);
+}
+
+
+void fillAes4Rx4_vaes(void *state, size_t outputSize, void *buffer)
+{
+	uint8_t* outptr = (uint8_t*)buffer;
+	const uint8_t* outputEnd = outptr + outputSize;
+
+	const rx_vec_i128 *keys = RandomX_CurrentConfig.fillAes4Rx4_Key;
+
+	const __m256i key0 = set_lanes(keys[0], keys[4]);
+	const __m256i key1 = set_lanes(keys[1], keys[5]);
+	const __m256i key2 = set_lanes(keys[2], keys[6]);
+	const __m256i key3 = set_lanes(keys[3], keys[7]);
+
+	__m256i state02 = load_lanes((const uint8_t*)state, 0);
+	__m256i state13 = load_lanes((const uint8_t*)state, 1);
+
+#	define TRANSFORM do { \
+		state02 = _mm256_aesdec_epi128(state02, key0); \
+		state13 = _mm256_aesenc_epi128(state13, key0); \
+		state02 = _mm256_aesdec_epi128(state02, key1); \
+		state13 = _mm256_aesenc_epi128(state13, key1); \
+		state02 = _mm256_aesdec_epi128(state02, key2); \
+		state13 = _mm256_aesenc_epi128(state13, key2); \
+		state02 = _mm256_aesdec_epi128(state02, key3); \
+		state13 = _mm256_aesenc_epi128(state13, key3); \
+	} while (0)
+
+	for (int i = 0; i < 2; ++i, outptr += 64) {
+		TRANSFORM;
+		store_lanes(outptr, 0, state02);
+		store_lanes(outptr, 1, state13);
+	}
+
+	constexpr randomx::Instruction inst{ 0xFF, 7, 7, 0xFF, 0xFFFFFFFFU };
+	alignas(32) static const randomx::Instruction inst_mask[4] = { inst, inst, inst, inst };
+	const __m256i mask = _mm256_load_si256(reinterpret_cast<const __m256i*>(inst_mask));
+
+	while (outptr < outputEnd) {
+		TRANSFORM;
+		store_lanes(outptr, 0, _mm256_and_si256(state02, mask));
+		store_lanes(outptr, 1, _mm256_and_si256(state13, mask));
+		outptr += 64;
+	}
+
+#	undef TRANSFORM
+}
+
+
+void hashAndFillAes1Rx4_vaes(void *scratchpad, size_t scratchpadSize, void *hash, void* fill_state)
+{
+	PROFILE_SCOPE(RandomX_AES);
+
+	uint8_t* scratchpadPtr = (uint8_t*)scratchpad;
+	const uint8_t* scratchpadEnd = scratchpadPtr + scratchpadSize;
+
+	__m256i hash_state02 = set_lanes(_mm_set_epi32(AES_HASH_1R_STATE0), _mm_set_epi32(AES_HASH_1R_STATE2));
+	__m256i hash_state13 = set_lanes(_mm_set_epi32(AES_HASH_1R_STATE1), _mm_set_epi32(AES_HASH_1R_STATE3));
+
+	const __m256i key02 = set_lanes(_mm_set_epi32(AES_GEN_1R_KEY0), _mm_set_epi32(AES_GEN_1R_KEY2));
+	const __m256i key13 = set_lanes(_mm_set_epi32(AES_GEN_1R_KEY1), _mm_set_epi32(AES_GEN_1R_KEY3));
+
+	__m256i fill_state02 = load_lanes((const uint8_t*)fill_state, 0);
+	__m256i fill_state13 = load_lanes((const uint8_t*)fill_state, 1);
+
+	constexpr int PREFETCH_DISTANCE = 7168;
+	const char* prefetchPtr = ((const char*)scratchpad) + PREFETCH_DISTANCE;
+	scratchpadEnd -= PREFETCH_DISTANCE;
+
+	for (int i = 0; i < 2; ++i) {
+		while (scratchpadPtr < scratchpadEnd) {
+			hash_state02 = _mm256_aesenc_epi128(hash_state02, load_lanes(scratchpadPtr, 0));
+			hash_state13 = _mm256_aesdec_epi128(hash_state13, load_lanes(scratchpadPtr, 1));
+			hash_state02 = _mm256_aesenc_epi128(hash_state02, load_lanes(scratchpadPtr + 64, 0));
+			hash_state13 = _mm256_aesdec_epi128(hash_state13, load_lanes(scratchpadPtr + 64, 1));
+
+			fill_state02 = _mm256_aesdec_epi128(fill_state02, key02);
+			fill_state13 = _mm256_aesenc_epi128(fill_state13, key13);
+			store_lanes(scratchpadPtr, 0, fill_state02);
+			store_lanes(scratchpadPtr, 1, fill_state13);
+
+			fill_state02 = _mm256_aesdec_epi128(fill_state02, key02);
+			fill_state13 = _mm256_aesenc_epi128(fill_state13, key13);
+			store_lanes(scratchpadPtr + 64, 0, fill_state02);
+			store_lanes(scratchpadPtr + 64, 1, fill_state13);
+
+			_mm_prefetch(prefetchPtr, _MM_HINT_T0);
+			_mm_prefetch(prefetchPtr + 64, _MM_HINT_T0);
+
+			scratchpadPtr += 128;
+			prefetchPtr += 128;
+		}
+		prefetchPtr = (const char*) scratchpad;
+		scratchpadEnd += PREFETCH_DISTANCE;
+	}
+
+	store_lanes((uint8_t*)fill_state, 0, fill_state02);
+	store_lanes((uint8_t*)fill_state, 1, fill_state13);
+
+	const __m256i xkey0 = _mm256_broadcastsi128_si256(_mm_set_epi32(AES_HASH_1R_XKEY0));
+	const __m256i xkey1 = _mm256_broadcastsi128_si256(_mm_set_epi32(AES_HASH_1R_XKEY1));
+
+	hash_state02 = _mm256_aesenc_epi128(hash_state02, xkey0);
+	hash_state13 = _mm256_aesdec_epi128(hash_state13, xkey0);
+
+	hash_state02 = _mm256_aesenc_epi128(hash_state02, xkey1);
+	hash_state13 = _mm256_aesdec_epi128(hash_state13, xkey1);
+
+	store_lanes((uint8_t*)hash, 0, hash_state02);
+	store_lanes((uint8_t*)hash, 1, hash_state13);
+}
@@ -35,6 +35,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 */
 
 #include <new>
+#include <chrono>
 #include <algorithm>
 #include <stdexcept>
 #include <cstring>
@@ -54,6 +55,11 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include "3rdparty/argon2/include/argon2.h"
 #include "3rdparty/argon2/lib/core.h"
 
+#ifdef XMRIG_ARM_SVE
+#   include "base/io/log/Log.h"
+#   include "base/io/log/Tags.h"
+#endif
+
 //static_assert(RANDOMX_ARGON_MEMORY % (RANDOMX_ARGON_LANES * ARGON2_SYNC_POINTS) == 0, "RANDOMX_ARGON_MEMORY - invalid value");
 static_assert(ARGON2_BLOCK_SIZE == randomx::ArgonBlockSize, "Unexpected value of ARGON2_BLOCK_SIZE");
 
@@ -71,6 +77,10 @@ namespace randomx {
 	template void deallocCache<DefaultAllocator>(randomx_cache* cache);
 	template void deallocCache<LargePageAllocator>(randomx_cache* cache);
 
+	static inline double elapsed(std::chrono::steady_clock::time_point from, std::chrono::steady_clock::time_point to) {
+		return std::chrono::duration<double, std::milli>(to - from).count();
+	}
+
 	void initCache(randomx_cache* cache, const void* key, size_t keySize) {
 		argon2_context context;
 
@@ -93,17 +103,26 @@ namespace randomx {
 		context.flags = ARGON2_DEFAULT_FLAGS;
 		context.version = ARGON2_VERSION_NUMBER;
 
+		const auto ts = std::chrono::steady_clock::now();
+
 		argon2_ctx_mem(&context, Argon2_d, cache->memory, RandomX_CurrentConfig.ArgonMemory * 1024);
 
+		const auto argon = std::chrono::steady_clock::now();
+
 		randomx::Blake2Generator gen(key, keySize);
 		for (uint32_t i = 0; i < RandomX_CurrentConfig.CacheAccesses; ++i) {
 			randomx::generateSuperscalar(cache->programs[i], gen);
 		}
+
+		cache->argonTime = elapsed(ts, argon);
+		cache->superscalarTime = elapsed(argon, std::chrono::steady_clock::now());
 	}
 
 	void initCacheCompile(randomx_cache* cache, const void* key, size_t keySize) {
 		initCache(cache, key, keySize);
 
+		const auto ts = std::chrono::steady_clock::now();
+
 #		ifdef XMRIG_SECURE_JIT
 		cache->jit->enableWriting();
 #		endif
@@ -115,6 +134,17 @@ namespace randomx {
 #		ifdef XMRIG_SECURE_JIT
 		cache->jit->enableExecution();
 #		endif
+
+#		ifdef XMRIG_ARM_SVE
+		// The SVE kernel is compared with the scalar code on every new cache, after a mismatch the generated code is used for good
+		if (cache->datasetInit == &initDataset_sve && !verifyDataset_sve(cache)) {
+			LOG_WARN("%s " YELLOW("SVE dataset init doesn't match the scalar code, switching to generated code"), xmrig::Tags::randomx());
+
+			cache->datasetInit = cache->jit->getDatasetInitFunc();
+		}
+#		endif
+
+		cache->superscalarTime += elapsed(ts, std::chrono::steady_clock::now());
 	}
 
 	constexpr uint64_t superscalarMul0 = 6364136223846793005ULL;
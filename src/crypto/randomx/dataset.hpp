@@ -47,6 +47,8 @@ struct randomx_cache {
 	randomx::CacheInitializeFunc* initialize;
 	randomx::DatasetInitFunc* datasetInit;
 	randomx::SuperscalarProgram programs[RANDOMX_CACHE_MAX_ACCESSES];
+	double argonTime = 0.0;			// ms, last initialization
+	double superscalarTime = 0.0;	// ms, program generation and JIT compilation
 
 	bool isInitialized() const {
 		return programs[0].getSize() != 0;
@@ -74,4 +76,11 @@ namespace randomx {
 	void initCacheCompile(randomx_cache*, const void*, size_t);
 	void initDatasetItem(randomx_cache* cache, uint8_t* out, uint64_t blockNumber);
 	void initDataset(randomx_cache* cache, uint8_t* dataset, uint32_t startBlock, uint32_t endBlock);
+
+#	ifdef XMRIG_ARM_SVE
+	uint32_t sveVectorLength();
+	bool isDatasetSveFailed();
+	bool verifyDataset_sve(randomx_cache* cache);
+	void initDataset_sve(randomx_cache* cache, uint8_t* dataset, uint32_t startBlock, uint32_t endBlock);
+#	endif
 }
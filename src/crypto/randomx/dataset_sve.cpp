@@ -0,0 +1,183 @@
+/*
+Copyright (c) 2018-2019, tevador    <tevador@gmail.com>
+Copyright (c) 2019-2024, SChernykh  <https://github.com/SChernykh>
+Copyright (c) 2019-2024, XMRig      <https://github.com/xmrig>, <support@xmrig.com>
+
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+	* Redistributions of source code must retain the above copyright
+	  notice, this list of conditions and the following disclaimer.
+	* Redistributions in binary form must reproduce the above copyright
+	  notice, this list of conditions and the following disclaimer in the
+	  documentation and/or other materials provided with the distribution.
+	* Neither the name of the copyright holder nor the
+	  names of its contributors may be used to endorse or promote products
+	  derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#include <arm_sve.h>
+#include <atomic>
+#include <cstring>
+#include <vector>
+
+#include "crypto/randomx/common.hpp"
+#include "crypto/randomx/dataset.hpp"
+#include "crypto/randomx/intrin_portable.h"
+#include "crypto/randomx/reciprocal.h"
+#include "crypto/randomx/superscalar.hpp"
+
+// Computes svcntd() dataset items at once, one item per 64-bit lane.
+// The superscalar programs are interpreted with vector instructions, cache reads are gathers and the result is scattered
+// back to the 64-byte dataset items, so the same binary scales with whatever vector length the CPU implements.
+
+namespace randomx {
+
+	constexpr uint64_t superscalarMul0 = 6364136223846793005ULL;
+	constexpr uint64_t superscalarAdd1 = 9298411001130361340ULL;
+	constexpr uint64_t superscalarAdd2 = 12065312585734608966ULL;
+	constexpr uint64_t superscalarAdd3 = 9306329213124626780ULL;
+	constexpr uint64_t superscalarAdd4 = 5281919268842080866ULL;
+	constexpr uint64_t superscalarAdd5 = 10536153434571861004ULL;
+	constexpr uint64_t superscalarAdd6 = 3398623926847679864ULL;
+	constexpr uint64_t superscalarAdd7 = 9549104520008361294ULL;
+
+	static inline void executeSuperscalar_sve(svbool_t pg, svuint64_t* (&r)[8], SuperscalarProgram& prog) {
+		for (unsigned j = 0; j < prog.getSize(); ++j) {
+			Instruction& instr = prog(j);
+			svuint64_t& dst = *r[instr.dst];
+			const svuint64_t& src = *r[instr.src];
+
+			switch ((SuperscalarInstructionType)instr.opcode)
+			{
+			case SuperscalarInstructionType::ISUB_R:
+				dst = svsub_u64_x(pg, dst, src);
+				break;
+			case SuperscalarInstructionType::IXOR_R:
+				dst = sveor_u64_x(pg, dst, src);
+				break;
+			case SuperscalarInstructionType::IADD_RS:
+				dst = svadd_u64_x(pg, dst, svlsl_n_u64_x(pg, src, instr.getModShift()));
+				break;
+			case SuperscalarInstructionType::IMUL_R:
+				dst = svmul_u64_x(pg, dst, src);
+				break;
+			case SuperscalarInstructionType::IROR_C:
+				{
+					const uint64_t shift = instr.getImm32() & 63;
+					dst = svorr_u64_x(pg, svlsr_n_u64_x(pg, dst, shift), svlsl_n_u64_x(pg, dst, (64 - shift) & 63));
+				}
+				break;
+			case SuperscalarInstructionType::IADD_C7:
+			case SuperscalarInstructionType::IADD_C8:
+			case SuperscalarInstructionType::IADD_C9:
+				dst = svadd_n_u64_x(pg, dst, signExtend2sCompl(instr.getImm32()));
+				break;
+			case SuperscalarInstructionType::IXOR_C7:
+			case SuperscalarInstructionType::IXOR_C8:
+			case SuperscalarInstructionType::IXOR_C9:
+				dst = sveor_n_u64_x(pg, dst, signExtend2sCompl(instr.getImm32()));
+				break;
+			case SuperscalarInstructionType::IMULH_R:
+				dst = svmulh_u64_x(pg, dst, src);
+				break;
+			case SuperscalarInstructionType::ISMULH_R:
+				dst = svreinterpret_u64_s64(svmulh_s64_x(pg, svreinterpret_s64_u64(dst), svreinterpret_s64_u64(src)));
+				break;
+			case SuperscalarInstructionType::IMUL_RCP:
+				dst = svmul_n_u64_x(pg, dst, randomx_reciprocal(instr.getImm32()));
+				break;
+			default:
+				UNREACHABLE;
+			}
+		}
+	}
+
+	static std::atomic<bool> sveFailed{ false };
+
+	uint32_t sveVectorLength() {
+		return static_cast<uint32_t>(svcntd());
+	}
+
+	bool isDatasetSveFailed() {
+		return sveFailed.load(std::memory_order_relaxed);
+	}
+
+	void initDataset_sve(randomx_cache* cache, uint8_t* dataset, uint32_t startItem, uint32_t endItem) {
+		const uint64_t mask  = (RandomX_CurrentConfig.ArgonMemory * ArgonBlockSize) / CacheLineSize - 1;
+		const uint64_t lanes = svcntd();
+
+		// Byte offset of every lane's item relative to the first item of the batch
+		const svuint64_t itemOffset = svindex_u64(0, CacheLineSize);
+
+		svuint64_t r0, r1, r2, r3, r4, r5, r6, r7;
+		svuint64_t* r[8] = { &r0, &r1, &r2, &r3, &r4, &r5, &r6, &r7 };
+
+		for (uint64_t itemNumber = startItem; itemNumber < endItem; itemNumber += lanes, dataset += lanes * CacheLineSize) {
+			const svbool_t pg = svwhilelt_b64_u64(itemNumber, endItem);
+			const svuint64_t items = svindex_u64(itemNumber, 1);
+
+			r0 = svmul_n_u64_x(pg, svadd_n_u64_x(pg, items, 1), superscalarMul0);
+			r1 = sveor_n_u64_x(pg, r0, superscalarAdd1);
+			r2 = sveor_n_u64_x(pg, r0, superscalarAdd2);
+			r3 = sveor_n_u64_x(pg, r0, superscalarAdd3);
+			r4 = sveor_n_u64_x(pg, r0, superscalarAdd4);
+			r5 = sveor_n_u64_x(pg, r0, superscalarAdd5);
+			r6 = sveor_n_u64_x(pg, r0, superscalarAdd6);
+			r7 = sveor_n_u64_x(pg, r0, superscalarAdd7);
+
+			svuint64_t registerValue = items;
+
+			for (unsigned i = 0; i < RandomX_CurrentConfig.CacheAccesses; ++i) {
+				const svuint64_t mixBlock = svlsl_n_u64_x(pg, svand_n_u64_x(pg, registerValue, mask), 6);
+				SuperscalarProgram& prog = cache->programs[i];
+
+				executeSuperscalar_sve(pg, r, prog);
+
+				for (unsigned q = 0; q < 8; ++q) {
+					const uint64_t* base = reinterpret_cast<const uint64_t*>(cache->memory + 8 * q);
+					*r[q] = sveor_u64_x(pg, *r[q], svld1_gather_u64offset_u64(pg, base, mixBlock));
+				}
+
+				registerValue = *r[prog.getAddressRegister()];
+			}
+
+			for (unsigned q = 0; q < 8; ++q) {
+				svst1_scatter_u64offset_u64(pg, reinterpret_cast<uint64_t*>(dataset + 8 * q), itemOffset, *r[q]);
+			}
+		}
+	}
+
+	// Two full vectors and a partial one, starting at an odd item so the batches don't line up with item 0
+	bool verifyDataset_sve(randomx_cache* cache) {
+		const uint32_t count = sveVectorLength() * 2 + 3;
+		std::vector<uint8_t> actual(static_cast<size_t>(count) * CacheLineSize);
+		alignas(16) uint8_t expected[CacheLineSize];
+
+		initDataset_sve(cache, actual.data(), 1, 1 + count);
+
+		for (uint32_t i = 0; i < count; ++i) {
+			initDatasetItem(cache, expected, 1 + i);
+
+			if (memcmp(expected, actual.data() + static_cast<size_t>(i) * CacheLineSize, CacheLineSize) != 0) {
+				sveFailed.store(true, std::memory_order_relaxed);
+
+				return false;
+			}
+		}
+
+		return true;
+	}
+}
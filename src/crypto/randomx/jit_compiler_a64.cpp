@@ -29,8 +29,10 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 */
 
 #include "crypto/randomx/jit_compiler_a64.hpp"
+#include "backend/cpu/Cpu.h"
 #include "crypto/common/VirtualMemory.h"
 #include "crypto/randomx/program.hpp"
+#include "crypto/randomx/dataset.hpp"
 #include "crypto/randomx/reciprocal.h"
 #include "crypto/randomx/superscalar.hpp"
 #include "crypto/randomx/virtual_memory.hpp"
@@ -48,6 +50,19 @@ void randomx_set_optimized_dataset_init(int value)
 	optimizedDatasetInit = value;
 }
 
+// The SVE kernel interprets the superscalar programs, it only beats the generated scalar code when
+// every vector holds at least 4 dataset items (256-bit SVE and wider), unless it is forced with "init-avx2"
+static bool useDatasetInitSve()
+{
+#	ifdef XMRIG_ARM_SVE
+	if ((optimizedDatasetInit != 0) && xmrig::Cpu::info()->has(xmrig::ICpuInfo::FLAG_SVE) && !randomx::isDatasetSveFailed()) {
+		return (optimizedDatasetInit > 0) || (randomx::sveVectorLength() >= 4);
+	}
+#	endif
+
+	return false;
+}
+
 namespace ARMV8A {
 
 constexpr uint32_t B           = 0x14000000;
@@ -112,12 +127,12 @@ JitCompilerA64::JitCompilerA64(bool hugePagesEnable, bool) :
 
 JitCompilerA64::~JitCompilerA64()
 {
-	freePagedMemory(code, allocatedSize);
+	xmrig::VirtualMemory::freeJitCode(jitCode);
 }
 
 void JitCompilerA64::generateProgram(Program& program, ProgramConfiguration& config, uint32_t)
 {
-	if (!allocatedSize) {
+	if (!code) {
 		allocate(CodeSize);
 	}
 #ifdef XMRIG_SECURE_JIT
@@ -175,7 +190,7 @@ void JitCompilerA64::generateProgram(Program& program, ProgramConfiguration& con
 
 void JitCompilerA64::generateProgramLight(Program& program, ProgramConfiguration& config, uint32_t datasetOffset)
 {
-	if (!allocatedSize) {
+	if (!code) {
 		allocate(CodeSize);
 	}
 #ifdef XMRIG_SECURE_JIT
@@ -240,7 +255,7 @@ void JitCompilerA64::generateProgramLight(Program& program, ProgramConfiguration
 template<size_t N>
 void JitCompilerA64::generateSuperscalarHash(SuperscalarProgram(&programs)[N])
 {
-	if (!allocatedSize) {
+	if (!code) {
 		allocate(CodeSize + CalcDatasetItemSize());
 	}
 #ifdef XMRIG_SECURE_JIT
@@ -372,9 +387,20 @@ DatasetInitFunc* JitCompilerA64::getDatasetInitFunc() const
 	enableExecution();
 #	endif
 
+#	ifdef XMRIG_ARM_SVE
+	if (useDatasetInitSve()) {
+		return &initDataset_sve;
+	}
+#	endif
+
 	return (DatasetInitFunc*)(code + (((uint8_t*)randomx_init_dataset_aarch64) - ((uint8_t*)randomx_program_aarch64)));
 }
 
+const char* JitCompilerA64::getDatasetInitVariant() const
+{
+	return useDatasetInitSve() ? "sve" : "jit";
+}
+
 size_t JitCompilerA64::getCodeSize()
 {
 	return CodeSize;
@@ -382,19 +408,23 @@ size_t JitCompilerA64::getCodeSize()
 
 void JitCompilerA64::enableWriting() const
 {
-	xmrig::VirtualMemory::protectRW(code, allocatedSize);
+	xmrig::VirtualMemory::protectJitCode(jitCode, false);
 }
 
 void JitCompilerA64::enableExecution() const
 {
-	xmrig::VirtualMemory::protectRX(code, allocatedSize);
+	xmrig::VirtualMemory::protectJitCode(jitCode, true);
 }
 
 
 void JitCompilerA64::allocate(size_t size)
 {
-	allocatedSize = size;
-	code = static_cast<uint8_t*>(allocExecutableMemory(allocatedSize, hugePages));
+	// Code base address is shifted by a per-instance color, so all threads use different L2/L3 cache sets
+	if (!xmrig::VirtualMemory::allocateJitCode(jitCode, size, 64 * 1024, hugePages)) {
+		throw std::runtime_error("Failed to allocate executable memory");
+	}
+
+	code = jitCode.code;
 
 	memcpy(code, reinterpret_cast<const void *>(randomx_program_aarch64), CodeSize);
 
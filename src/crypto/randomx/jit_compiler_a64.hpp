@@ -33,6 +33,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include <cstdint>
 #include <vector>
 #include <stdexcept>
+#include "crypto/common/VirtualMemory.h"
 #include "crypto/randomx/common.hpp"
 #include "crypto/randomx/jit_compiler_a64_static.hpp"
 
@@ -68,6 +69,7 @@ namespace randomx {
 		}
 
 		DatasetInitFunc* getDatasetInitFunc() const;
+		const char* getDatasetInitVariant() const;
 		uint8_t* getCode() { return code; }
 		size_t getCodeSize();
 
@@ -82,7 +84,7 @@ namespace randomx {
 		uint8_t* code = nullptr;
 		uint32_t literalPos;
 		uint32_t num32bitLiterals = 0;
-		size_t allocatedSize = 0;
+		xmrig::VirtualMemory::JitCode jitCode;
 
 		void allocate(size_t size);
 
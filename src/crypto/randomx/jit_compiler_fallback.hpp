@@ -66,6 +66,9 @@ namespace randomx {
 		DatasetInitFunc* getDatasetInitFunc() {
 			return nullptr;
 		}
+		const char* getDatasetInitVariant() const {
+			return "interpreter";
+		}
 		uint8_t* getCode() {
 			return nullptr;
 		}
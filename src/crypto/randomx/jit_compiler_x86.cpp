@@ -124,6 +124,12 @@ namespace randomx {
 	#define codeDatasetInitAVX2Epilogue ADDR(randomx_dataset_init_avx2_epilogue)
 	#define codeDatasetInitAVX2SshLoad ADDR(randomx_dataset_init_avx2_ssh_load)
 	#define codeDatasetInitAVX2SshPrefetch ADDR(randomx_dataset_init_avx2_ssh_prefetch)
+	#define codeDatasetInitAVX512Prologue ADDR(randomx_dataset_init_avx512_prologue)
+	#define codeDatasetInitAVX512LoopBegin ADDR(randomx_dataset_init_avx512_loop_begin)
+	#define codeDatasetInitAVX512LoopEnd ADDR(randomx_dataset_init_avx512_loop_end)
+	#define codeDatasetInitAVX512Epilogue ADDR(randomx_dataset_init_avx512_epilogue)
+	#define codeDatasetInitAVX512SshLoad ADDR(randomx_dataset_init_avx512_ssh_load)
+	#define codeDatasetInitAVX512SshPrefetch ADDR(randomx_dataset_init_avx512_ssh_prefetch)
 	#define codeLoopStore ADDR(randomx_program_loop_store)
 	#define codeLoopEnd ADDR(randomx_program_loop_end)
 	#define codeEpilogue ADDR(randomx_program_epilogue)
@@ -145,7 +151,13 @@ namespace randomx {
 	#define datasetInitAVX2LoopEndSize (codeDatasetInitAVX2Epilogue - codeDatasetInitAVX2LoopEnd)
 	#define datasetInitAVX2EpilogueSize (codeDatasetInitAVX2SshLoad - codeDatasetInitAVX2Epilogue)
 	#define datasetInitAVX2SshLoadSize (codeDatasetInitAVX2SshPrefetch - codeDatasetInitAVX2SshLoad)
-	#define datasetInitAVX2SshPrefetchSize (codeEpilogue - codeDatasetInitAVX2SshPrefetch)
+	#define datasetInitAVX2SshPrefetchSize (codeDatasetInitAVX512Prologue - codeDatasetInitAVX2SshPrefetch)
+	#define datasetInitAVX512PrologueSize (codeDatasetInitAVX512LoopBegin - codeDatasetInitAVX512Prologue)
+	#define datasetInitAVX512LoopBeginSize (codeDatasetInitAVX512LoopEnd - codeDatasetInitAVX512LoopBegin)
+	#define datasetInitAVX512LoopEndSize (codeDatasetInitAVX512Epilogue - codeDatasetInitAVX512LoopEnd)
+	#define datasetInitAVX512EpilogueSize (codeDatasetInitAVX512SshLoad - codeDatasetInitAVX512Epilogue)
+	#define datasetInitAVX512SshLoadSize (codeDatasetInitAVX512SshPrefetch - codeDatasetInitAVX512SshLoad)
+	#define datasetInitAVX512SshPrefetchSize (codeEpilogue - codeDatasetInitAVX512SshPrefetch)
 	#define epilogueSize (codeSshLoad - codeEpilogue)
 	#define codeSshLoadSize (codeSshPrefetch - codeSshLoad)
 	#define codeSshPrefetchSize (codeSshEnd - codeSshPrefetch)
@@ -189,26 +201,16 @@ namespace randomx {
 		{0x0F, 0x1F, 0x44, 0x00, 0x00, 0x2E, 0x2E, 0x2E, 0x2E, 0x2E, 0x2E, 0x2E, 0x2E},
 	};
 
-	static inline uint8_t* alignToPage(uint8_t* p, size_t pageSize) {
-		size_t k = (size_t) p;
-		k -= k % pageSize;
-		return (uint8_t*) k;
-	}
-
 	size_t JitCompilerX86::getCodeSize() {
 		return codePos < prologueSize ? 0 : codePos - prologueSize;
 	}
 
 	void JitCompilerX86::enableWriting() const {
-		uint8_t* p1 = alignToPage(code, 4096);
-		uint8_t* p2 = code + CodeSize;
-		xmrig::VirtualMemory::protectRW(p1, p2 - p1);
+		xmrig::VirtualMemory::protectJitCode(jitCode, false);
 	}
 
 	void JitCompilerX86::enableExecution() const {
-		uint8_t* p1 = alignToPage(code, 4096);
-		uint8_t* p2 = code + CodeSize;
-		xmrig::VirtualMemory::protectRX(p1, p2 - p1);
+		xmrig::VirtualMemory::protectJitCode(jitCode, true);
 	}
 
 #	ifdef _MSC_VER
@@ -217,8 +219,18 @@ namespace randomx {
 	static FORCE_INLINE uint32_t rotl32(uint32_t a, int shift) { return (a << shift) | (a >> (-shift & 31)); }
 #	endif
 
-	static std::atomic<size_t> codeOffset;
-	constexpr size_t codeOffsetIncrement = 59 * 64;
+	// EVEX.512.66.W1 instruction with register operands only: opcode zmm(reg), zmm(vvvv), zmm(rm)
+	// map: 1 = 0F, 2 = 0F38. For shifts by immediate "reg" is the opcode extension and "vvvv" is the destination.
+	static FORCE_INLINE void emitEVEX512(uint32_t map, uint8_t opcode, uint32_t reg, uint32_t vvvv, uint32_t rm, uint8_t* code, uint32_t& codePos)
+	{
+		code[codePos + 0] = 0x62;
+		code[codePos + 1] = static_cast<uint8_t>(((~reg & 8) << 4) | ((~rm & 16) << 2) | ((~rm & 8) << 2) | (~reg & 16) | map);
+		code[codePos + 2] = static_cast<uint8_t>(0x85 | ((~vvvv & 15) << 3));
+		code[codePos + 3] = static_cast<uint8_t>(0x40 | ((~vvvv & 16) >> 1));
+		code[codePos + 4] = opcode;
+		code[codePos + 5] = static_cast<uint8_t>(0xC0 | ((reg & 7) << 3) | (rm & 7));
+		codePos += 6;
+	}
 
 	JitCompilerX86::JitCompilerX86(bool hugePagesEnable, bool optimizedInitDatasetEnable) {
 		BranchesWithin32B = xmrig::Cpu::info()->jccErratum();
@@ -280,19 +292,45 @@ namespace randomx {
 			initDatasetAVX2 = false;
 		}
 
+		// Dataset init using AVX-512 (8 items per pass):
+		// -1 = Auto detect
+		// +2 = Always enabled
+		initDatasetAVX512 = false;
+
+		if (optimizedInitDatasetEnable && xmrig::Cpu::info()->has(xmrig::ICpuInfo::FLAG_AVX512DQ)) {
+			if (optimizedDatasetInit > 1) {
+				initDatasetAVX512 = true;
+			}
+			else if (optimizedDatasetInit < 0) {
+				switch (xmrig::Cpu::info()->arch()) {
+				case xmrig::ICpuInfo::ARCH_ZEN4:
+					// 512-bit ops are split in two halves on Zen4
+					initDatasetAVX512 = false;
+					break;
+				case xmrig::ICpuInfo::ARCH_ZEN5:
+					initDatasetAVX512 = true;
+					break;
+				default:
+					// Intel CPUs with AVX-512 have full width 64-bit multipliers
+					initDatasetAVX512 = (xmrig::Cpu::info()->vendor() == xmrig::ICpuInfo::VENDOR_INTEL);
+					break;
+				}
+			}
+		}
+
+		if (initDatasetAVX512) {
+			initDatasetAVX2 = false;
+		}
+
 		hasXOP = xmrig::Cpu::info()->hasXOP();
 
-		allocatedSize = initDatasetAVX2 ? (CodeSize * 4) : (CodeSize * 2);
-		allocatedCode = static_cast<uint8_t*>(allocExecutableMemory(allocatedSize,
-#			ifdef XMRIG_SECURE_JIT
-			false
-#			else
-			hugePagesJIT && hugePagesEnable
-#			endif
-		));
+		// Code base address is shifted by a per-instance color, so all threads use different L2/L3 cache sets
+		const size_t size = (initDatasetAVX2 || initDatasetAVX512) ? (CodeSize * 3) : CodeSize;
+		if (!xmrig::VirtualMemory::allocateJitCode(jitCode, size, CodeSize, hugePagesJIT && hugePagesEnable)) {
+			throw std::runtime_error("Failed to allocate executable memory");
+		}
 
-		// Shift code base address to improve caching - all threads will use different L2/L3 cache sets
-		code = allocatedCode + (codeOffset.fetch_add(codeOffsetIncrement) % CodeSize);
+		code = jitCode.code;
 
 		memcpy(code, codePrologue, prologueSize);
 		if (hasXOP) {
@@ -312,8 +350,7 @@ namespace randomx {
 	}
 
 	JitCompilerX86::~JitCompilerX86() {
-		codeOffset.fetch_sub(codeOffsetIncrement);
-		freePagedMemory(allocatedCode, allocatedSize);
+		xmrig::VirtualMemory::freeJitCode(jitCode);
 	}
 
 	template<size_t N>
@@ -360,6 +397,40 @@ namespace randomx {
 	template<size_t N>
 	void JitCompilerX86::generateSuperscalarHash(SuperscalarProgram(&programs)[N]) {
 		uint8_t* p = code;
+		if (initDatasetAVX512) {
+			codePos = 0;
+			emit(codeDatasetInitAVX512Prologue, datasetInitAVX512PrologueSize, code, codePos);
+
+			// mov eax, cache mask; vpbroadcastq zmm27, rax
+			emitByte(0xB8, code, codePos);
+			emit32(RandomX_CurrentConfig.ArgonMemory * 16 - 1, code, codePos);
+			emitEVEX512(2, 0x7C, 27, 0, 0, code, codePos);
+
+			const uint32_t loopBegin = codePos;
+			emit(codeDatasetInitAVX512LoopBegin, datasetInitAVX512LoopBeginSize, code, codePos);
+
+			for (unsigned j = 0; j < RandomX_CurrentConfig.CacheAccesses; ++j) {
+				SuperscalarProgram& prog = programs[j];
+				uint32_t pos = codePos;
+				for (uint32_t i = 0, n = prog.getSize(); i < n; ++i) {
+					generateSuperscalarCodeAVX512(prog(i), p, pos);
+				}
+				codePos = pos;
+				emit(codeDatasetInitAVX512SshLoad, datasetInitAVX512SshLoadSize, code, codePos);
+				if (j < RandomX_CurrentConfig.CacheAccesses - 1) {
+					// vpandq zmm28, zmm(address register), zmm27
+					emitEVEX512(1, 0xDB, 28, prog.getAddressRegister(), 27, code, codePos);
+					emit(codeDatasetInitAVX512SshPrefetch, datasetInitAVX512SshPrefetchSize, code, codePos);
+				}
+			}
+
+			emit(codeDatasetInitAVX512LoopEnd, datasetInitAVX512LoopEndSize, code, codePos);
+			*(int32_t*)(code + codePos - 4) = static_cast<int32_t>(loopBegin - codePos);
+
+			emit(codeDatasetInitAVX512Epilogue, datasetInitAVX512EpilogueSize, code, codePos);
+			return;
+		}
+
 		if (initDatasetAVX2) {
 			codePos = 0;
 			emit(codeDatasetInitAVX2Prologue, datasetInitAVX2PrologueSize, code, codePos);
@@ -416,8 +487,8 @@ namespace randomx {
 	void JitCompilerX86::generateSuperscalarHash(SuperscalarProgram(&programs)[RANDOMX_CACHE_MAX_ACCESSES]);
 
 	void JitCompilerX86::generateDatasetInitCode() {
-		// AVX2 code is generated in generateSuperscalarHash()
-		if (!initDatasetAVX2) {
+		// AVX2 and AVX-512 code is generated in generateSuperscalarHash()
+		if (!initDatasetAVX2 && !initDatasetAVX512) {
 			memcpy(code, codeDatasetInit, datasetInitSize);
 		}
 	}
@@ -738,6 +809,117 @@ namespace randomx {
 	template void JitCompilerX86::generateSuperscalarCode<false>(Instruction&, uint8_t*, uint32_t&);
 	template void JitCompilerX86::generateSuperscalarCode<true>(Instruction&, uint8_t*, uint32_t&);
 
+	// AVX-512 dataset init: zmm0-zmm7 hold registers r0-r7 of 8 dataset items, zmm8-zmm13 are temporaries, zmm29 = 0x00000000FFFFFFFF
+	void JitCompilerX86::generateSuperscalarCodeAVX512(Instruction& instr, uint8_t* code, uint32_t& codePos) {
+		enum : uint32_t { t0 = 8, t1, t2, t3, t4, t5, mask32 = 29 };
+
+		const uint32_t dst = instr.dst;
+		const uint32_t src = instr.src;
+
+		switch ((SuperscalarInstructionType)instr.opcode)
+		{
+		case randomx::SuperscalarInstructionType::ISUB_R:
+			emitEVEX512(1, 0xFB, dst, dst, src, code, codePos);		// vpsubq
+			break;
+		case randomx::SuperscalarInstructionType::IXOR_R:
+			emitEVEX512(1, 0xEF, dst, dst, src, code, codePos);		// vpxorq
+			break;
+		case randomx::SuperscalarInstructionType::IADD_RS:
+			if (instr.getModShift()) {
+				emitEVEX512(1, 0x73, 6, t0, src, code, codePos);		// vpsllq
+				emitByte(instr.getModShift(), code, codePos);
+				emitEVEX512(1, 0xD4, dst, dst, t0, code, codePos);	// vpaddq
+			}
+			else {
+				emitEVEX512(1, 0xD4, dst, dst, src, code, codePos);
+			}
+			break;
+		case randomx::SuperscalarInstructionType::IMUL_R:
+			emitEVEX512(2, 0x40, dst, dst, src, code, codePos);		// vpmullq
+			break;
+		case randomx::SuperscalarInstructionType::IROR_C:
+			emitEVEX512(1, 0x72, 0, dst, dst, code, codePos);		// vprorq
+			emitByte(instr.getImm32() & 63, code, codePos);
+			break;
+		case randomx::SuperscalarInstructionType::IADD_C7:
+		case randomx::SuperscalarInstructionType::IADD_C8:
+		case randomx::SuperscalarInstructionType::IADD_C9:
+		case randomx::SuperscalarInstructionType::IXOR_C7:
+		case randomx::SuperscalarInstructionType::IXOR_C8:
+		case randomx::SuperscalarInstructionType::IXOR_C9:
+			{
+				// mov rax, imm32 (sign extended); vpbroadcastq t0, rax
+				static const uint8_t t[] = { 0x48, 0xC7, 0xC0 };
+				emit(t, code, codePos);
+				emit32(instr.getImm32(), code, codePos);
+				emitEVEX512(2, 0x7C, t0, 0, 0, code, codePos);
+
+				const bool isAdd = (instr.opcode == static_cast<uint8_t>(SuperscalarInstructionType::IADD_C7)) ||
+				                   (instr.opcode == static_cast<uint8_t>(SuperscalarInstructionType::IADD_C8)) ||
+				                   (instr.opcode == static_cast<uint8_t>(SuperscalarInstructionType::IADD_C9));
+
+				emitEVEX512(1, isAdd ? 0xD4 : 0xEF, dst, dst, t0, code, codePos);
+			}
+			break;
+		case randomx::SuperscalarInstructionType::IMULH_R:
+		case randomx::SuperscalarInstructionType::ISMULH_R:
+			// 64x64 -> 128 bit multiplication from four 32x32 -> 64 bit partial products
+			emitEVEX512(1, 0x73, 2, t0, dst, code, codePos);		// vpsrlq t0, dst, 32
+			emitByte(32, code, codePos);
+			emitEVEX512(1, 0x73, 2, t1, src, code, codePos);		// vpsrlq t1, src, 32
+			emitByte(32, code, codePos);
+			emitEVEX512(1, 0xF4, t2, dst, src, code, codePos);		// lo * lo
+			emitEVEX512(1, 0xF4, t3, dst, t1, code, codePos);		// lo * hi
+			emitEVEX512(1, 0xF4, t4, t0, src, code, codePos);		// hi * lo
+			emitEVEX512(1, 0xF4, t0, t0, t1, code, codePos);		// hi * hi
+
+			// t2 = (lo * lo >> 32) + (lo * hi & mask32) + (hi * lo & mask32), carry into bits 32-33
+			emitEVEX512(1, 0x73, 2, t2, t2, code, codePos);
+			emitByte(32, code, codePos);
+			emitEVEX512(1, 0xDB, t5, t3, mask32, code, codePos);
+			emitEVEX512(1, 0xD4, t2, t2, t5, code, codePos);
+			emitEVEX512(1, 0xDB, t5, t4, mask32, code, codePos);
+			emitEVEX512(1, 0xD4, t2, t2, t5, code, codePos);
+
+			// t0 = hi * hi + (lo * hi >> 32) + (hi * lo >> 32) + (t2 >> 32)
+			emitEVEX512(1, 0x73, 2, t3, t3, code, codePos);
+			emitByte(32, code, codePos);
+			emitEVEX512(1, 0xD4, t0, t0, t3, code, codePos);
+			emitEVEX512(1, 0x73, 2, t4, t4, code, codePos);
+			emitByte(32, code, codePos);
+			emitEVEX512(1, 0xD4, t0, t0, t4, code, codePos);
+			emitEVEX512(1, 0x73, 2, t2, t2, code, codePos);
+			emitByte(32, code, codePos);
+
+			if (instr.opcode == static_cast<uint8_t>(SuperscalarInstructionType::IMULH_R)) {
+				emitEVEX512(1, 0xD4, dst, t0, t2, code, codePos);
+			}
+			else {
+				// signed high part = unsigned high part - (dst < 0 ? src : 0) - (src < 0 ? dst : 0)
+				emitEVEX512(1, 0xD4, t0, t0, t2, code, codePos);
+				emitEVEX512(1, 0x72, 4, t5, dst, code, codePos);		// vpsraq t5, dst, 63
+				emitByte(63, code, codePos);
+				emitEVEX512(1, 0xDB, t5, t5, src, code, codePos);
+				emitEVEX512(1, 0xFB, t0, t0, t5, code, codePos);
+				emitEVEX512(1, 0x72, 4, t5, src, code, codePos);		// vpsraq t5, src, 63
+				emitByte(63, code, codePos);
+				emitEVEX512(1, 0xDB, t5, t5, dst, code, codePos);
+				emitEVEX512(1, 0xFB, dst, t0, t5, code, codePos);
+			}
+			break;
+		case randomx::SuperscalarInstructionType::IMUL_RCP:
+			// mov rax, imm64; vpbroadcastq t0, rax; vpmullq dst, dst, t0
+			*(uint32_t*)(code + codePos) = 0x0000B848UL;
+			codePos += 2;
+			emit64(randomx_reciprocal_fast(instr.getImm32()), code, codePos);
+			emitEVEX512(2, 0x7C, t0, 0, 0, code, codePos);
+			emitEVEX512(2, 0x40, dst, dst, t0, code, codePos);
+			break;
+		default:
+			UNREACHABLE;
+		}
+	}
+
 	template<bool rax>
 	FORCE_INLINE void JitCompilerX86::genAddressReg(const Instruction& instr, const uint32_t src, uint8_t* code, uint32_t& codePos) {
 		*(uint32_t*)(code + codePos) = (rax ? 0x24808d41 : 0x24888d41) + (src << 16);
@@ -33,6 +33,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include <cstdint>
 #include <cstring>
 #include <vector>
+#include "crypto/common/VirtualMemory.h"
 #include "crypto/randomx/common.hpp"
 
 namespace randomx {
@@ -74,6 +75,10 @@ namespace randomx {
 			return (DatasetInitFunc*)code;
 		}
 
+		inline const char *getDatasetInitVariant() const {
+			return initDatasetAVX512 ? "avx512" : (initDatasetAVX2 ? "avx2" : "jit");
+		}
+
 		uint8_t* getCode() {
 			return code;
 		}
@@ -100,10 +105,10 @@ namespace randomx {
 		bool hasAVX;
 		bool hasAVX2;
 		bool initDatasetAVX2;
+		bool initDatasetAVX512;
 		bool hasXOP;
 
-		uint8_t* allocatedCode = nullptr;
-		size_t allocatedSize = 0;
+		xmrig::VirtualMemory::JitCode jitCode;
 
 		uint8_t* imul_rcp_storage = nullptr;
 		uint32_t imul_rcp_storage_used = 0;
@@ -118,6 +123,7 @@ namespace randomx {
 
 		template<bool AVX2>
 		void generateSuperscalarCode(Instruction& inst, uint8_t* code, uint32_t& codePos);
+		void generateSuperscalarCodeAVX512(Instruction& inst, uint8_t* code, uint32_t& codePos);
 
 		static void emitByte(uint8_t val, uint8_t* code, uint32_t& codePos) {
 			code[codePos] = val;
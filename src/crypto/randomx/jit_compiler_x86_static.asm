@@ -47,6 +47,12 @@ PUBLIC randomx_dataset_init_avx2_loop_end
 PUBLIC randomx_dataset_init_avx2_epilogue
 PUBLIC randomx_dataset_init_avx2_ssh_load
 PUBLIC randomx_dataset_init_avx2_ssh_prefetch
+PUBLIC randomx_dataset_init_avx512_prologue
+PUBLIC randomx_dataset_init_avx512_loop_begin
+PUBLIC randomx_dataset_init_avx512_loop_end
+PUBLIC randomx_dataset_init_avx512_epilogue
+PUBLIC randomx_dataset_init_avx512_ssh_load
+PUBLIC randomx_dataset_init_avx512_ssh_prefetch
 PUBLIC randomx_program_loop_store
 PUBLIC randomx_program_loop_end
 PUBLIC randomx_program_epilogue
@@ -284,6 +290,56 @@ randomx_dataset_init_avx2_ssh_prefetch PROC
 	include asm/program_sshash_avx2_ssh_prefetch.inc
 randomx_dataset_init_avx2_ssh_prefetch ENDP
 
+randomx_dataset_init_avx512_prologue PROC
+	include asm/program_sshash_avx2_save_registers.inc
+
+	mov rdi, qword ptr [rcx]		;# cache->memory
+	mov rsi, rdx					;# dataset
+	mov rbp, r8						;# block index
+	push r9							;# max. block index
+	sub rsp, 64
+
+	jmp avx512_constants_end
+	include asm/program_sshash_avx512_constants.inc
+
+avx512_constants_end:
+	vmovdqu64 zmm25, zmmword ptr [r0_avx512_increments]
+	vpbroadcastq zmm26, qword ptr [r0_avx512_one]
+	vpbroadcastq zmm24, qword ptr [r0_avx512_mul]
+	vpbroadcastq zmm17, qword ptr [r1_avx512_add]
+	vpbroadcastq zmm18, qword ptr [r2_avx512_add]
+	vpbroadcastq zmm19, qword ptr [r3_avx512_add]
+	vpbroadcastq zmm20, qword ptr [r4_avx512_add]
+	vpbroadcastq zmm21, qword ptr [r5_avx512_add]
+	vpbroadcastq zmm22, qword ptr [r6_avx512_add]
+	vpbroadcastq zmm23, qword ptr [r7_avx512_add]
+	vpbroadcastq zmm29, qword ptr [mask32_avx512_data]
+
+	;# zmm27 (cache mask) is set up by the generated code here
+randomx_dataset_init_avx512_prologue ENDP
+
+randomx_dataset_init_avx512_loop_begin PROC
+	include asm/program_sshash_avx512_loop_begin.inc
+randomx_dataset_init_avx512_loop_begin ENDP
+
+	;# generated SuperscalarHash code goes here
+
+randomx_dataset_init_avx512_loop_end PROC
+	include asm/program_sshash_avx512_loop_end.inc
+randomx_dataset_init_avx512_loop_end ENDP
+
+randomx_dataset_init_avx512_epilogue PROC
+	include asm/program_sshash_avx512_epilogue.inc
+randomx_dataset_init_avx512_epilogue ENDP
+
+randomx_dataset_init_avx512_ssh_load PROC
+	include asm/program_sshash_avx512_ssh_load.inc
+randomx_dataset_init_avx512_ssh_load ENDP
+
+randomx_dataset_init_avx512_ssh_prefetch PROC
+	include asm/program_sshash_avx512_ssh_prefetch.inc
+randomx_dataset_init_avx512_ssh_prefetch ENDP
+
 randomx_program_epilogue PROC
 	include asm/program_epilogue_store.inc
 	include asm/program_epilogue_win64.inc
@@ -50,6 +50,12 @@ extern "C" {
 	void randomx_dataset_init_avx2_epilogue();
 	void randomx_dataset_init_avx2_ssh_load();
 	void randomx_dataset_init_avx2_ssh_prefetch();
+	void randomx_dataset_init_avx512_prologue();
+	void randomx_dataset_init_avx512_loop_begin();
+	void randomx_dataset_init_avx512_loop_end();
+	void randomx_dataset_init_avx512_epilogue();
+	void randomx_dataset_init_avx512_ssh_load();
+	void randomx_dataset_init_avx512_ssh_prefetch();
 	void randomx_program_epilogue();
 	void randomx_sshash_load();
 	void randomx_sshash_prefetch();
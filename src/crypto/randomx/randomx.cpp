@@ -415,6 +415,10 @@ extern "C" {
 		delete cache;
 	}
 
+	const char *randomx_dataset_init_variant(const randomx_cache *cache) {
+		return (cache && cache->jit) ? cache->jit->getDatasetInitVariant() : "interpreter";
+	}
+
 	randomx_dataset *randomx_create_dataset(uint8_t *memory) {
 		if (!memory) {
 			return nullptr;
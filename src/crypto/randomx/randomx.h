@@ -205,6 +205,15 @@ RANDOMX_EXPORT void randomx_init_cache(randomx_cache *cache, const void *key, si
 */
 RANDOMX_EXPORT void randomx_release_cache(randomx_cache* cache);
 
+/**
+ * Name of the dataset initialization code selected for the cache.
+ *
+ * @param cache is a pointer to a previously allocated randomx_cache structure.
+ *
+ * @return "interpreter", "jit", "avx2" or "avx512".
+*/
+RANDOMX_EXPORT const char *randomx_dataset_init_variant(const randomx_cache *cache);
+
 /**
  * Creates a randomx_dataset structure and allocates memory for RandomX Dataset.
  *
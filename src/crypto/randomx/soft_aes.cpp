@@ -39,6 +39,9 @@ alignas(64) uint32_t lutDec1[256];
 alignas(64) uint32_t lutDec2[256];
 alignas(64) uint32_t lutDec3[256];
 
+alignas(64) uint8_t lutSbox[256];
+alignas(64) uint8_t lutInvSbox[256];
+
 static uint32_t mul_gf2(uint32_t b, uint32_t c)
 {
 	uint32_t s = 0;
@@ -85,6 +88,9 @@ static struct SAESInitializer
 		sbox[0] = 0x63;
 		sbox_reverse[0x63] = 0;
 
+		memcpy(lutSbox, sbox, sizeof(lutSbox));
+		memcpy(lutInvSbox, sbox_reverse, sizeof(lutInvSbox));
+
 		for (uint32_t i = 0; i < 0x100; ++i)
 		{
 			union
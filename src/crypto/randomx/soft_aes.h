@@ -41,6 +41,9 @@ extern uint32_t lutDec1[256];
 extern uint32_t lutDec2[256];
 extern uint32_t lutDec3[256];
 
+extern uint8_t lutSbox[256];
+extern uint8_t lutInvSbox[256];
+
 template<int soft> rx_vec_i128 aesenc(rx_vec_i128 in, rx_vec_i128 key);
 template<int soft> rx_vec_i128 aesdec(rx_vec_i128 in, rx_vec_i128 key);
 
@@ -138,6 +141,162 @@ FORCE_INLINE rx_vec_i128 aesdec<2>(rx_vec_i128 in, rx_vec_i128 key) {
 	return rx_xor_vec_i128(out, key);
 }
 
+/*
+	Compact soft AES for cores with a small L1D shared with the scratchpad (in-order ARM and RISC-V boards).
+	Variant 4 uses only the first encryption and decryption T-tables (2 KB) and rotates their words for the other columns.
+	Variant 5 uses the two S-boxes (512 bytes) and computes MixColumns on 32-bit words with xtime.
+*/
+FORCE_INLINE uint32_t soft_aes_ror(uint32_t x, int shift) {
+	return (x >> shift) | (x << (32 - shift));
+}
+
+FORCE_INLINE uint32_t soft_aes_xtime32(uint32_t x) {
+	return ((x & 0x7f7f7f7fU) << 1) ^ (((x >> 7) & 0x01010101U) * 0x1b);
+}
+
+FORCE_INLINE uint32_t soft_aes_mix_column(uint32_t a) {
+	const uint32_t t = a ^ soft_aes_ror(a, 8);
+
+	return soft_aes_xtime32(t) ^ soft_aes_ror(a, 8) ^ soft_aes_ror(t, 16);
+}
+
+FORCE_INLINE uint32_t soft_aes_inv_mix_column(uint32_t a) {
+	return soft_aes_mix_column(a ^ soft_aes_xtime32(soft_aes_xtime32(a ^ soft_aes_ror(a, 16))));
+}
+
+FORCE_INLINE uint32_t soft_aes_sub_word(const uint8_t* sbox, uint32_t b0, uint32_t b1, uint32_t b2, uint32_t b3) {
+	return sbox[b0] | (static_cast<uint32_t>(sbox[b1]) << 8) | (static_cast<uint32_t>(sbox[b2]) << 16) | (static_cast<uint32_t>(sbox[b3]) << 24);
+}
+
+template<>
+FORCE_INLINE rx_vec_i128 aesenc<4>(rx_vec_i128 in, rx_vec_i128 key) {
+	const uint32_t s0 = rx_vec_i128_w(in);
+	const uint32_t s1 = rx_vec_i128_z(in);
+	const uint32_t s2 = rx_vec_i128_y(in);
+	const uint32_t s3 = rx_vec_i128_x(in);
+
+	rx_vec_i128 out = rx_set_int_vec_i128(
+		(lutEnc0[s0 & 0xff] ^ soft_aes_ror(lutEnc0[(s3 >> 8) & 0xff], 24) ^ soft_aes_ror(lutEnc0[(s2 >> 16) & 0xff], 16) ^ soft_aes_ror(lutEnc0[s1 >> 24], 8)),
+		(lutEnc0[s1 & 0xff] ^ soft_aes_ror(lutEnc0[(s0 >> 8) & 0xff], 24) ^ soft_aes_ror(lutEnc0[(s3 >> 16) & 0xff], 16) ^ soft_aes_ror(lutEnc0[s2 >> 24], 8)),
+		(lutEnc0[s2 & 0xff] ^ soft_aes_ror(lutEnc0[(s1 >> 8) & 0xff], 24) ^ soft_aes_ror(lutEnc0[(s0 >> 16) & 0xff], 16) ^ soft_aes_ror(lutEnc0[s3 >> 24], 8)),
+		(lutEnc0[s3 & 0xff] ^ soft_aes_ror(lutEnc0[(s2 >> 8) & 0xff], 24) ^ soft_aes_ror(lutEnc0[(s1 >> 16) & 0xff], 16) ^ soft_aes_ror(lutEnc0[s0 >> 24], 8))
+	);
+
+	return rx_xor_vec_i128(out, key);
+}
+
+template<>
+FORCE_INLINE rx_vec_i128 aesdec<4>(rx_vec_i128 in, rx_vec_i128 key) {
+	const uint32_t s0 = rx_vec_i128_w(in);
+	const uint32_t s1 = rx_vec_i128_z(in);
+	const uint32_t s2 = rx_vec_i128_y(in);
+	const uint32_t s3 = rx_vec_i128_x(in);
+
+	rx_vec_i128 out = rx_set_int_vec_i128(
+		(lutDec0[s0 & 0xff] ^ soft_aes_ror(lutDec0[(s1 >> 8) & 0xff], 24) ^ soft_aes_ror(lutDec0[(s2 >> 16) & 0xff], 16) ^ soft_aes_ror(lutDec0[s3 >> 24], 8)),
+		(lutDec0[s1 & 0xff] ^ soft_aes_ror(lutDec0[(s2 >> 8) & 0xff], 24) ^ soft_aes_ror(lutDec0[(s3 >> 16) & 0xff], 16) ^ soft_aes_ror(lutDec0[s0 >> 24], 8)),
+		(lutDec0[s2 & 0xff] ^ soft_aes_ror(lutDec0[(s3 >> 8) & 0xff], 24) ^ soft_aes_ror(lutDec0[(s0 >> 16) & 0xff], 16) ^ soft_aes_ror(lutDec0[s1 >> 24], 8)),
+		(lutDec0[s3 & 0xff] ^ soft_aes_ror(lutDec0[(s0 >> 8) & 0xff], 24) ^ soft_aes_ror(lutDec0[(s1 >> 16) & 0xff], 16) ^ soft_aes_ror(lutDec0[s2 >> 24], 8))
+	);
+
+	return rx_xor_vec_i128(out, key);
+}
+
+template<>
+FORCE_INLINE rx_vec_i128 aesenc<5>(rx_vec_i128 in, rx_vec_i128 key) {
+	const uint32_t s0 = rx_vec_i128_w(in);
+	const uint32_t s1 = rx_vec_i128_z(in);
+	const uint32_t s2 = rx_vec_i128_y(in);
+	const uint32_t s3 = rx_vec_i128_x(in);
+
+	rx_vec_i128 out = rx_set_int_vec_i128(
+		soft_aes_mix_column(soft_aes_sub_word(lutSbox, s0 & 0xff, (s3 >> 8) & 0xff, (s2 >> 16) & 0xff, s1 >> 24)),
+		soft_aes_mix_column(soft_aes_sub_word(lutSbox, s1 & 0xff, (s0 >> 8) & 0xff, (s3 >> 16) & 0xff, s2 >> 24)),
+		soft_aes_mix_column(soft_aes_sub_word(lutSbox, s2 & 0xff, (s1 >> 8) & 0xff, (s0 >> 16) & 0xff, s3 >> 24)),
+		soft_aes_mix_column(soft_aes_sub_word(lutSbox, s3 & 0xff, (s2 >> 8) & 0xff, (s1 >> 16) & 0xff, s0 >> 24))
+	);
+
+	return rx_xor_vec_i128(out, key);
+}
+
+template<>
+FORCE_INLINE rx_vec_i128 aesdec<5>(rx_vec_i128 in, rx_vec_i128 key) {
+	const uint32_t s0 = rx_vec_i128_w(in);
+	const uint32_t s1 = rx_vec_i128_z(in);
+	const uint32_t s2 = rx_vec_i128_y(in);
+	const uint32_t s3 = rx_vec_i128_x(in);
+
+	rx_vec_i128 out = rx_set_int_vec_i128(
+		soft_aes_inv_mix_column(soft_aes_sub_word(lutInvSbox, s0 & 0xff, (s1 >> 8) & 0xff, (s2 >> 16) & 0xff, s3 >> 24)),
+		soft_aes_inv_mix_column(soft_aes_sub_word(lutInvSbox, s1 & 0xff, (s2 >> 8) & 0xff, (s3 >> 16) & 0xff, s0 >> 24)),
+		soft_aes_inv_mix_column(soft_aes_sub_word(lutInvSbox, s2 & 0xff, (s3 >> 8) & 0xff, (s0 >> 16) & 0xff, s1 >> 24)),
+		soft_aes_inv_mix_column(soft_aes_sub_word(lutInvSbox, s3 & 0xff, (s0 >> 8) & 0xff, (s1 >> 16) & 0xff, s2 >> 24))
+	);
+
+	return rx_xor_vec_i128(out, key);
+}
+
+#if defined(__aarch64__)
+/*
+	NEON soft AES for ARMv8 cores without the crypto extension (Cortex-A53/A55 boards).
+	S-box lookups are done with four 64-byte tbl/tbx lookups instead of T-tables, MixColumns with byte rotations.
+	InvMixColumns is MixColumns of (s ^ 4*s ^ rotate16(4*s)).
+*/
+FORCE_INLINE uint8x16_t soft_aes_sub_bytes(uint8x16_t x, const uint8_t* sbox) {
+	const uint8x16_t k = vdupq_n_u8(0x40);
+	uint8x16x4_t t;
+
+	t.val[0] = vld1q_u8(sbox +   0); t.val[1] = vld1q_u8(sbox +  16); t.val[2] = vld1q_u8(sbox +  32); t.val[3] = vld1q_u8(sbox +  48);
+	uint8x16_t r = vqtbl4q_u8(t, x);
+
+	t.val[0] = vld1q_u8(sbox +  64); t.val[1] = vld1q_u8(sbox +  80); t.val[2] = vld1q_u8(sbox +  96); t.val[3] = vld1q_u8(sbox + 112);
+	x = vsubq_u8(x, k);
+	r = vqtbx4q_u8(r, t, x);
+
+	t.val[0] = vld1q_u8(sbox + 128); t.val[1] = vld1q_u8(sbox + 144); t.val[2] = vld1q_u8(sbox + 160); t.val[3] = vld1q_u8(sbox + 176);
+	x = vsubq_u8(x, k);
+	r = vqtbx4q_u8(r, t, x);
+
+	t.val[0] = vld1q_u8(sbox + 192); t.val[1] = vld1q_u8(sbox + 208); t.val[2] = vld1q_u8(sbox + 224); t.val[3] = vld1q_u8(sbox + 240);
+	x = vsubq_u8(x, k);
+	return vqtbx4q_u8(r, t, x);
+}
+
+FORCE_INLINE uint8x16_t soft_aes_xtime(uint8x16_t x) {
+	const uint8x16_t carry = vreinterpretq_u8_s8(vshrq_n_s8(vreinterpretq_s8_u8(x), 7));
+	return veorq_u8(vshlq_n_u8(x, 1), vandq_u8(carry, vdupq_n_u8(0x1b)));
+}
+
+FORCE_INLINE uint8x16_t soft_aes_mix_columns(uint8x16_t s) {
+	static const uint8_t ror8[16] = { 1, 2, 3, 0, 5, 6, 7, 4, 9, 10, 11, 8, 13, 14, 15, 12 };
+	const uint8x16_t r8 = vld1q_u8(ror8);
+
+	const uint8x16_t t = soft_aes_xtime(s);
+	const uint8x16_t u = veorq_u8(s, vqtbl1q_u8(s, r8));
+
+	return veorq_u8(veorq_u8(t, vqtbl1q_u8(veorq_u8(t, s), r8)), vreinterpretq_u8_u16(vrev32q_u16(vreinterpretq_u16_u8(u))));
+}
+
+template<>
+FORCE_INLINE rx_vec_i128 aesenc<3>(rx_vec_i128 in, rx_vec_i128 key) {
+	static const uint8_t shift_rows[16] = { 0, 5, 10, 15, 4, 9, 14, 3, 8, 13, 2, 7, 12, 1, 6, 11 };
+
+	const uint8x16_t s = soft_aes_sub_bytes(vqtbl1q_u8(in, vld1q_u8(shift_rows)), lutSbox);
+
+	return veorq_u8(soft_aes_mix_columns(s), key);
+}
+
+template<>
+FORCE_INLINE rx_vec_i128 aesdec<3>(rx_vec_i128 in, rx_vec_i128 key) {
+	static const uint8_t inv_shift_rows[16] = { 0, 13, 10, 7, 4, 1, 14, 11, 8, 5, 2, 15, 12, 9, 6, 3 };
+
+	const uint8x16_t s = soft_aes_sub_bytes(vqtbl1q_u8(in, vld1q_u8(inv_shift_rows)), lutInvSbox);
+	const uint8x16_t s4 = soft_aes_xtime(soft_aes_xtime(s));
+
+	return veorq_u8(soft_aes_mix_columns(veorq_u8(veorq_u8(s, s4), vreinterpretq_u8_u16(vrev32q_u16(vreinterpretq_u16_u8(s4))))), key);
+}
+#endif
+
 template<>
 FORCE_INLINE rx_vec_i128 aesenc<0>(rx_vec_i128 in, rx_vec_i128 key) {
 	return rx_aesenc_vec_i128(in, key);
@@ -18,15 +18,24 @@
  */
 
 #include "crypto/rx/Rx.h"
+#include "3rdparty/rapidjson/document.h"
 #include "backend/cpu/Cpu.h"
 #include "backend/cpu/CpuConfig.h"
 #include "backend/cpu/CpuThreads.h"
+#include "base/kernel/Process.h"
+#include "crypto/rx/RxBuildStats.h"
 #include "crypto/rx/RxConfig.h"
 #include "crypto/rx/RxQueue.h"
+#include "crypto/rx/RxScrubber.h"
 #include "crypto/randomx/randomx.h"
 #include "crypto/randomx/aes_hash.hpp"
 
 
+#ifdef XMRIG_OS_LINUX
+#   include "crypto/rx/RxHandoff.h"
+#endif
+
+
 #ifdef XMRIG_FEATURE_MSR
 #   include "crypto/rx/RxFix.h"
 #   include "crypto/rx/RxMsr.h"
@@ -55,6 +64,12 @@ public:
 } // namespace xmrig
 
 
+bool xmrig::Rx::isPending()
+{
+    return d_ptr->queue.isPending();
+}
+
+
 xmrig::HugePagesInfo xmrig::Rx::hugePages()
 {
     return d_ptr->queue.hugePages();
@@ -67,12 +82,22 @@ xmrig::RxDataset *xmrig::Rx::dataset(const Job &job, uint32_t nodeId)
 }
 
 
+rapidjson::Value xmrig::Rx::toJSON(rapidjson::Document &doc)
+{
+    return d_ptr->queue.toJSON(doc);
+}
+
+
 void xmrig::Rx::destroy()
 {
 #   ifdef XMRIG_FEATURE_MSR
     RxMsr::destroy();
 #   endif
 
+#   ifdef XMRIG_OS_LINUX
+    RxHandoff::destroy();
+#   endif
+
     delete d_ptr;
 
     d_ptr = nullptr;
@@ -82,6 +107,8 @@ void xmrig::Rx::destroy()
 void xmrig::Rx::init(IRxListener *listener)
 {
     d_ptr = new RxPrivate(listener);
+
+    RxBuildStats::init(Process::location(Process::DataLocation, "rx-builds.json"));
 }
 
 
@@ -135,6 +162,11 @@ bool xmrig::Rx::init(const T &seed, const RxConfig &config, const CpuConfig &cpu
     randomx_set_scratchpad_prefetch_mode(config.scratchpadPrefetchMode());
     randomx_set_huge_pages_jit(cpu.isHugePagesJit());
     randomx_set_optimized_dataset_init(config.initDatasetAVX2());
+    RxScrubber::setRate(config.scrub());
+
+#   ifdef XMRIG_OS_LINUX
+    RxHandoff::setPath(config.handoff());
+#   endif
 
     if (!osInitialized) {
 #       ifdef XMRIG_FIX_RYZEN
@@ -144,6 +176,9 @@ bool xmrig::Rx::init(const T &seed, const RxConfig &config, const CpuConfig &cpu
         if (!cpu.isHwAES()) {
             SelectSoftAESImpl(cpu.threads().get(seed.algorithm()).count());
         }
+        else {
+            SelectHardAESImpl(cpu.threads().get(seed.algorithm()).count());
+        }
 
 #       if defined(XMRIG_FEATURE_SSE4_1)
         if (Cpu::info()->has(ICpuInfo::FLAG_SSE41)) {
@@ -26,6 +26,7 @@
 #include <vector>
 
 
+#include "3rdparty/rapidjson/fwd.h"
 #include "crypto/common/HugePagesInfo.h"
 
 
@@ -45,8 +46,10 @@ class RxDataset;
 class Rx
 {
 public:
+    static bool isPending();
     static HugePagesInfo hugePages();
     static RxDataset *dataset(const Job &job, uint32_t nodeId);
+    static rapidjson::Value toJSON(rapidjson::Document &doc);
     static void destroy();
     static void init(IRxListener *listener);
     template<typename T> static bool init(const T &seed, const RxConfig &config, const CpuConfig &cpu);
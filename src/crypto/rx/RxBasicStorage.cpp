@@ -18,13 +18,25 @@
  */
 
 #include "crypto/rx/RxBasicStorage.h"
+#include "3rdparty/rapidjson/document.h"
 #include "base/io/log/Log.h"
 #include "base/io/log/Tags.h"
 #include "base/tools/Chrono.h"
+#include "crypto/common/VirtualMemory.h"
 #include "crypto/rx/RxAlgo.h"
+#include "crypto/rx/RxBuildStats.h"
 #include "crypto/rx/RxCache.h"
 #include "crypto/rx/RxDataset.h"
 #include "crypto/rx/RxSeed.h"
+#include "crypto/randomx/randomx.h"
+
+
+#include <algorithm>
+
+
+#ifdef XMRIG_OS_LINUX
+#   include "crypto/rx/RxHandoff.h"
+#endif
 
 
 namespace xmrig {
@@ -50,6 +62,10 @@ public:
     {
         m_ready = false;
 
+        if (m_dataset) {
+            m_dataset->stopScrubber();
+        }
+
         if (m_seed.algorithm() != seed.algorithm()) {
             RxAlgo::apply(seed.algorithm());
         }
@@ -62,7 +78,17 @@ public:
     {
         const uint64_t ts = Chrono::steadyMSecs();
 
-        m_dataset = new RxDataset(hugePages, oneGbPages, true, mode, 0);
+        VirtualMemory *memory = nullptr;
+
+#       ifdef XMRIG_OS_LINUX
+        // Ask a running instance for its dataset first, nothing is allocated for the dataset if it hands it over.
+        if (mode != RxConfig::LightMode) {
+            memory     = RxHandoff::receive(m_seed);
+            m_received = memory != nullptr;
+        }
+#       endif
+
+        m_dataset = new RxDataset(hugePages, oneGbPages, true, mode, 0, memory);
         if (!m_dataset->cache()->get()) {
             deleteDataset();
 
@@ -73,23 +99,78 @@ public:
 
         printAllocStatus(ts);
 
+        m_alloc = static_cast<double>(Chrono::steadyMSecs() - ts);
+
         return true;
     }
 
 
     inline void initDataset(uint32_t threads, int priority)
     {
-        const uint64_t ts = Chrono::steadyMSecs();
+        const uint64_t ts  = Chrono::steadyMSecs();
+        const double start = Chrono::highResolutionMSecs();
+        auto build         = RxBuildStats::create(m_seed);
+
+#       ifdef XMRIG_OS_LINUX
+        // The dataset memory was handed off to a new instance and this one is exiting, it must not be rebuilt.
+        if (!RxHandoff::revoke()) {
+            return;
+        }
+#       endif
+
+        if (m_received) {
+            build.mode = "handoff";
+            build.copy = m_alloc;
 
-        m_ready = m_dataset->init(m_seed.data(), threads, priority);
+            m_dataset->cache()->init(m_seed.data());
+            m_dataset->startScrubber();
+            m_received = false;
+            m_ready    = true;
+        }
+        else {
+            build.threads = std::max(threads, 1U);
+
+            m_ready = m_dataset->init(m_seed.data(), threads, priority);
+        }
 
         if (m_ready) {
             LOG_INFO("%s" GREEN_BOLD("dataset ready") BLACK_BOLD(" (%" PRIu64 " ms)"), Tags::randomx(), Chrono::steadyMSecs() - ts);
+
+            addBuildStats(build, Chrono::highResolutionMSecs() - start);
+
+#           ifdef XMRIG_OS_LINUX
+            RxHandoff::publish(m_seed, m_dataset);
+#           endif
         }
     }
 
 
 private:
+    void addBuildStats(RxBuildStats::Build &build, double total)
+    {
+        const RxCache *cache = m_dataset->cache();
+
+        build.variant     = cache->variant();
+        build.argon2      = cache->argon2Time();
+        build.superscalar = cache->superscalarTime();
+        build.total       = total;
+        build.alloc       = m_alloc;
+        build.hugePages   = m_dataset->hugePages().percent();
+
+        if (!m_dataset->get()) {
+            build.mode = "light";
+        }
+        else if (build.threads) {
+            build.dataset = std::max(total - build.argon2 - build.superscalar, 0.0);
+            build.rate    = build.dataset > 0.0 ? randomx_dataset_item_count() / build.dataset / build.threads : 0.0;
+        }
+
+        m_alloc = 0.0;
+
+        RxBuildStats::add(build);
+    }
+
+
     void printAllocStatus(uint64_t ts)
     {
         if (m_dataset->get() != nullptr) {
@@ -115,6 +196,8 @@ private:
 
 
     bool m_ready         = false;
+    bool m_received      = false;
+    double m_alloc       = 0.0;
     RxDataset *m_dataset = nullptr;
     RxSeed m_seed;
 };
@@ -161,6 +244,12 @@ xmrig::RxDataset *xmrig::RxBasicStorage::dataset(const Job &job, uint32_t) const
 }
 
 
+rapidjson::Value xmrig::RxBasicStorage::toJSON(rapidjson::Document &) const
+{
+    return rapidjson::Value(rapidjson::kNullType);
+}
+
+
 void xmrig::RxBasicStorage::init(const RxSeed &seed, uint32_t threads, bool hugePages, bool oneGbPages, RxConfig::Mode mode, int priority)
 {
     d_ptr->setSeed(seed);
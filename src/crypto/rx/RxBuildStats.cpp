@@ -0,0 +1,234 @@
+/* XMRig
+ * Copyright (c) 2018-2024 SChernykh   <https://github.com/SChernykh>
+ * Copyright (c) 2016-2024 XMRig       <https://github.com/xmrig>, <support@xmrig.com>
+ *
+ *   This program is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "crypto/rx/RxBuildStats.h"
+#include "3rdparty/rapidjson/document.h"
+#include "backend/cpu/Cpu.h"
+#include "base/io/json/Json.h"
+#include "base/io/log/Log.h"
+#include "base/io/log/Tags.h"
+#include "base/tools/Chrono.h"
+#include "base/tools/Cvt.h"
+#include "crypto/rx/RxSeed.h"
+
+
+#include <deque>
+#include <mutex>
+
+
+namespace xmrig {
+
+
+constexpr size_t kHistory       = 16;
+constexpr double kRegression    = 0.2;  // slower than the average of comparable builds by this fraction
+
+
+static std::deque<RxBuildStats::Build> history;
+static std::mutex mutex;
+static String fileName;
+
+
+// Builds with the same algorithm, mode, strategy and thread count, memory allocation time isn't part of the comparison.
+static inline bool isComparable(const RxBuildStats::Build &a, const RxBuildStats::Build &b)
+{
+    return a.algorithm == b.algorithm && a.threads == b.threads && a.nodes == b.nodes && a.mode == b.mode && a.strategy == b.strategy;
+}
+
+
+// Build times of another CPU are not comparable, a shared data directory keeps one history per CPU.
+static String fingerprint()
+{
+    return Cpu::info()->brand();
+}
+
+
+static rapidjson::Value toJSON(const RxBuildStats::Build &build, rapidjson::Document &doc)
+{
+    using namespace rapidjson;
+    auto &allocator = doc.GetAllocator();
+
+    Value item(kObjectType);
+    item.AddMember("ts",            build.ts, allocator);
+    item.AddMember("algo",          build.algorithm.toJSON(), allocator);
+    item.AddMember("seed",          build.seed.toJSON(doc), allocator);
+    item.AddMember("mode",          build.mode.toJSON(doc), allocator);
+    item.AddMember("strategy",      build.strategy.toJSON(doc), allocator);
+    item.AddMember("variant",       build.variant.toJSON(doc), allocator);
+    item.AddMember("nodes",         build.nodes, allocator);
+    item.AddMember("threads",       build.threads, allocator);
+    item.AddMember("alloc",         build.alloc, allocator);
+    item.AddMember("argon2",        build.argon2, allocator);
+    item.AddMember("superscalar",   build.superscalar, allocator);
+    item.AddMember("dataset",       build.dataset, allocator);
+    item.AddMember("copy",          build.copy, allocator);
+    item.AddMember("total",         build.total, allocator);
+    item.AddMember("rate",          build.rate, allocator);
+    item.AddMember("hugepages",     build.hugePages, allocator);
+
+    return item;
+}
+
+
+static void save()
+{
+    using namespace rapidjson;
+
+    if (fileName.isEmpty()) {
+        return;
+    }
+
+    Document doc;
+    if (!Json::get(fileName, doc) || !doc.IsObject()) {
+        doc.SetObject();
+    }
+
+    auto &allocator = doc.GetAllocator();
+    const String key = fingerprint();
+
+    Value builds(kArrayType);
+    for (const auto &build : history) {
+        builds.PushBack(toJSON(build, doc), allocator);
+    }
+
+    doc.RemoveMember(key.data());
+    doc.AddMember(key.toJSON(doc), builds, allocator);
+
+    if (!Json::save(fileName, doc)) {
+        LOG_WARN("%s" YELLOW("failed to save dataset build history to \"%s\""), Tags::randomx(), fileName.data());
+    }
+}
+
+
+} // namespace xmrig
+
+
+xmrig::RxBuildStats::Build xmrig::RxBuildStats::create(const RxSeed &seed)
+{
+    Build build;
+    build.algorithm = seed.algorithm();
+    build.seed      = Cvt::toHex(seed.data().data(), 8);
+
+    return build;
+}
+
+
+rapidjson::Value xmrig::RxBuildStats::toJSON(rapidjson::Document &doc)
+{
+    using namespace rapidjson;
+    auto &allocator = doc.GetAllocator();
+
+    Value out(kArrayType);
+
+    std::lock_guard<std::mutex> lock(mutex);
+
+    for (const auto &build : history) {
+        out.PushBack(xmrig::toJSON(build, doc), allocator);
+    }
+
+    return out;
+}
+
+
+void xmrig::RxBuildStats::add(Build &build)
+{
+    build.ts = Chrono::currentMSecsSinceEpoch();
+
+    std::lock_guard<std::mutex> lock(mutex);
+
+    double sum      = 0.0;
+    size_t count    = 0;
+
+    for (const auto &item : history) {
+        if (isComparable(item, build) && item.total > 0.0) {
+            sum += item.total;
+            ++count;
+        }
+    }
+
+    const double change = count ? build.total / (sum / count) - 1.0 : 0.0;
+
+    LOG_V1("%s" CYAN_BOLD("-- ") "%s build: argon2 " CYAN("%.0f") " superscalar " CYAN("%.0f") " dataset " CYAN("%.0f") " copy " CYAN("%.0f") " alloc " CYAN("%.0f") " ms, "
+           CYAN("%.1f") " items/ms/thread, huge pages %.0f%%, %s" BLACK_BOLD(" (%+.1f%% vs %zu previous)"),
+           Tags::randomx(), build.mode.data(), build.argon2, build.superscalar, build.dataset, build.copy, build.alloc,
+           build.rate, build.hugePages, build.variant.isNull() ? "n/a" : build.variant.data(), change * 100.0, count);
+
+    if (count && change > kRegression) {
+        LOG_WARN("%s" YELLOW_BOLD("dataset build %.0f ms is %.0f%% slower") YELLOW(" than the average of %zu previous builds (argon2 %.0f ms, dataset %.0f ms, copy %.0f ms)"),
+                 Tags::randomx(), build.total, change * 100.0, count, build.argon2, build.dataset, build.copy);
+    }
+
+    history.push_back(build);
+    if (history.size() > kHistory) {
+        history.pop_front();
+    }
+
+    save();
+}
+
+
+void xmrig::RxBuildStats::init(const String &fileName)
+{
+    std::lock_guard<std::mutex> lock(mutex);
+
+    xmrig::fileName = fileName;
+    history.clear();
+
+    rapidjson::Document doc;
+    if (fileName.isEmpty() || !Json::get(fileName, doc) || !doc.IsObject()) {
+        return;
+    }
+
+    const String key    = fingerprint();
+    const auto &builds  = Json::getArray(doc, key.data());
+    if (!builds.IsArray()) {
+        return;
+    }
+
+    for (const auto &item : builds.GetArray()) {
+        if (!item.IsObject()) {
+            continue;
+        }
+
+        Build build;
+        build.algorithm     = Json::getValue(item, "algo");
+        build.seed          = Json::getString(item, "seed");
+        build.mode          = Json::getString(item, "mode", "fast");
+        build.strategy      = Json::getString(item, "strategy");
+        build.variant       = Json::getString(item, "variant");
+        build.nodes         = Json::getUint(item, "nodes", 1);
+        build.threads       = Json::getUint(item, "threads");
+        build.alloc         = Json::getDouble(item, "alloc");
+        build.argon2        = Json::getDouble(item, "argon2");
+        build.superscalar   = Json::getDouble(item, "superscalar");
+        build.dataset       = Json::getDouble(item, "dataset");
+        build.copy          = Json::getDouble(item, "copy");
+        build.total         = Json::getDouble(item, "total");
+        build.rate          = Json::getDouble(item, "rate");
+        build.hugePages     = Json::getDouble(item, "hugepages");
+        build.ts            = Json::getUint64(item, "ts");
+
+        if (!build.algorithm.isValid()) {
+            continue;
+        }
+
+        history.push_back(build);
+        if (history.size() > kHistory) {
+            history.pop_front();
+        }
+    }
+}
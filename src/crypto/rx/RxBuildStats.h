@@ -0,0 +1,74 @@
+/* XMRig
+ * Copyright (c) 2018-2024 SChernykh   <https://github.com/SChernykh>
+ * Copyright (c) 2016-2024 XMRig       <https://github.com/xmrig>, <support@xmrig.com>
+ *
+ *   This program is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef XMRIG_RX_BUILDSTATS_H
+#define XMRIG_RX_BUILDSTATS_H
+
+
+#include "3rdparty/rapidjson/fwd.h"
+#include "base/crypto/Algorithm.h"
+#include "base/tools/String.h"
+
+
+namespace xmrig
+{
+
+
+class RxSeed;
+
+
+/**
+ * Telemetry of the last dataset builds (cache builds in light mode), one record per epoch: time of every stage,
+ * item build rate, huge page coverage and the dataset init code. Every build is compared with the previous builds
+ * of the same algorithm, mode and thread count, a slower one is reported as a regression. The history is kept
+ * in "rx-builds.json" in the data directory, so the comparison survives restarts.
+ */
+class RxBuildStats
+{
+public:
+    struct Build
+    {
+        Algorithm algorithm;
+        String seed;
+        String mode             = "fast";   // fast, light or handoff
+        String strategy;                    // distributed or independent, NUMA builds only
+        String variant;                     // dataset init code
+        uint32_t nodes          = 1;
+        uint32_t threads        = 0;
+        double alloc            = 0.0;      // ms, only the first build after memory allocation
+        double argon2           = 0.0;      // ms
+        double superscalar      = 0.0;      // ms, program generation and JIT compilation
+        double dataset          = 0.0;      // ms, dataset items
+        double copy             = 0.0;      // ms, NUMA exchange or live upgrade import
+        double total            = 0.0;      // ms, without allocation
+        double rate             = 0.0;      // dataset items per ms per thread
+        double hugePages        = 0.0;      // %
+        uint64_t ts             = 0;
+    };
+
+    static Build create(const RxSeed &seed);
+    static rapidjson::Value toJSON(rapidjson::Document &doc);
+    static void add(Build &build);
+    static void init(const String &fileName);
+};
+
+
+} /* namespace xmrig */
+
+
+#endif /* XMRIG_RX_BUILDSTATS_H */
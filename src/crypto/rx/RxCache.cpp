@@ -27,6 +27,7 @@
 
 #include "crypto/rx/RxCache.h"
 #include "crypto/common/VirtualMemory.h"
+#include "crypto/randomx/dataset.hpp"
 #include "crypto/randomx/randomx.h"
 
 
@@ -35,7 +36,7 @@ static_assert(RANDOMX_FLAG_JIT == 8, "RANDOMX_FLAG_JIT flag mismatch");
 
 xmrig::RxCache::RxCache(bool hugePages, uint32_t nodeId)
 {
-    m_memory = new VirtualMemory(maxSize(), hugePages, false, false, nodeId);
+    m_memory = new VirtualMemory(maxSize(), hugePages, false, false, nodeId, 64, true);
 
     create(m_memory->raw());
 }
@@ -57,6 +58,9 @@ xmrig::RxCache::~RxCache()
 
 bool xmrig::RxCache::init(const Buffer &seed)
 {
+    m_argon2      = 0.0;
+    m_superscalar = 0.0;
+
     if (m_seed == seed) {
         return false;
     }
@@ -66,6 +70,9 @@ bool xmrig::RxCache::init(const Buffer &seed)
     if (m_cache) {
         randomx_init_cache(m_cache, m_seed.data(), m_seed.size());
 
+        m_argon2      = m_cache->argonTime;
+        m_superscalar = m_cache->superscalarTime;
+
         return true;
     }
 
@@ -73,6 +80,12 @@ bool xmrig::RxCache::init(const Buffer &seed)
 }
 
 
+const char *xmrig::RxCache::variant() const
+{
+    return randomx_dataset_init_variant(m_cache);
+}
+
+
 xmrig::HugePagesInfo xmrig::RxCache::hugePages() const
 {
     return m_memory ? m_memory->hugePages() : HugePagesInfo();
@@ -54,11 +54,14 @@ public:
     ~RxCache();
 
     inline bool isJIT() const               { return m_jit; }
+    inline double argon2Time() const        { return m_argon2; }
+    inline double superscalarTime() const   { return m_superscalar; }
     inline const Buffer &seed() const       { return m_seed; }
     inline randomx_cache *get() const       { return m_cache; }
     inline size_t size() const              { return maxSize(); }
 
     bool init(const Buffer &seed);
+    const char *variant() const;
     HugePagesInfo hugePages() const;
 
     static inline constexpr size_t maxSize() { return RANDOMX_CACHE_MAX_SIZE; }
@@ -68,6 +71,8 @@ private:
 
     bool m_jit              = true;
     Buffer m_seed;
+    double m_argon2         = 0.0;  // ms, last init() that rebuilt the cache, 0 otherwise
+    double m_superscalar    = 0.0;  // ms, includes JIT compilation of the dataset init code
     randomx_cache *m_cache  = nullptr;
     VirtualMemory *m_memory = nullptr;
 };
@@ -43,6 +43,12 @@ const char *RxConfig::kRdmsr                    = "rdmsr";
 const char *RxConfig::kWrmsr                    = "wrmsr";
 const char *RxConfig::kScratchpadPrefetchMode   = "scratchpad_prefetch_mode";
 const char *RxConfig::kCacheQoS                 = "cache_qos";
+const char *RxConfig::kScrub                    = "scrub";
+const char *RxConfig::kAutoThreads              = "auto-threads";
+
+#ifdef XMRIG_OS_LINUX
+const char *RxConfig::kHandoff                  = "handoff";
+#endif
 
 #ifdef XMRIG_FEATURE_HWLOC
 const char *RxConfig::kNUMA                     = "numa";
@@ -88,18 +94,15 @@ bool xmrig::RxConfig::read(const rapidjson::Value &value)
 #       endif
 
         m_cacheQoS = Json::getBool(value, kCacheQoS, m_cacheQoS);
+        m_scrub    = Json::getUint(value, kScrub, m_scrub);
+        m_autoThreads = Json::getUint(value, kAutoThreads, m_autoThreads);
 
 #       ifdef XMRIG_OS_LINUX
         m_oneGbPages = Json::getBool(value, kOneGbPages, m_oneGbPages);
+        m_handoff    = Json::getString(value, kHandoff);
 #       endif
 
 #       ifdef XMRIG_FEATURE_HWLOC
-        if (m_mode == LightMode) {
-            m_numa = false;
-
-            return true;
-        }
-
         const auto &numa = Json::getValue(value, kNUMA);
         if (numa.IsArray()) {
             m_nodeset.reserve(numa.Size());
@@ -158,6 +161,12 @@ rapidjson::Value xmrig::RxConfig::toJSON(rapidjson::Document &doc) const
 #   endif
 
     obj.AddMember(StringRef(kCacheQoS), m_cacheQoS, allocator);
+    obj.AddMember(StringRef(kScrub),    m_scrub, allocator);
+    obj.AddMember(StringRef(kAutoThreads), m_autoThreads, allocator);
+
+#   ifdef XMRIG_OS_LINUX
+    obj.AddMember(StringRef(kHandoff), m_handoff.toJSON(), allocator);
+#   endif
 
 #   ifdef XMRIG_FEATURE_HWLOC
     if (!m_nodeset.empty()) {
@@ -21,6 +21,7 @@
 
 
 #include "3rdparty/rapidjson/fwd.h"
+#include "base/tools/String.h"
 
 
 #ifdef XMRIG_FEATURE_MSR
@@ -52,6 +53,7 @@ public:
         ScratchpadPrefetchMax,
     };
 
+    static const char *kAutoThreads;
     static const char *kCacheQoS;
     static const char *kField;
     static const char *kInit;
@@ -60,8 +62,13 @@ public:
     static const char *kOneGbPages;
     static const char *kRdmsr;
     static const char *kScratchpadPrefetchMode;
+    static const char *kScrub;
     static const char *kWrmsr;
 
+#   ifdef XMRIG_OS_LINUX
+    static const char *kHandoff;
+#   endif
+
 #   ifdef XMRIG_FEATURE_HWLOC
     static const char *kNUMA;
 #   endif
@@ -84,6 +91,12 @@ public:
     inline bool wrmsr() const           { return m_wrmsr; }
     inline bool cacheQoS() const        { return m_cacheQoS; }
     inline Mode mode() const            { return m_mode; }
+    inline uint32_t scrub() const       { return m_scrub; }
+    inline uint32_t autoThreads() const { return m_autoThreads; }
+
+#   ifdef XMRIG_OS_LINUX
+    inline const String &handoff() const { return m_handoff; }
+#   endif
 
     inline ScratchpadPrefetchMode scratchpadPrefetchMode() const { return m_scratchpadPrefetchMode; }
 
@@ -112,6 +125,12 @@ private:
     int m_threads         = -1;
     int m_initDatasetAVX2 = -1;
     Mode m_mode           = AutoMode;
+    uint32_t m_scrub      = 0;
+    uint32_t m_autoThreads = 0;
+
+#   ifdef XMRIG_OS_LINUX
+    String m_handoff;
+#   endif
 
     ScratchpadPrefetchMode m_scratchpadPrefetchMode = ScratchpadPrefetchT0;
 
@@ -23,15 +23,24 @@
 #include "base/io/log/Tags.h"
 #include "base/kernel/Platform.h"
 #include "crypto/common/VirtualMemory.h"
+#include "crypto/randomx/dataset.hpp"
 #include "crypto/randomx/randomx.h"
 #include "crypto/rx/RxAlgo.h"
 #include "crypto/rx/RxCache.h"
+#include "crypto/rx/RxScrubber.h"
 
 
+#include <algorithm>
+#include <cstring>
 #include <thread>
 #include <uv.h>
 
 
+#ifdef XMRIG_OS_LINUX
+#   include "crypto/rx/RxHandoff.h"
+#endif
+
+
 namespace xmrig {
 
 
@@ -39,9 +48,20 @@ static void init_dataset_wrapper(randomx_dataset *dataset, randomx_cache *cache,
 {
     Platform::setThreadPriority(priority);
 
-    if (Cpu::info()->hasAVX2() && (itemCount % 5)) {
-        randomx_init_dataset(dataset, cache, startItem, itemCount - (itemCount % 5));
-        randomx_init_dataset(dataset, cache, startItem + itemCount - 5, 5);
+    // AVX2 dataset init processes 5 items per pass and AVX-512 processes 8, so split on a multiple of both
+    constexpr uint32_t step = 40;
+
+    if (Cpu::info()->hasAVX2() && (itemCount % step) && (itemCount > step)) {
+        randomx_init_dataset(dataset, cache, startItem, itemCount - (itemCount % step));
+        randomx_init_dataset(dataset, cache, startItem + itemCount - step, step);
+    }
+    else if (Cpu::info()->hasAVX2() && (itemCount % step)) {
+        // Too short to rebuild a whole step at the end without leaving the range, the vector kernels would write past it
+        auto memory = static_cast<uint8_t *>(randomx_get_dataset_memory(dataset));
+
+        for (uint32_t item = startItem; item < startItem + itemCount; ++item) {
+            randomx::initDatasetItem(cache, memory + static_cast<size_t>(item) * RANDOMX_DATASET_ITEM_SIZE, item);
+        }
     }
     else {
         randomx_init_dataset(dataset, cache, startItem, itemCount);
@@ -52,11 +72,11 @@ static void init_dataset_wrapper(randomx_dataset *dataset, randomx_cache *cache,
 } // namespace xmrig
 
 
-xmrig::RxDataset::RxDataset(bool hugePages, bool oneGbPages, bool cache, RxConfig::Mode mode, uint32_t node) :
+xmrig::RxDataset::RxDataset(bool hugePages, bool oneGbPages, bool cache, RxConfig::Mode mode, uint32_t node, VirtualMemory *memory) :
     m_mode(mode),
     m_node(node)
 {
-    allocate(hugePages, oneGbPages);
+    allocate(hugePages, oneGbPages, memory);
 
     if (isOneGbPages()) {
         m_cache = new RxCache(m_memory->raw() + VirtualMemory::align(maxSize()));
@@ -79,6 +99,8 @@ xmrig::RxDataset::RxDataset(RxCache *cache) :
 
 xmrig::RxDataset::~RxDataset()
 {
+    stopScrubber();
+
     randomx_release_dataset(m_dataset);
 
     delete m_cache;
@@ -92,33 +114,73 @@ bool xmrig::RxDataset::init(const Buffer &seed, uint32_t numThreads, int priorit
         return false;
     }
 
+    stopScrubber();
+
     m_cache->init(seed);
 
     if (!get()) {
         return true;
     }
 
-    const uint64_t datasetItemCount = randomx_dataset_item_count();
+    build(m_cache, 0, static_cast<uint32_t>(randomx_dataset_item_count()), numThreads, priority);
+    startScrubber();
+
+    return true;
+}
+
+
+void xmrig::RxDataset::build(const RxCache *cache, uint32_t startItem, uint32_t itemCount, uint32_t numThreads, int priority)
+{
+    if (!m_dataset || !cache || !cache->get() || itemCount == 0) {
+        return;
+    }
 
     if (numThreads > 1) {
         std::vector<std::thread> threads;
         threads.reserve(numThreads);
 
         for (uint64_t i = 0; i < numThreads; ++i) {
-            const uint32_t a = (datasetItemCount * i) / numThreads;
-            const uint32_t b = (datasetItemCount * (i + 1)) / numThreads;
-            threads.emplace_back(init_dataset_wrapper, m_dataset, m_cache->get(), a, b - a, priority);
+            const uint32_t a = startItem + static_cast<uint32_t>((static_cast<uint64_t>(itemCount) * i) / numThreads);
+            const uint32_t b = startItem + static_cast<uint32_t>((static_cast<uint64_t>(itemCount) * (i + 1)) / numThreads);
+            threads.emplace_back(init_dataset_wrapper, m_dataset, cache->get(), a, b - a, priority);
         }
 
-        for (uint32_t i = 0; i < numThreads; ++i) {
-            threads[i].join();
+        for (auto &thread : threads) {
+            thread.join();
         }
     }
     else {
-        init_dataset_wrapper(m_dataset, m_cache->get(), 0, datasetItemCount, priority);
+        init_dataset_wrapper(m_dataset, cache->get(), startItem, itemCount, priority);
     }
+}
 
-    return true;
+
+void xmrig::RxDataset::copy(const RxDataset *src, uint32_t startItem, uint32_t itemCount, uint32_t numThreads)
+{
+    if (!m_dataset || !src || !src->get() || itemCount == 0) {
+        return;
+    }
+
+    const size_t offset = static_cast<size_t>(startItem) * RANDOMX_DATASET_ITEM_SIZE;
+    const size_t size   = static_cast<size_t>(itemCount) * RANDOMX_DATASET_ITEM_SIZE;
+    auto dst            = static_cast<uint8_t *>(raw()) + offset;
+    auto from           = static_cast<const uint8_t *>(src->raw()) + offset;
+
+    numThreads = std::max(numThreads, 1U);
+
+    std::vector<std::thread> threads;
+    threads.reserve(numThreads);
+
+    for (uint64_t i = 0; i < numThreads; ++i) {
+        const size_t a = (size * i / numThreads) & ~static_cast<size_t>(RANDOMX_DATASET_ITEM_SIZE - 1);
+        const size_t b = i + 1 == numThreads ? size : (size * (i + 1) / numThreads) & ~static_cast<size_t>(RANDOMX_DATASET_ITEM_SIZE - 1);
+
+        threads.emplace_back([dst, from, a, b]() { memcpy(dst + a, from + a, b - a); });
+    }
+
+    for (auto &thread : threads) {
+        thread.join();
+    }
 }
 
 
@@ -134,6 +196,12 @@ bool xmrig::RxDataset::isOneGbPages() const
 }
 
 
+int xmrig::RxDataset::fd() const
+{
+    return m_memory ? m_memory->fd() : -1;
+}
+
+
 xmrig::HugePagesInfo xmrig::RxDataset::hugePages(bool cache) const
 {
     auto pages = m_memory ? m_memory->hugePages() : HugePagesInfo();
@@ -184,19 +252,38 @@ void *xmrig::RxDataset::raw() const
 }
 
 
-void xmrig::RxDataset::setRaw(const void *raw)
+void xmrig::RxDataset::startScrubber(RxCache *cache)
 {
-    if (!m_dataset) {
+    // NUMA replicas have no cache of their own, they are verified against the primary one.
+    if (!cache) {
+        cache = m_cache;
+    }
+
+    if (m_scrubber || !RxScrubber::rate() || !m_dataset || !cache || !cache->get()) {
         return;
     }
 
-    volatile size_t N = maxSize();
-    memcpy(randomx_get_dataset_memory(m_dataset), raw, N);
+    m_scrubber = new RxScrubber(cache, raw(), m_node);
+}
+
+
+void xmrig::RxDataset::stopScrubber()
+{
+    delete m_scrubber;
+    m_scrubber = nullptr;
 }
 
 
-void xmrig::RxDataset::allocate(bool hugePages, bool oneGbPages)
+void xmrig::RxDataset::allocate(bool hugePages, bool oneGbPages, VirtualMemory *memory)
 {
+    // Memory of a running instance's dataset (live upgrade), already filled.
+    if (memory) {
+        m_memory  = memory;
+        m_dataset = randomx_create_dataset(m_memory->raw());
+
+        return;
+    }
+
     if (m_mode == RxConfig::LightMode) {
         LOG_ERR(CLEAR "%s" RED_BOLD_S "fast RandomX mode disabled by config", Tags::randomx());
 
@@ -209,7 +296,17 @@ void xmrig::RxDataset::allocate(bool hugePages, bool oneGbPages)
         return;
     }
 
-    m_memory  = new VirtualMemory(maxSize(), hugePages, oneGbPages, false, m_node);
+#   ifdef XMRIG_OS_LINUX
+    // With live upgrades enabled the dataset lives in a memfd, a new instance maps the same pages instead of copying them.
+    if (!oneGbPages && RxHandoff::isEnabled()) {
+        m_memory = VirtualMemory::createShared(maxSize(), hugePages, m_node);
+    }
+
+    if (!m_memory)
+#   endif
+    {
+        m_memory = new VirtualMemory(maxSize(), hugePages, oneGbPages, false, m_node, 64, true);
+    }
 
     if (m_memory->isOneGbPages()) {
         m_scratchpadOffset = maxSize() + RANDOMX_CACHE_MAX_SIZE;
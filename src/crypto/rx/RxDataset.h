@@ -38,6 +38,7 @@ namespace xmrig
 
 
 class RxCache;
+class RxScrubber;
 class VirtualMemory;
 
 
@@ -46,7 +47,7 @@ class RxDataset
 public:
     XMRIG_DISABLE_COPY_MOVE_DEFAULT(RxDataset)
 
-    RxDataset(bool hugePages, bool oneGbPages, bool cache, RxConfig::Mode mode, uint32_t node);
+    RxDataset(bool hugePages, bool oneGbPages, bool cache, RxConfig::Mode mode, uint32_t node, VirtualMemory *memory = nullptr);
     RxDataset(RxCache *cache);
     ~RxDataset();
 
@@ -57,21 +58,26 @@ public:
     bool init(const Buffer &seed, uint32_t numThreads, int priority);
     bool isHugePages() const;
     bool isOneGbPages() const;
+    int fd() const;
     HugePagesInfo hugePages(bool cache = true) const;
     size_t size(bool cache = true) const;
     uint8_t *tryAllocateScrathpad();
     void *raw() const;
-    void setRaw(const void *raw);
+    void build(const RxCache *cache, uint32_t startItem, uint32_t itemCount, uint32_t numThreads, int priority);
+    void copy(const RxDataset *src, uint32_t startItem, uint32_t itemCount, uint32_t numThreads);
+    void startScrubber(RxCache *cache = nullptr);
+    void stopScrubber();
 
     static inline constexpr size_t maxSize() { return RANDOMX_DATASET_MAX_SIZE; }
 
 private:
-    void allocate(bool hugePages, bool oneGbPages);
+    void allocate(bool hugePages, bool oneGbPages, VirtualMemory *memory);
 
     const RxConfig::Mode m_mode = RxConfig::FastMode;
     const uint32_t m_node;
     randomx_dataset *m_dataset  = nullptr;
     RxCache *m_cache            = nullptr;
+    RxScrubber *m_scrubber      = nullptr;
     size_t m_scratchpadLimit    = 0;
     std::atomic<size_t> m_scratchpadOffset{};
     VirtualMemory *m_memory     = nullptr;
@@ -0,0 +1,61 @@
+/* XMRig
+ * Copyright (c) 2018-2024 SChernykh   <https://github.com/SChernykh>
+ * Copyright (c) 2016-2024 XMRig       <https://github.com/xmrig>, <support@xmrig.com>
+ *
+ *   This program is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef XMRIG_RX_HANDOFF_H
+#define XMRIG_RX_HANDOFF_H
+
+
+#include "base/tools/String.h"
+
+
+#include <functional>
+
+
+namespace xmrig
+{
+
+
+class RxDataset;
+class RxSeed;
+class VirtualMemory;
+
+
+/**
+ * Live upgrade support: a running instance serves its ready dataset over a Unix socket,
+ * a freshly started instance imports it instead of rebuilding and asks the old one to exit.
+ *
+ * The dataset itself lives in a memfd (VirtualMemory::createShared()), its descriptor is passed over the socket (SCM_RIGHTS)
+ * and the new instance maps the same pages, the handoff doesn't copy the dataset at all.
+ */
+class RxHandoff
+{
+public:
+    static bool isEnabled();
+    static bool revoke();
+    static VirtualMemory *receive(const RxSeed &seed);
+    static void destroy();
+    static void publish(const RxSeed &seed, RxDataset *dataset);
+    static void setExitCallback(const std::function<void()> &callback);
+    static void setPath(const String &path);
+};
+
+
+} /* namespace xmrig */
+
+
+#endif /* XMRIG_RX_HANDOFF_H */
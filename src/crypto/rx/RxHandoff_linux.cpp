@@ -0,0 +1,474 @@
+/* XMRig
+ * Copyright (c) 2018-2024 SChernykh   <https://github.com/SChernykh>
+ * Copyright (c) 2016-2024 XMRig       <https://github.com/xmrig>, <support@xmrig.com>
+ *
+ *   This program is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "crypto/rx/RxHandoff.h"
+#include "base/io/Async.h"
+#include "base/io/log/Log.h"
+#include "base/io/log/Tags.h"
+#include "base/tools/Chrono.h"
+#include "base/tools/Object.h"
+#include "crypto/common/VirtualMemory.h"
+#include "crypto/rx/RxDataset.h"
+#include "crypto/rx/RxSeed.h"
+
+
+#include <cerrno>
+#include <cstring>
+#include <memory>
+#include <mutex>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/un.h>
+#include <thread>
+#include <unistd.h>
+
+
+namespace xmrig {
+
+
+constexpr uint32_t kMagic       = 0x4f485258; // "XRHO"
+constexpr uint32_t kVersion     = 2;
+constexpr size_t kMaxSeedSize   = 64;
+constexpr int kTimeout          = 5;
+
+
+struct HandoffRequest
+{
+    uint32_t magic;
+    uint32_t version;
+    uint32_t algorithm;
+    uint32_t seedSize;
+    uint8_t seed[kMaxSeedSize];
+};
+
+
+struct HandoffReply
+{
+    enum Status : uint32_t {
+        OK,
+        NOT_READY,
+        SEED_MISMATCH,
+        FAILED
+    };
+
+    uint32_t magic;
+    uint32_t version;
+    uint32_t status;
+    uint32_t reserved;
+    uint64_t size;
+};
+
+
+static std::function<void()> exitCallback;
+
+
+static void setTimeout(int fd, int seconds)
+{
+    timeval tv{};
+    tv.tv_sec = seconds;
+
+    setsockopt(fd, SOL_SOCKET, SO_RCVTIMEO, &tv, sizeof(tv));
+    setsockopt(fd, SOL_SOCKET, SO_SNDTIMEO, &tv, sizeof(tv));
+}
+
+
+static bool readAll(int fd, void *buf, size_t size)
+{
+    auto p = static_cast<uint8_t *>(buf);
+
+    while (size > 0) {
+        const ssize_t rc = read(fd, p, size);
+        if (rc <= 0) {
+            if (rc < 0 && errno == EINTR) {
+                continue;
+            }
+
+            return false;
+        }
+
+        p    += rc;
+        size -= static_cast<size_t>(rc);
+    }
+
+    return true;
+}
+
+
+static bool sockaddr(const String &path, sockaddr_un &addr)
+{
+    if (path.size() >= sizeof(addr.sun_path)) {
+        return false;
+    }
+
+    memset(&addr, 0, sizeof(addr));
+    addr.sun_family = AF_UNIX;
+    memcpy(addr.sun_path, path.data(), path.size());
+
+    return true;
+}
+
+
+class RxHandoffPrivate
+{
+public:
+    XMRIG_DISABLE_COPY_MOVE(RxHandoffPrivate)
+
+    // Created on the main loop thread, the worker thread only signals it.
+    inline RxHandoffPrivate() : async(std::make_shared<Async>([] { if (exitCallback) { exitCallback(); } })) {}
+    inline ~RxHandoffPrivate()  { stop(); }
+
+    bool listen();
+    void onConnection(int fd);
+    void stop();
+    void worker();
+
+    bool handedOff      = false;
+    ino_t inode         = 0;
+    int listenFd        = -1;
+    RxDataset *dataset  = nullptr;
+    RxSeed seed;
+    std::mutex mutex;
+    std::shared_ptr<Async> async;
+    std::thread thread;
+    String path;
+};
+
+
+static RxHandoffPrivate *d_ptr = nullptr;
+
+
+} // namespace xmrig
+
+
+bool xmrig::RxHandoffPrivate::listen()
+{
+    sockaddr_un addr{};
+    if (!sockaddr(path, addr)) {
+        return false;
+    }
+
+    listenFd = socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0);
+    if (listenFd < 0) {
+        return false;
+    }
+
+    // Take over the path from the previous instance, its accepted connection stays valid.
+    unlink(addr.sun_path);
+
+    // The socket file must never be accessible to other users, not even between bind() and chmod().
+    const mode_t mask = umask(0077);
+    const bool bound  = bind(listenFd, reinterpret_cast<const struct sockaddr *>(&addr), sizeof(addr)) == 0;
+    umask(mask);
+
+    struct stat st{};
+    if (!bound || ::listen(listenFd, 1) != 0 || stat(addr.sun_path, &st) != 0) {
+        LOG_ERR("%s" RED("failed to listen handoff socket \"%s\": %s"), Tags::randomx(), path.data(), strerror(errno));
+
+        close(listenFd);
+        listenFd = -1;
+
+        return false;
+    }
+
+    chmod(addr.sun_path, S_IRUSR | S_IWUSR);
+    inode  = st.st_ino;
+    thread = std::thread(&RxHandoffPrivate::worker, this);
+
+    return true;
+}
+
+
+void xmrig::RxHandoffPrivate::onConnection(int fd)
+{
+    // Only a process of the same user may take the dataset or make this instance exit.
+    ucred cred{};
+    socklen_t len = sizeof(cred);
+    if (getsockopt(fd, SOL_SOCKET, SO_PEERCRED, &cred, &len) != 0 || cred.uid != geteuid()) {
+        LOG_WARN("%s" YELLOW("handoff connection from uid %u rejected"), Tags::randomx(), static_cast<unsigned int>(cred.uid));
+
+        return;
+    }
+
+    setTimeout(fd, kTimeout);
+
+    HandoffRequest request{};
+    if (!readAll(fd, &request, sizeof(request)) || request.magic != kMagic || request.version != kVersion || request.seedSize > kMaxSeedSize) {
+        return;
+    }
+
+    // Both instances map the same pages from now on, the lock is held until the new instance confirms the mapping so that
+    // revoke() (and the dataset rebuild after it) waits instead of writing into memory which is about to change hands.
+    // Nothing is copied, the wait is bounded by the socket timeout.
+    std::lock_guard<std::mutex> lock(mutex);
+
+    HandoffReply reply{ kMagic, kVersion, HandoffReply::FAILED, 0, 0 };
+    const int memFd = dataset ? dataset->fd() : -1;
+
+    if (!dataset || !dataset->get() || handedOff) {
+        reply.status = HandoffReply::NOT_READY;
+    }
+    else if (seed.algorithm().id() != static_cast<Algorithm::Id>(request.algorithm) || seed.data() != Buffer(request.seed, request.seed + request.seedSize)) {
+        reply.status = HandoffReply::SEED_MISMATCH;
+    }
+    else if (memFd >= 0) {
+        reply.status = HandoffReply::OK;
+        reply.size   = RxDataset::maxSize();
+    }
+
+    iovec iov{ &reply, sizeof(reply) };
+    alignas(cmsghdr) char control[CMSG_SPACE(sizeof(int))]{};
+
+    msghdr msg{};
+    msg.msg_iov    = &iov;
+    msg.msg_iovlen = 1;
+
+    if (reply.status == HandoffReply::OK) {
+        msg.msg_control    = control;
+        msg.msg_controllen = sizeof(control);
+
+        cmsghdr *cmsg   = CMSG_FIRSTHDR(&msg);
+        cmsg->cmsg_level = SOL_SOCKET;
+        cmsg->cmsg_type  = SCM_RIGHTS;
+        cmsg->cmsg_len   = CMSG_LEN(sizeof(int));
+        memcpy(CMSG_DATA(cmsg), &memFd, sizeof(int));
+    }
+
+    if (sendmsg(fd, &msg, MSG_NOSIGNAL) != static_cast<ssize_t>(sizeof(reply)) || reply.status != HandoffReply::OK) {
+        return;
+    }
+
+    uint8_t ack = 0;
+    if (!readAll(fd, &ack, sizeof(ack)) || ack != 1) {
+        return;
+    }
+
+    // From here on the dataset belongs to the new instance, this one must not touch it anymore.
+    handedOff = true;
+    dataset   = nullptr;
+
+    const uint8_t confirm = 1;
+    if (send(fd, &confirm, sizeof(confirm), MSG_NOSIGNAL) == sizeof(confirm)) {
+        LOG_WARN("%s" YELLOW_BOLD("dataset handed off to the new instance, exiting"), Tags::randomx());
+    }
+    else {
+        LOG_ERR("%s" RED("dataset handoff was not confirmed, exiting"), Tags::randomx());
+    }
+
+    async->send();
+}
+
+
+void xmrig::RxHandoffPrivate::stop()
+{
+    if (listenFd < 0) {
+        return;
+    }
+
+    shutdown(listenFd, SHUT_RDWR);
+
+    if (thread.joinable()) {
+        thread.join();
+    }
+
+    close(listenFd);
+    listenFd = -1;
+
+    // Remove the socket file only if it still belongs to this instance.
+    struct stat st{};
+    if (stat(path, &st) == 0 && st.st_ino == inode) {
+        unlink(path);
+    }
+}
+
+
+void xmrig::RxHandoffPrivate::worker()
+{
+    while (true) {
+        const int fd = accept4(listenFd, nullptr, nullptr, SOCK_CLOEXEC);
+        if (fd < 0) {
+            if (errno == EINTR || errno == ECONNABORTED) {
+                continue;
+            }
+
+            break;
+        }
+
+        onConnection(fd);
+        close(fd);
+    }
+}
+
+
+bool xmrig::RxHandoff::isEnabled()
+{
+    return d_ptr && !d_ptr->path.isEmpty();
+}
+
+
+bool xmrig::RxHandoff::revoke()
+{
+    if (!d_ptr) {
+        return true;
+    }
+
+    std::lock_guard<std::mutex> lock(d_ptr->mutex);
+
+    d_ptr->dataset = nullptr;
+
+    return !d_ptr->handedOff;
+}
+
+
+xmrig::VirtualMemory *xmrig::RxHandoff::receive(const RxSeed &seed)
+{
+    if (!isEnabled() || d_ptr->listenFd >= 0 || seed.data().size() > kMaxSeedSize) {
+        return nullptr;
+    }
+
+    sockaddr_un addr{};
+    if (!sockaddr(d_ptr->path, addr)) {
+        return nullptr;
+    }
+
+    const int fd = socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0);
+    if (fd < 0) {
+        return nullptr;
+    }
+
+    if (connect(fd, reinterpret_cast<const struct sockaddr *>(&addr), sizeof(addr)) != 0) {
+        close(fd);
+
+        return nullptr;
+    }
+
+    const uint64_t ts = Chrono::steadyMSecs();
+    setTimeout(fd, kTimeout);
+
+    HandoffRequest request{};
+    request.magic     = kMagic;
+    request.version   = kVersion;
+    request.algorithm = static_cast<uint32_t>(seed.algorithm().id());
+    request.seedSize  = static_cast<uint32_t>(seed.data().size());
+    memcpy(request.seed, seed.data().data(), seed.data().size());
+
+    HandoffReply reply{};
+    iovec iov{ &reply, sizeof(reply) };
+    alignas(cmsghdr) char control[CMSG_SPACE(sizeof(int))]{};
+
+    msghdr msg{};
+    msg.msg_iov        = &iov;
+    msg.msg_iovlen     = 1;
+    msg.msg_control    = control;
+    msg.msg_controllen = sizeof(control);
+
+    int memFd = -1;
+
+    if (write(fd, &request, sizeof(request)) == static_cast<ssize_t>(sizeof(request)) && recvmsg(fd, &msg, MSG_CMSG_CLOEXEC | MSG_WAITALL) == static_cast<ssize_t>(sizeof(reply))) {
+        cmsghdr *cmsg = CMSG_FIRSTHDR(&msg);
+        if (cmsg && cmsg->cmsg_level == SOL_SOCKET && cmsg->cmsg_type == SCM_RIGHTS) {
+            memcpy(&memFd, CMSG_DATA(cmsg), sizeof(int));
+        }
+    }
+
+    VirtualMemory *memory = nullptr;
+
+    // The mapping keeps the descriptor, this instance can hand the same memory over again later.
+    if (memFd >= 0 && reply.magic == kMagic && reply.status == HandoffReply::OK && reply.size == RxDataset::maxSize()) {
+        memory = VirtualMemory::openShared(memFd, reply.size);
+    }
+
+    if (!memory && memFd >= 0) {
+        close(memFd);
+    }
+
+    // Two steps: the old instance stops using the dataset only after the ack, the dataset is used here only after the confirmation.
+    if (memory) {
+        const uint8_t ack = 1;
+        uint8_t confirm   = 0;
+
+        if (send(fd, &ack, sizeof(ack), MSG_NOSIGNAL) != sizeof(ack) || !readAll(fd, &confirm, sizeof(confirm)) || confirm != 1) {
+            delete memory;
+            memory = nullptr;
+        }
+    }
+
+    close(fd);
+
+    if (memory) {
+        LOG_INFO("%s" GREEN_BOLD("dataset received from running instance") BLACK_BOLD(" (%" PRIu64 " ms)"), Tags::randomx(), Chrono::steadyMSecs() - ts);
+    }
+    else if (reply.magic == kMagic && reply.status != HandoffReply::OK) {
+        LOG_WARN("%s" YELLOW("running instance can't hand off dataset (%s)"), Tags::randomx(), reply.status == HandoffReply::SEED_MISMATCH ? "seed mismatch" : "not ready");
+    }
+    else {
+        LOG_WARN("%s" YELLOW("dataset handoff from running instance failed"), Tags::randomx());
+    }
+
+    return memory;
+}
+
+
+void xmrig::RxHandoff::destroy()
+{
+    delete d_ptr;
+
+    d_ptr = nullptr;
+}
+
+
+void xmrig::RxHandoff::publish(const RxSeed &seed, RxDataset *dataset)
+{
+    // Only a memfd backed dataset can be handed off (not with 1GB pages).
+    if (!isEnabled() || !dataset || !dataset->get() || dataset->fd() < 0) {
+        return;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(d_ptr->mutex);
+
+        if (d_ptr->handedOff) {
+            return;
+        }
+
+        d_ptr->seed    = seed;
+        d_ptr->dataset = dataset;
+    }
+
+    if (d_ptr->listenFd < 0) {
+        d_ptr->listen();
+    }
+}
+
+
+void xmrig::RxHandoff::setExitCallback(const std::function<void()> &callback)
+{
+    exitCallback = callback;
+}
+
+
+void xmrig::RxHandoff::setPath(const String &path)
+{
+    if (!d_ptr) {
+        d_ptr = new RxHandoffPrivate();
+    }
+
+    if (d_ptr->path != path) {
+        d_ptr->stop();
+        d_ptr->path = path;
+    }
+}
@@ -0,0 +1,149 @@
+/* XMRig
+ * Copyright (c) 2018-2024 SChernykh   <https://github.com/SChernykh>
+ * Copyright (c) 2016-2024 XMRig       <https://github.com/xmrig>, <support@xmrig.com>
+ *
+ *   This program is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include "crypto/rx/RxMemoryPlan.h"
+#include "backend/cpu/CpuConfig.h"
+#include "base/io/log/Log.h"
+#include "base/io/log/Tags.h"
+#include "crypto/randomx/configuration.h"
+#include "crypto/rx/RxCache.h"
+#include "crypto/rx/RxConfig.h"
+#include "crypto/rx/RxDataset.h"
+
+
+#include <algorithm>
+#include <cstdlib>
+#include <fstream>
+#include <string>
+#include <uv.h>
+
+
+namespace xmrig {
+
+
+constexpr size_t oneMiB         = 1024 * 1024;
+constexpr size_t kPoolAlignment = 16 * oneMiB;  // MemoryPool aligns its base to 16 MB.
+constexpr size_t kReserve       = 64 * oneMiB;  // Miner itself, network buffers, allocator slack.
+constexpr size_t kVmOverhead    = 256 * 1024;   // VM object, program and JIT code buffers.
+constexpr Algorithm::Id kAlgorithm = Algorithm::RX_0;
+
+static size_t poolPages         = 0;
+static size_t threadsLimit      = 0;
+
+
+static inline double toMiB(uint64_t size)
+{
+    return static_cast<double>(size) / oneMiB;
+}
+
+
+} // namespace xmrig
+
+
+uint64_t xmrig::RxMemoryPlan::available()
+{
+    uint64_t available = uv_get_free_memory();
+
+#   ifdef XMRIG_OS_LINUX
+    // Free memory does not include reclaimable page cache, prefer the kernel estimate.
+    std::ifstream meminfo("/proc/meminfo");
+    std::string line;
+
+    while (std::getline(meminfo, line)) {
+        if (line.compare(0, 13, "MemAvailable:") == 0) {
+            available = strtoull(line.c_str() + 13, nullptr, 10) * 1024;
+            break;
+        }
+    }
+#   endif
+
+    const uint64_t constrained = uv_get_constrained_memory();
+
+    return constrained > 0 ? std::min(available, constrained) : available;
+}
+
+
+bool xmrig::RxMemoryPlan::isLight(const RxConfig &config)
+{
+    return isLight(config.mode());
+}
+
+
+bool xmrig::RxMemoryPlan::isLight(RxConfig::Mode mode)
+{
+    return mode == RxConfig::LightMode || (mode == RxConfig::AutoMode && uv_get_total_memory() < (RxDataset::maxSize() + RxCache::maxSize()));
+}
+
+
+size_t xmrig::RxMemoryPlan::poolSize()
+{
+    return poolPages;
+}
+
+
+size_t xmrig::RxMemoryPlan::threads(const Algorithm &algorithm)
+{
+    return algorithm == kAlgorithm ? threadsLimit : 0;
+}
+
+
+void xmrig::RxMemoryPlan::init(const RxConfig &config, const CpuConfig &cpu)
+{
+    threadsLimit = 0;
+    poolPages    = 0;
+
+    if (!cpu.isEnabled() || !isLight(config)) {
+        return;
+    }
+
+    const size_t requested  = std::max<size_t>(cpu.threads().get(kAlgorithm).count(), 1);
+    const uint64_t available = RxMemoryPlan::available();
+    const size_t replicas   = std::max<size_t>(config.nodeset().size(), 1);
+    const size_t cache      = RxCache::maxSize() * replicas;
+    const size_t scratchpad = RANDOMX_SCRATCHPAD_L3_MAX_SIZE;
+    const size_t pool       = cpu.isHugePages() ? kPoolAlignment : 0;
+    const size_t fixed      = kReserve + cache + pool;
+    const size_t fit        = available > fixed ? static_cast<size_t>((available - fixed) / (scratchpad + kVmOverhead)) : 0;
+
+    threadsLimit = std::max<size_t>(std::min(requested, fit), 1);
+    poolPages    = cpu.isHugePages() ? threadsLimit : 0;
+
+    const uint64_t total = fixed + threadsLimit * (scratchpad + kVmOverhead);
+    const char *pages    = cpu.isHugePages() ? "huge/THP" : "4K";
+
+    LOG_INFO("%s" YELLOW_BOLD("light mode") " memory plan, threads %s%zu/%zu" CLEAR " available " CYAN_BOLD("%.0f MB"),
+             Tags::randomx(),
+             threadsLimit < requested ? YELLOW_BOLD_S : CYAN_BOLD_S,
+             threadsLimit,
+             requested,
+             toMiB(available)
+             );
+
+    Log::print(WHITE_BOLD_S "| ITEM        | COUNT |       MB | PAGES    |");
+    Log::print("| cache       | %5zu | %8.1f | %-8s |", replicas, toMiB(cache), pages);
+    Log::print("| scratchpads | %5zu | %8.1f | %-8s |", threadsLimit, toMiB(threadsLimit * scratchpad), pages);
+
+    if (pool) {
+        Log::print("| pool align  | %5u | %8.1f | %-8s |", 1U, toMiB(pool), pages);
+    }
+
+    Log::print("| VM state    | %5zu | %8.1f | %-8s |", threadsLimit, toMiB(threadsLimit * kVmOverhead), "4K");
+    Log::print("| reserve     | %5s | %8.1f | %-8s |", "-", toMiB(kReserve), "4K");
+    Log::print(WHITE_BOLD_S "| total       | %5s | %8.1f | %-8s |", "-", toMiB(total), available >= total ? "fits" : "SWAP");
+}
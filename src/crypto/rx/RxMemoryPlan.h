@@ -0,0 +1,59 @@
+/* XMRig
+ * Copyright (c) 2018-2024 SChernykh   <https://github.com/SChernykh>
+ * Copyright (c) 2016-2024 XMRig       <https://github.com/xmrig>, <support@xmrig.com>
+ *
+ *   This program is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef XMRIG_RX_MEMORYPLAN_H
+#define XMRIG_RX_MEMORYPLAN_H
+
+
+#include <cstddef>
+#include <cstdint>
+
+
+#include "base/crypto/Algorithm.h"
+#include "crypto/rx/RxConfig.h"
+
+
+namespace xmrig
+{
+
+
+class CpuConfig;
+
+
+/**
+ * Startup memory plan for light mode (boards without enough memory for the dataset): the number of
+ * RandomX threads is limited to what fits next to the cache and scratchpads are packed in the memory pool.
+ * The plan is made for the "rx" threads profile (rx/0), other RandomX variants keep their configured threads.
+ * It is made again on config reload, the memory pool size only applies at startup.
+ */
+class RxMemoryPlan
+{
+public:
+    static bool isLight(const RxConfig &config);
+    static bool isLight(RxConfig::Mode mode);
+    static size_t poolSize();
+    static uint64_t available();
+    static size_t threads(const Algorithm &algorithm);
+    static void init(const RxConfig &config, const CpuConfig &cpu);
+};
+
+
+} /* namespace xmrig */
+
+
+#endif /* XMRIG_RX_MEMORYPLAN_H */
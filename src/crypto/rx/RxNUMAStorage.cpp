@@ -18,21 +18,27 @@
  */
 
 #include "crypto/rx/RxNUMAStorage.h"
+#include "3rdparty/rapidjson/document.h"
 #include "backend/cpu/Cpu.h"
 #include "base/io/log/Log.h"
 #include "base/io/log/Tags.h"
 #include "base/kernel/Platform.h"
 #include "base/tools/Chrono.h"
 #include "crypto/rx/RxAlgo.h"
+#include "crypto/rx/RxBuildStats.h"
 #include "crypto/rx/RxCache.h"
 #include "crypto/rx/RxDataset.h"
+#include "crypto/rx/RxMemoryPlan.h"
 #include "crypto/rx/RxSeed.h"
+#include "crypto/randomx/randomx.h"
 
 
+#include <algorithm>
 #include <map>
 #include <mutex>
 #include <hwloc.h>
 #include <thread>
+#include <vector>
 
 
 namespace xmrig {
@@ -42,7 +48,8 @@ constexpr size_t oneMiB = 1024 * 1024;
 static std::mutex mutex;
 
 
-static bool bindToNUMANode(uint32_t nodeId)
+// With wholeNode the thread may run on any PU of the node, dataset build threads of one node share it.
+static bool bindToNUMANode(uint32_t nodeId, bool wholeNode = false)
 {
     auto node = hwloc_get_numanode_obj_by_os_index(Cpu::info()->topology(), nodeId);
     if (!node) {
@@ -50,7 +57,12 @@ static bool bindToNUMANode(uint32_t nodeId)
     }
 
     if (Cpu::info()->membind(node->nodeset)) {
-        Platform::setThreadAffinity(static_cast<uint64_t>(hwloc_bitmap_first(node->cpuset)));
+        if (wholeNode) {
+            hwloc_set_cpubind(Cpu::info()->topology(), node->cpuset, HWLOC_CPUBIND_THREAD);
+        }
+        else {
+            Platform::setThreadAffinity(static_cast<uint64_t>(hwloc_bitmap_first(node->cpuset)));
+        }
 
         return true;
     }
@@ -59,6 +71,15 @@ static bool bindToNUMANode(uint32_t nodeId)
 }
 
 
+static uint32_t nodePUs(uint32_t nodeId)
+{
+    auto node = hwloc_get_numanode_obj_by_os_index(Cpu::info()->topology(), nodeId);
+    const int count = node ? hwloc_bitmap_weight(node->cpuset) : 0;
+
+    return count > 0 ? static_cast<uint32_t>(count) : 1;
+}
+
+
 static inline void printSkipped(uint32_t nodeId, const char *reason)
 {
     LOG_WARN("%s" CYAN_BOLD("#%u ") RED_BOLD("skipped") YELLOW(" (%s)"), Tags::randomx(), nodeId, reason);
@@ -71,9 +92,28 @@ static inline void printDatasetReady(uint32_t nodeId, uint64_t ts)
 }
 
 
+static inline void printCacheReady(uint32_t nodeId, uint64_t ts)
+{
+    LOG_INFO("%s" CYAN_BOLD("#%u ") GREEN_BOLD("cache ready") BLACK_BOLD(" (%" PRIu64 " ms)"), Tags::randomx(), nodeId, Chrono::steadyMSecs() - ts);
+}
+
+
 class RxNUMAStoragePrivate
 {
 public:
+    // Part of the dataset built by one node, "threads" build threads are bound to that node.
+    struct Slice
+    {
+        uint32_t node       = 0;
+        uint32_t threads    = 1;  // build threads, 0 if there are more nodes than threads
+        uint32_t start      = 0;
+        uint32_t count      = 0;
+        double build        = 0.0;  // ms
+        double exchange     = 0.0;  // ms
+        double rate         = 0.0;  // items per ms
+        double bandwidth    = 0.0;  // bytes per ms, pulled from other nodes
+    };
+
     XMRIG_DISABLE_COPY_MOVE_DEFAULT(RxNUMAStoragePrivate)
 
     inline explicit RxNUMAStoragePrivate(const std::vector<uint32_t> &nodeset) :
@@ -94,13 +134,32 @@ public:
 
     inline bool isAllocated() const                     { return m_allocated; }
     inline bool isReady(const Job &job) const           { return m_ready && m_seed == job; }
-    inline RxDataset *dataset(uint32_t nodeId) const    { return m_datasets.count(nodeId) ? m_datasets.at(nodeId) : m_datasets.at(m_nodeset.front()); }
+
+
+    inline RxDataset *dataset(uint32_t nodeId) const
+    {
+        auto &hits = m_hits[nodeId];
+
+        if (m_datasets.count(nodeId)) {
+            ++hits.first;
+
+            return m_datasets.at(nodeId);
+        }
+
+        ++hits.second;
+
+        return m_datasets.count(m_nodeset.front()) ? m_datasets.at(m_nodeset.front()) : m_datasets.begin()->second;
+    }
 
 
     inline void setSeed(const RxSeed &seed)
     {
         m_ready = false;
 
+        for (auto const &item : m_datasets) {
+            item.second->stopScrubber();
+        }
+
         if (m_seed.algorithm() != seed.algorithm()) {
             RxAlgo::apply(seed.algorithm());
         }
@@ -109,18 +168,35 @@ public:
     }
 
 
-    inline bool createDatasets(bool hugePages, bool oneGbPages)
+    inline bool createDatasets(bool hugePages, bool oneGbPages, RxConfig::Mode mode)
     {
         const uint64_t ts = Chrono::steadyMSecs();
 
-        for (uint32_t node : m_nodeset) {
-            m_threads.emplace_back(allocate, this, node, hugePages, oneGbPages);
+        if (!RxMemoryPlan::isLight(mode)) {
+            for (uint32_t node : m_nodeset) {
+                m_threads.emplace_back(allocate, this, node, hugePages, oneGbPages);
+            }
+
+            join();
+
+            if (m_datasets.empty()) {
+                LOG_WARN(CLEAR "%s" YELLOW_BOLD_S "failed to allocate RandomX datasets, switching to light mode" BLACK_BOLD(" (%" PRIu64 " ms)"), Tags::randomx(), Chrono::steadyMSecs() - ts);
+            }
         }
 
-        join();
+        // Light mode: every node gets its own copy of the cache, VMs and scratchpads are already allocated on the worker's node.
+        if (m_datasets.empty()) {
+            for (uint32_t node : m_nodeset) {
+                m_threads.emplace_back(allocateCache, this, node, hugePages, true);
+            }
+
+            join();
+
+            m_light = !m_datasets.empty();
+        }
 
         if (isCacheRequired()) {
-            std::thread thread(allocateCache, this, m_nodeset.front(), hugePages);
+            std::thread thread(allocateCache, this, m_nodeset.front(), hugePages, false);
             thread.join();
 
             if (!m_cache) {
@@ -128,7 +204,10 @@ public:
             }
         }
 
-        if (m_datasets.empty()) {
+        if (m_light) {
+            printAllocStatus(ts);
+        }
+        else if (m_datasets.empty()) {
             m_datasets.insert({ m_nodeset.front(), new RxDataset(m_cache) });
 
             LOG_WARN(CLEAR "%s" YELLOW_BOLD_S "failed to allocate RandomX datasets, switching to slow mode" BLACK_BOLD(" (%" PRIu64 " ms)"), Tags::randomx(), Chrono::steadyMSecs() - ts);
@@ -142,6 +221,7 @@ public:
         }
 
         m_allocated = true;
+        m_alloc     = static_cast<double>(Chrono::steadyMSecs() - ts);
 
         return true;
     }
@@ -149,6 +229,10 @@ public:
 
     inline bool isCacheRequired() const
     {
+        if (m_light) {
+            return false;
+        }
+
         if (m_datasets.empty()) {
             return true;
         }
@@ -165,8 +249,14 @@ public:
 
     inline void initDatasets(uint32_t threads, int priority)
     {
-        uint64_t ts = Chrono::steadyMSecs();
-        uint32_t id = 0;
+        if (m_light) {
+            return initCaches(priority);
+        }
+
+        uint64_t ts        = Chrono::steadyMSecs();
+        uint32_t id        = 0;
+        const double start = Chrono::highResolutionMSecs();
+        auto stats         = RxBuildStats::create(m_seed);
 
         for (const auto &kv : m_datasets) {
             if (kv.second->cache()) {
@@ -174,27 +264,166 @@ public:
             }
         }
 
-        auto primary = dataset(id);
-        primary->init(m_seed.data(), threads, priority);
+        auto primary = m_datasets.at(id);
 
-        printDatasetReady(id, ts);
+        if (m_datasets.size() == 1) {
+            primary->init(m_seed.data(), threads, priority);
 
-        if (m_datasets.size() > 1) {
-            for (auto const &item : m_datasets) {
-                if (item.first == id) {
-                    continue;
-                }
+            printDatasetReady(id, ts);
+
+            stats.threads = std::max(threads, 1U);
 
-                m_threads.emplace_back(copyDataset, item.second, item.first, primary->raw());
+            if (primary->get()) {
+                stats.dataset = std::max(Chrono::highResolutionMSecs() - start - primary->cache()->argon2Time() - primary->cache()->superscalarTime(), 0.0);
+                stats.rate    = stats.dataset > 0.0 ? randomx_dataset_item_count() / stats.dataset / stats.threads : 0.0;
+            }
+            else {
+                stats.mode = "light";
+            }
+
+            addBuildStats(stats, primary->cache(), start);
+
+            m_ready = true;
+            return;
+        }
+
+        // One cache for all nodes, build threads on other nodes read it remotely but it is only 256 MB against 2 GB of dataset per node.
+        primary->cache()->init(m_seed.data());
+
+        split(threads);
+
+        // A node without build threads can't build the whole dataset, it only pulls slices from other nodes.
+        const bool independent = m_independent && threads >= m_slices.size();
+
+        for (auto &slice : m_slices) {
+            const uint32_t start = independent ? 0 : slice.start;
+            const uint32_t count = independent ? m_items : slice.count;
+
+            for (uint32_t i = 0; i < slice.threads; ++i) {
+                const uint32_t a = start + static_cast<uint32_t>(static_cast<uint64_t>(count) * i / slice.threads);
+                const uint32_t b = start + static_cast<uint32_t>(static_cast<uint64_t>(count) * (i + 1) / slice.threads);
+
+                m_threads.emplace_back(buildSlice, &slice, m_datasets.at(slice.node), primary->cache(), a, b - a, priority);
+            }
+        }
+
+        join();
+
+        if (!independent) {
+            for (auto &slice : m_slices) {
+                for (uint32_t i = 0; i < exchangeThreads(slice); ++i) {
+                    m_threads.emplace_back(exchangeSlices, this, &slice, i);
+                }
             }
 
             join();
         }
 
+        for (auto const &item : m_datasets) {
+            item.second->startScrubber(primary->cache());
+        }
+
+        double build    = 0.0;
+        double exchange = 0.0;
+
+        for (auto &slice : m_slices) {
+            build    = std::max(build, slice.build);
+            exchange = std::max(exchange, slice.exchange);
+            slice.rate = slice.build > 0.0 ? (independent ? m_items : slice.count) / slice.build : 0.0;
+
+            if (!independent) {
+                slice.bandwidth = slice.exchange > 0.0 ? (m_items - slice.count) * static_cast<double>(RANDOMX_DATASET_ITEM_SIZE) / slice.exchange : 0.0;
+            }
+        }
+
+        LOG_INFO("%s" CYAN_BOLD("-- ") GREEN_BOLD("dataset ready") " %s" BLACK_BOLD(" (build %.0f ms, exchange %.0f ms, %" PRIu64 " ms)"),
+                 Tags::randomx(), independent ? "independent" : "distributed", build, exchange, Chrono::steadyMSecs() - ts);
+
+        stats.strategy = independent ? "independent" : "distributed";
+        stats.nodes    = static_cast<uint32_t>(m_slices.size());
+        stats.dataset  = build;
+        stats.copy     = exchange;
+
+        for (const auto &slice : m_slices) {
+            stats.threads += slice.threads;
+            stats.rate    += slice.rate;
+        }
+
+        stats.rate /= std::max(stats.threads, 1U);
+
+        addBuildStats(stats, primary->cache(), start);
+
+        choose();
+
         m_ready = true;
     }
 
 
+    // Every replica is built by a thread bound to its node, so the cache memory is filled locally and all nodes finish at about the same time.
+    inline void initCaches(int priority)
+    {
+        const double start = Chrono::highResolutionMSecs();
+        auto stats         = RxBuildStats::create(m_seed);
+
+        for (auto const &item : m_datasets) {
+            m_threads.emplace_back(initCache, item.second, item.first, m_seed.data(), priority);
+        }
+
+        join();
+
+        // Replicas are built in parallel, the slowest one is reported.
+        const RxCache *slowest = nullptr;
+
+        for (auto const &item : m_datasets) {
+            const RxCache *cache = item.second->cache();
+
+            if (!slowest || cache->argon2Time() + cache->superscalarTime() > slowest->argon2Time() + slowest->superscalarTime()) {
+                slowest = cache;
+            }
+        }
+
+        stats.mode    = "light";
+        stats.nodes   = static_cast<uint32_t>(m_datasets.size());
+        stats.threads = stats.nodes;
+
+        addBuildStats(stats, slowest, start);
+
+        m_ready = true;
+    }
+
+
+    rapidjson::Value toJSON(rapidjson::Document &doc) const
+    {
+        using namespace rapidjson;
+        auto &allocator = doc.GetAllocator();
+
+        Value out(kObjectType);
+        out.AddMember("mode", StringRef(m_light ? "light" : (m_cache && m_datasets.size() == 1 && !m_datasets.begin()->second->get() ? "slow" : "fast")), allocator);
+
+        Value nodes(kArrayType);
+
+        for (uint32_t nodeId : m_nodeset) {
+            const auto it = m_hits.find(nodeId);
+
+            Value node(kObjectType);
+            node.AddMember("node",      nodeId, allocator);
+            node.AddMember("replica",   m_datasets.count(nodeId) > 0, allocator);
+            node.AddMember("local",     it != m_hits.end() ? it->second.first : 0, allocator);
+            node.AddMember("remote",    it != m_hits.end() ? it->second.second : 0, allocator);
+
+            nodes.PushBack(node, allocator);
+        }
+
+        out.AddMember("nodes", nodes, allocator);
+
+        if (!m_slices.empty()) {
+            out.AddMember("build", StringRef(m_independent ? "independent" : "distributed"), allocator);
+        }
+
+        return out;
+    }
+
+
     inline HugePagesInfo hugePages() const
     {
         HugePagesInfo pages;
@@ -207,6 +436,21 @@ public:
 
 
 private:
+    void addBuildStats(RxBuildStats::Build &stats, const RxCache *cache, double start)
+    {
+        stats.variant     = cache ? cache->variant() : nullptr;
+        stats.argon2      = cache ? cache->argon2Time() : 0.0;
+        stats.superscalar = cache ? cache->superscalarTime() : 0.0;
+        stats.total       = Chrono::highResolutionMSecs() - start;
+        stats.alloc       = m_alloc;
+        stats.hugePages   = hugePages().percent();
+
+        m_alloc = 0.0;
+
+        RxBuildStats::add(stats);
+    }
+
+
     static void allocate(RxNUMAStoragePrivate *d_ptr, uint32_t nodeId, bool hugePages, bool oneGbPages)
     {
         const uint64_t ts = Chrono::steadyMSecs();
@@ -231,7 +475,7 @@ private:
     }
 
 
-    static void allocateCache(RxNUMAStoragePrivate *d_ptr, uint32_t nodeId, bool hugePages)
+    static void allocateCache(RxNUMAStoragePrivate *d_ptr, uint32_t nodeId, bool hugePages, bool replica)
     {
         const uint64_t ts = Chrono::steadyMSecs();
 
@@ -247,18 +491,157 @@ private:
         }
 
         std::lock_guard<std::mutex> lock(mutex);
-        d_ptr->m_cache = cache;
         RxNUMAStoragePrivate::printAllocStatus(cache, nodeId, ts);
+
+        if (replica) {
+            d_ptr->m_datasets.insert({ nodeId, new RxDataset(cache) });
+        }
+        else {
+            d_ptr->m_cache = cache;
+        }
     }
 
 
-    static void copyDataset(RxDataset *dst, uint32_t nodeId, const void *raw)
+    static void initCache(RxDataset *dataset, uint32_t nodeId, const Buffer &seed, int priority)
     {
         const uint64_t ts = Chrono::steadyMSecs();
 
-        dst->setRaw(raw);
+        bindToNUMANode(nodeId);
+        Platform::setThreadPriority(priority);
+
+        dataset->init(seed, 1, priority);
+
+        printCacheReady(nodeId, ts);
+    }
+
+
+    static void buildSlice(Slice *slice, RxDataset *dataset, const RxCache *cache, uint32_t startItem, uint32_t itemCount, int priority)
+    {
+        const double ts = Chrono::highResolutionMSecs();
+
+        bindToNUMANode(slice->node, true);
+        dataset->build(cache, startItem, itemCount, 1, priority);
 
-        printDatasetReady(nodeId, ts);
+        const double elapsed = Chrono::highResolutionMSecs() - ts;
+
+        std::lock_guard<std::mutex> lock(mutex);
+        slice->build = std::max(slice->build, elapsed);
+    }
+
+
+    // Pulls a part of every other node's slice into the local dataset, remote reads and local writes.
+    static void exchangeSlices(const RxNUMAStoragePrivate *d_ptr, Slice *slice, uint32_t index)
+    {
+        const double ts = Chrono::highResolutionMSecs();
+
+        bindToNUMANode(slice->node, true);
+
+        auto dst = d_ptr->m_datasets.at(slice->node);
+
+        for (const auto &other : d_ptr->m_slices) {
+            if (other.node == slice->node) {
+                continue;
+            }
+
+            const uint32_t a = other.start + static_cast<uint32_t>(static_cast<uint64_t>(other.count) * index / exchangeThreads(*slice));
+            const uint32_t b = other.start + static_cast<uint32_t>(static_cast<uint64_t>(other.count) * (index + 1) / exchangeThreads(*slice));
+
+            dst->copy(d_ptr->m_datasets.at(other.node), a, b - a, 1);
+        }
+
+        const double elapsed = Chrono::highResolutionMSecs() - ts;
+
+        std::lock_guard<std::mutex> lock(mutex);
+        slice->exchange = std::max(slice->exchange, elapsed);
+    }
+
+
+    static inline uint32_t exchangeThreads(const Slice &slice) { return std::max(slice.threads, 1U); }
+
+
+    // Build threads are spread over nodes by their PU count, every node builds a share of items matching its threads.
+    // The total always equals the requested thread count, the remainder goes to the nodes with the largest fractional share.
+    void split(uint32_t threads)
+    {
+        m_items = static_cast<uint32_t>(randomx_dataset_item_count());
+        threads = std::max(threads, 1U);
+
+        uint64_t total = 0;
+        for (const auto &kv : m_datasets) {
+            total += nodePUs(kv.first);
+        }
+
+        if (m_slices.size() != m_datasets.size()) {
+            m_slices.clear();
+            m_slices.resize(m_datasets.size());
+        }
+
+        std::vector<uint64_t> remainders(m_slices.size());
+        uint32_t sum = 0;
+        size_t i     = 0;
+
+        for (const auto &kv : m_datasets) {
+            const uint64_t share = static_cast<uint64_t>(threads) * nodePUs(kv.first);
+
+            auto &slice     = m_slices[i];
+            slice.node      = kv.first;
+            slice.threads   = total ? static_cast<uint32_t>(share / total) : 0;
+            slice.build     = 0.0;
+            slice.exchange  = 0.0;
+            remainders[i++] = total ? share % total : 1;
+
+            sum += slice.threads;
+        }
+
+        while (sum < threads) {
+            const size_t index = static_cast<size_t>(std::max_element(remainders.begin(), remainders.end()) - remainders.begin());
+
+            m_slices[index].threads++;
+            remainders[index] = 0;
+            ++sum;
+        }
+
+        uint32_t start = 0;
+        uint32_t count = 0;
+
+        for (auto &slice : m_slices) {
+            count += slice.threads;
+
+            const uint32_t end = static_cast<uint32_t>(static_cast<uint64_t>(m_items) * count / sum);
+            slice.start        = start;
+            slice.count        = end - start;
+            start              = end;
+        }
+    }
+
+
+    // Picks the strategy for the next epoch from the item rate and exchange bandwidth measured so far:
+    // a distributed build pays for the exchange, independent builds pay for building all items on every node.
+    void choose()
+    {
+        double distributed = 0.0;
+        double exchange    = 0.0;
+        double independent = 0.0;
+
+        for (const auto &slice : m_slices) {
+            if (slice.rate <= 0.0 || slice.bandwidth <= 0.0) {
+                m_independent = false;
+
+                return;
+            }
+
+            distributed = std::max(distributed, slice.count / slice.rate);
+            exchange    = std::max(exchange, (m_items - slice.count) * static_cast<double>(RANDOMX_DATASET_ITEM_SIZE) / slice.bandwidth);
+            independent = std::max(independent, m_items / slice.rate);
+        }
+
+        const bool value = independent < distributed + exchange;
+        if (value != m_independent) {
+            LOG_INFO("%s" CYAN_BOLD("-- ") "switching to %s dataset builds" BLACK_BOLD(" (predicted %.0f ms vs %.0f ms)"),
+                     Tags::randomx(), value ? "independent" : "distributed", value ? independent : distributed + exchange, value ? distributed + exchange : independent);
+        }
+
+        m_independent = value;
     }
 
 
@@ -320,11 +703,17 @@ private:
 
 
     bool m_allocated        = false;
+    bool m_independent      = false;
+    bool m_light            = false;
     bool m_ready            = false;
+    double m_alloc          = 0.0;
     RxCache *m_cache        = nullptr;
     RxSeed m_seed;
+    mutable std::map<uint32_t, std::pair<uint64_t, uint64_t> > m_hits;
     std::map<uint32_t, RxDataset *> m_datasets;
+    std::vector<Slice> m_slices;
     std::vector<std::thread> m_threads;
+    uint32_t m_items        = 0;
     std::vector<uint32_t> m_nodeset;
 };
 
@@ -370,11 +759,21 @@ xmrig::RxDataset *xmrig::RxNUMAStorage::dataset(const Job &job, uint32_t nodeId)
 }
 
 
-void xmrig::RxNUMAStorage::init(const RxSeed &seed, uint32_t threads, bool hugePages, bool oneGbPages, RxConfig::Mode, int priority)
+rapidjson::Value xmrig::RxNUMAStorage::toJSON(rapidjson::Document &doc) const
+{
+    if (!d_ptr->isAllocated()) {
+        return rapidjson::Value(rapidjson::kNullType);
+    }
+
+    return d_ptr->toJSON(doc);
+}
+
+
+void xmrig::RxNUMAStorage::init(const RxSeed &seed, uint32_t threads, bool hugePages, bool oneGbPages, RxConfig::Mode mode, int priority)
 {
     d_ptr->setSeed(seed);
 
-    if (!d_ptr->isAllocated() && !d_ptr->createDatasets(hugePages, oneGbPages)) {
+    if (!d_ptr->isAllocated() && !d_ptr->createDatasets(hugePages, oneGbPages, mode)) {
         return;
     }
 
@@ -19,11 +19,13 @@
  */
 
 #include "crypto/rx/RxQueue.h"
+#include "3rdparty/rapidjson/document.h"
 #include "backend/common/interfaces/IRxListener.h"
 #include "base/io/Async.h"
 #include "base/io/log/Log.h"
 #include "base/io/log/Tags.h"
 #include "base/tools/Cvt.h"
+#include "base/tools/Parking.h"
 #include "crypto/rx/RxBasicStorage.h"
 
 
@@ -66,6 +68,14 @@ xmrig::RxDataset *xmrig::RxQueue::dataset(const Job &job, uint32_t nodeId)
 }
 
 
+bool xmrig::RxQueue::isPending()
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    return m_state == STATE_PENDING;
+}
+
+
 xmrig::HugePagesInfo xmrig::RxQueue::hugePages()
 {
     std::lock_guard<std::mutex> lock(m_mutex);
@@ -74,6 +84,14 @@ xmrig::HugePagesInfo xmrig::RxQueue::hugePages()
 }
 
 
+rapidjson::Value xmrig::RxQueue::toJSON(rapidjson::Document &doc)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    return m_storage && m_state == STATE_IDLE ? m_storage->toJSON(doc) : rapidjson::Value(rapidjson::kNullType);
+}
+
+
 template<typename T>
 bool xmrig::RxQueue::isReady(const T &seed)
 {
@@ -158,6 +176,9 @@ void xmrig::RxQueue::backgroundInit()
         m_seed = item.seed;
         m_state = STATE_IDLE;
         m_async->send();
+
+        // Workers waiting for the dataset don't have to wait for the main loop.
+        Parking::wake();
     }
 }
 
@@ -22,6 +22,7 @@
 #define XMRIG_RX_QUEUE_H
 
 
+#include "3rdparty/rapidjson/fwd.h"
 #include "base/kernel/interfaces/IAsyncListener.h"
 #include "base/tools/Object.h"
 #include "crypto/common/HugePagesInfo.h"
@@ -74,8 +75,10 @@ public:
     RxQueue(IRxListener *listener);
     ~RxQueue() override;
 
+    bool isPending();
     HugePagesInfo hugePages();
     RxDataset *dataset(const Job &job, uint32_t nodeId);
+    rapidjson::Value toJSON(rapidjson::Document &doc);
     template<typename T> bool isReady(const T &seed);
     void enqueue(const RxSeed &seed, const std::vector<uint32_t> &nodeset, uint32_t threads, bool hugePages, bool oneGbPages, RxConfig::Mode mode, int priority);
 
@@ -0,0 +1,223 @@
+/* XMRig
+ * Copyright (c) 2018-2024 SChernykh   <https://github.com/SChernykh>
+ * Copyright (c) 2016-2024 XMRig       <https://github.com/xmrig>, <support@xmrig.com>
+ *
+ *   This program is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include "crypto/rx/RxScrubber.h"
+#include "3rdparty/rapidjson/document.h"
+#include "base/io/log/Log.h"
+#include "base/io/log/Tags.h"
+#include "base/kernel/Platform.h"
+#include "base/tools/Chrono.h"
+#include "crypto/randomx/dataset.hpp"
+#include "crypto/randomx/randomx.h"
+#include "crypto/rx/RxCache.h"
+
+
+#include <algorithm>
+#include <cinttypes>
+#include <cstring>
+#include <random>
+#include <vector>
+
+
+namespace xmrig {
+
+
+constexpr uint64_t kInterval = 100;
+
+std::atomic<uint32_t> RxScrubber::m_rate{ 0 };
+
+// Live scrubbers for the API, one per dataset copy.
+static std::mutex scrubbersMutex;
+static std::vector<const RxScrubber *> scrubbers;
+
+
+// Workers read the item while it is written, the dataset is only ever accessed in aligned 64-bit words,
+// so store it word by word with atomic stores and no reader sees a torn word.
+static inline void storeItem(uint8_t *dst, const uint8_t *src)
+{
+    auto d = reinterpret_cast<uint64_t *>(dst);
+    auto s = reinterpret_cast<const uint64_t *>(src);
+
+    for (size_t i = 0; i < RANDOMX_DATASET_ITEM_SIZE / sizeof(uint64_t); ++i) {
+#       ifdef _MSC_VER
+        *reinterpret_cast<volatile uint64_t *>(d + i) = s[i];
+#       else
+        __atomic_store_n(d + i, s[i], __ATOMIC_RELAXED);
+#       endif
+    }
+
+    std::atomic_thread_fence(std::memory_order_release);
+}
+
+
+} // namespace xmrig
+
+
+xmrig::RxScrubber::RxScrubber(RxCache *cache, void *dataset, uint32_t node) :
+    m_node(node),
+    m_cache(cache),
+    m_dataset(static_cast<uint8_t *>(dataset))
+{
+    {
+        std::lock_guard<std::mutex> lock(scrubbersMutex);
+        scrubbers.push_back(this);
+    }
+
+    m_thread = std::thread(&RxScrubber::run, this);
+}
+
+
+xmrig::RxScrubber::~RxScrubber()
+{
+    {
+        std::lock_guard<std::mutex> lock(scrubbersMutex);
+        scrubbers.erase(std::remove(scrubbers.begin(), scrubbers.end(), this), scrubbers.end());
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_stop = true;
+    }
+
+    m_cv.notify_one();
+    m_thread.join();
+}
+
+
+rapidjson::Value xmrig::RxScrubber::toJSON(rapidjson::Document &doc)
+{
+    using namespace rapidjson;
+    auto &allocator = doc.GetAllocator();
+
+    uint64_t checked    = 0;
+    uint64_t repaired   = 0;
+    uint64_t unstable   = 0;
+    uint64_t lastRepair = 0;
+
+    Value nodes(kArrayType);
+
+    {
+        std::lock_guard<std::mutex> lock(scrubbersMutex);
+
+        for (const RxScrubber *scrubber : scrubbers) {
+            checked    += scrubber->m_checked.load(std::memory_order_relaxed);
+            repaired   += scrubber->m_repaired.load(std::memory_order_relaxed);
+            unstable   += scrubber->m_unstable.load(std::memory_order_relaxed);
+            lastRepair  = std::max(lastRepair, scrubber->m_lastRepair.load(std::memory_order_relaxed));
+
+            nodes.PushBack(scrubber->nodeToJSON(doc), allocator);
+        }
+    }
+
+    Value out(kObjectType);
+    out.AddMember("rate",       rate(), allocator);
+    out.AddMember("checked",    checked, allocator);
+    out.AddMember("repaired",   repaired, allocator);
+    out.AddMember("unstable",   unstable, allocator);
+    out.AddMember("alarm",      repaired > 0, allocator);
+    out.AddMember("last_repair", lastRepair ? Value(lastRepair) : Value(kNullType), allocator);
+    out.AddMember("nodes",      nodes, allocator);
+
+    return out;
+}
+
+
+rapidjson::Value xmrig::RxScrubber::nodeToJSON(rapidjson::Document &doc) const
+{
+    using namespace rapidjson;
+    auto &allocator = doc.GetAllocator();
+
+    const uint64_t repaired   = m_repaired.load(std::memory_order_relaxed);
+    const uint64_t lastRepair = m_lastRepair.load(std::memory_order_relaxed);
+
+    Value out(kObjectType);
+    out.AddMember("node",       m_node, allocator);
+    out.AddMember("checked",    m_checked.load(std::memory_order_relaxed), allocator);
+    out.AddMember("repaired",   repaired, allocator);
+    out.AddMember("unstable",   m_unstable.load(std::memory_order_relaxed), allocator);
+    out.AddMember("alarm",      repaired > 0, allocator);
+    out.AddMember("last_repair", lastRepair ? Value(lastRepair) : Value(kNullType), allocator);
+
+    return out;
+}
+
+
+void xmrig::RxScrubber::verify(uint64_t item)
+{
+    alignas(64) uint8_t expected[RANDOMX_DATASET_ITEM_SIZE];
+    uint8_t *actual = m_dataset + item * RANDOMX_DATASET_ITEM_SIZE;
+
+    randomx::initDatasetItem(m_cache->get(), expected, item);
+    m_checked.fetch_add(1, std::memory_order_relaxed);
+
+    if (memcmp(actual, expected, sizeof(expected)) == 0) {
+        return;
+    }
+
+    // A second computation rules out an error in the scrubber itself (unstable CPU, overclock) before anything is written.
+    alignas(64) uint8_t confirm[RANDOMX_DATASET_ITEM_SIZE];
+    randomx::initDatasetItem(m_cache->get(), confirm, item);
+
+    if (memcmp(expected, confirm, sizeof(expected)) != 0) {
+        m_unstable.fetch_add(1, std::memory_order_relaxed);
+
+        LOG_WARN("%s" YELLOW_BOLD("dataset item %" PRIu64 " on node %u could not be verified, results are not stable"), Tags::randomx(), item, m_node);
+
+        return;
+    }
+
+    storeItem(actual, expected);
+
+    m_repaired.fetch_add(1, std::memory_order_relaxed);
+    m_lastRepair.store(Chrono::currentMSecsSinceEpoch(), std::memory_order_relaxed);
+
+    LOG_ERR("%s" RED_BOLD("dataset item %" PRIu64 " on node %u was corrupted and has been repaired") " (memory errors are likely)", Tags::randomx(), item, m_node);
+}
+
+
+void xmrig::RxScrubber::run()
+{
+    Platform::setThreadPriority(0);
+
+    std::mt19937_64 rng(std::random_device{}());
+    std::uniform_int_distribution<uint64_t> dist(0, randomx_dataset_item_count() - 1);
+
+    double budget = 0.0;
+    uint64_t ts   = Chrono::steadyMSecs();
+
+    std::unique_lock<std::mutex> lock(m_mutex);
+
+    while (!m_cv.wait_for(lock, std::chrono::milliseconds(kInterval), [this] { return m_stop.load(); })) {
+        lock.unlock();
+
+        const uint64_t now = Chrono::steadyMSecs();
+
+        // The budget is capped to one second worth of items, so time lost to starvation at idle priority is not made up in a burst.
+        const uint32_t rate = this->rate();
+
+        budget = std::min(budget + static_cast<double>(now - ts) * rate / 1000.0, static_cast<double>(rate));
+        ts     = now;
+
+        for (; budget >= 1.0 && !m_stop; budget -= 1.0) {
+            verify(dist(rng));
+        }
+
+        lock.lock();
+    }
+}
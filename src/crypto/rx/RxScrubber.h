@@ -0,0 +1,84 @@
+/* XMRig
+ * Copyright (c) 2018-2024 SChernykh   <https://github.com/SChernykh>
+ * Copyright (c) 2016-2024 XMRig       <https://github.com/xmrig>, <support@xmrig.com>
+ *
+ *   This program is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef XMRIG_RX_SCRUBBER_H
+#define XMRIG_RX_SCRUBBER_H
+
+
+#include "3rdparty/rapidjson/fwd.h"
+#include "base/tools/Object.h"
+
+
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+
+
+namespace xmrig
+{
+
+
+class RxCache;
+
+
+/**
+ * Background dataset verification for machines without ECC memory: randomly sampled items are
+ * recomputed from the cache at idle priority and repaired in place if they do not match.
+ *
+ * There is one scrubber per dataset copy (NUMA node), it lives as long as the dataset content,
+ * so its counters start from zero for every new dataset.
+ */
+class RxScrubber
+{
+public:
+    XMRIG_DISABLE_COPY_MOVE_DEFAULT(RxScrubber)
+
+    RxScrubber(RxCache *cache, void *dataset, uint32_t node);
+    ~RxScrubber();
+
+    static inline uint32_t rate()               { return m_rate.load(std::memory_order_relaxed); }
+    static inline void setRate(uint32_t rate)   { m_rate.store(rate, std::memory_order_relaxed); }
+
+    static rapidjson::Value toJSON(rapidjson::Document &doc);
+
+private:
+    rapidjson::Value nodeToJSON(rapidjson::Document &doc) const;
+    void verify(uint64_t item);
+    void run();
+
+    static std::atomic<uint32_t> m_rate;
+
+    const uint32_t m_node;
+    RxCache *m_cache;
+    std::atomic<uint64_t> m_checked{ 0 };
+    std::atomic<uint64_t> m_lastRepair{ 0 };
+    std::atomic<uint64_t> m_repaired{ 0 };
+    std::atomic<uint64_t> m_unstable{ 0 };
+    uint8_t *m_dataset;
+    std::atomic<bool> m_stop{ false };
+    std::condition_variable m_cv;
+    std::mutex m_mutex;
+    std::thread m_thread;
+};
+
+
+} /* namespace xmrig */
+
+
+#endif /* XMRIG_RX_SCRUBBER_H */
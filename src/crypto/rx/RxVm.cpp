@@ -20,12 +20,27 @@
 
 #include "crypto/randomx/randomx.h"
 #include "backend/cpu/Cpu.h"
+#include "base/io/log/Log.h"
+#include "base/io/log/Tags.h"
 #include "crypto/rx/RxCache.h"
 #include "crypto/rx/RxDataset.h"
 #include "crypto/rx/RxVm.h"
 
 
-randomx_vm *xmrig::RxVm::create(RxDataset *dataset, uint8_t *scratchpad, bool softAes, const Assembly &assembly, uint32_t node)
+namespace xmrig {
+
+
+#if (defined(XMRIG_FEATURE_ASM) && (defined(_M_X64) || defined(__x86_64__))) || defined(__aarch64__)
+constexpr bool kJitCompiler = true;
+#else
+constexpr bool kJitCompiler = false;
+#endif
+
+
+} // namespace xmrig
+
+
+randomx_vm *xmrig::RxVm::create(RxDataset *dataset, uint8_t *scratchpad, bool softAes, const Assembly &assembly, uint32_t node, bool light, bool interpreter, bool jit)
 {
     int flags = 0;
 
@@ -38,11 +53,18 @@ randomx_vm *xmrig::RxVm::create(RxDataset *dataset, uint8_t *scratchpad, bool so
        flags |= RANDOMX_FLAG_HARD_AES;
     }
 
-    if (dataset->get()) {
+    // Light VM on top of a ready dataset is possible only if the dataset keeps its cache.
+    const bool fullMem = dataset->get() && !(light && dataset->cache() && dataset->cache()->get());
+    if (fullMem) {
         flags |= RANDOMX_FLAG_FULL_MEM;
     }
 
-    if (!dataset->cache() || dataset->cache()->isJIT()) {
+    if (jit && !kJitCompiler) {
+        LOG_ERR("%s" RED("JIT VM variant requested, but this build has no RandomX JIT compiler, using the interpreter"), Tags::randomx());
+    }
+
+    // An explicit "jit" variant doesn't depend on the cache, it may have fallen back to the interpreter for dataset init only.
+    if (!interpreter && ((jit && kJitCompiler) || !dataset->cache() || dataset->cache()->isJIT())) {
         flags |= RANDOMX_FLAG_JIT;
     }
 
@@ -51,7 +73,14 @@ randomx_vm *xmrig::RxVm::create(RxDataset *dataset, uint8_t *scratchpad, bool so
         flags |= RANDOMX_FLAG_AMD;
     }
 
-    return randomx_create_vm(static_cast<randomx_flags>(flags), !dataset->get() ? dataset->cache()->get() : nullptr, dataset->get(), scratchpad, node);
+    randomx_vm *vm = randomx_create_vm(static_cast<randomx_flags>(flags), !fullMem ? dataset->cache()->get() : nullptr, fullMem ? dataset->get() : nullptr, scratchpad, node);
+    if (!vm && jit && (flags & RANDOMX_FLAG_JIT)) {
+        LOG_ERR("%s" RED("failed to create JIT VM, using the interpreter"), Tags::randomx());
+
+        vm = randomx_create_vm(static_cast<randomx_flags>(flags & ~RANDOMX_FLAG_JIT), !fullMem ? dataset->cache()->get() : nullptr, fullMem ? dataset->get() : nullptr, scratchpad, node);
+    }
+
+    return vm;
 }
 
 
@@ -55,6 +55,8 @@
 #endif
 
 
+#include <algorithm>
+#include <atomic>
 #include <cassert>
 #include <list>
 #include <memory>
@@ -220,6 +222,15 @@ public:
     }
 
 
+    inline void submit(const std::vector<JobResult> &results)
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_results.insert(m_results.end(), results.begin(), results.end());
+
+        m_async->send();
+    }
+
+
 #   if defined(XMRIG_FEATURE_OPENCL) || defined(XMRIG_FEATURE_CUDA)
     inline void submit(const Job &job, uint32_t *results, size_t count, uint32_t device_index)
     {
@@ -304,11 +315,25 @@ private:
 
 
 static JobResultsPrivate *handler = nullptr;
+static std::atomic<uint64_t> batchCount{ 0 };     // hand-offs of shares to the main loop, each one takes the lock and sends a wake-up
+static std::atomic<uint64_t> shareCount{ 0 };
 
 
 } // namespace xmrig
 
 
+uint64_t xmrig::JobResults::batches()
+{
+    return batchCount.load(std::memory_order_relaxed);
+}
+
+
+uint64_t xmrig::JobResults::shares()
+{
+    return shareCount.load(std::memory_order_relaxed);
+}
+
+
 void xmrig::JobResults::done(const Job &job)
 {
     submit(JobResult(job));
@@ -350,15 +375,42 @@ void xmrig::JobResults::submit(const JobResult &result)
     assert(handler != nullptr);
 
     if (handler) {
+        // done() markers carry no share and are not counted as batches.
+        if (result.diff) {
+            batchCount.fetch_add(1, std::memory_order_relaxed);
+            shareCount.fetch_add(1, std::memory_order_relaxed);
+        }
+
         handler->submit(result);
     }
 }
 
 
+void xmrig::JobResults::submit(const std::vector<JobResult> &results)
+{
+    assert(handler != nullptr);
+
+    if (handler && !results.empty()) {
+        const auto shares = static_cast<uint64_t>(std::count_if(results.begin(), results.end(), [](const JobResult &result) { return result.diff != 0; }));
+        if (shares) {
+            batchCount.fetch_add(1, std::memory_order_relaxed);
+            shareCount.fetch_add(shares, std::memory_order_relaxed);
+        }
+
+        handler->submit(results);
+    }
+}
+
+
 #if defined(XMRIG_FEATURE_OPENCL) || defined(XMRIG_FEATURE_CUDA)
 void xmrig::JobResults::submit(const Job &job, uint32_t *results, size_t count, uint32_t device_index)
 {
     if (handler) {
+        if (count) {
+            batchCount.fetch_add(1, std::memory_order_relaxed);
+            shareCount.fetch_add(count, std::memory_order_relaxed);
+        }
+
         handler->submit(job, results, count, device_index);
     }
 }
@@ -72,6 +72,11 @@ xmrig::Network::Network(Controller *controller) :
     const Pools &pools = controller->config()->pools();
     m_strategy = pools.createStrategy(m_state);
 
+    if (pools.coActive() > 0) {
+        m_coState    = new NetworkState(this);
+        m_coStrategy = pools.createCoStrategy(m_coState);
+    }
+
     if (pools.donateLevel() > 0) {
         m_donate = new DonateStrategy(controller, this);
     }
@@ -87,13 +92,19 @@ xmrig::Network::~Network()
     delete m_timer;
     delete m_donate;
     delete m_strategy;
+    delete m_coStrategy;
     delete m_state;
+    delete m_coState;
 }
 
 
 void xmrig::Network::connect()
 {
     m_strategy->connect();
+
+    if (m_coStrategy) {
+        m_coStrategy->connect();
+    }
 }
 
 
@@ -103,11 +114,19 @@ void xmrig::Network::execCommand(char command)
     case 's':
     case 'S':
         m_state->printResults();
+
+        if (m_coState) {
+            m_coState->printResults();
+        }
         break;
 
     case 'c':
     case 'C':
         m_state->printConnection();
+
+        if (m_coState) {
+            m_coState->printConnection();
+        }
         break;
 
     default:
@@ -137,8 +156,8 @@ void xmrig::Network::onActive(IStrategy *strategy, IClient *client)
     }
 
     const char *tlsVersion = client->tlsVersion();
-    LOG_INFO("%s " WHITE_BOLD("use %s ") CYAN_BOLD("%s:%d%s ") GREEN_BOLD("%s") " " BLACK_BOLD("%s"),
-             Tags::network(), client->mode(), pool.host().data(), pool.port(), zmq_buf, tlsVersion ? tlsVersion : "", client->ip().data());
+    LOG_INFO("%s " WHITE_BOLD("use %s%s ") CYAN_BOLD("%s:%d%s ") GREEN_BOLD("%s") " " BLACK_BOLD("%s"),
+             Tags::network(), client->mode(), strategy == m_coStrategy ? MAGENTA_BOLD(" co-schedule") : "", pool.host().data(), pool.port(), zmq_buf, tlsVersion ? tlsVersion : "", client->ip().data());
 
     const char *fingerprint = client->tlsFingerprint();
     if (fingerprint != nullptr) {
@@ -155,16 +174,33 @@ void xmrig::Network::onConfigChanged(Config *config, Config *previousConfig)
 
     m_strategy->stop();
 
+    if (m_coStrategy) {
+        m_coStrategy->stop();
+    }
+
     config->pools().print();
 
     delete m_strategy;
     m_strategy = config->pools().createStrategy(m_state);
+
+    // The co-scheduled CPU partition is created with the miner, pools can't add one after start.
+    delete m_coStrategy;
+    m_coStrategy = m_coState ? config->pools().createCoStrategy(m_coState) : nullptr;
+
+    if (!m_coStrategy && m_coState) {
+        m_controller->miner()->setCoJob(Job());
+    }
+
     connect();
 }
 
 
 void xmrig::Network::onJob(IStrategy *strategy, IClient *client, const Job &job, const rapidjson::Value &)
 {
+    if (m_coStrategy && m_coStrategy == strategy) {
+        return setCoJob(client, job);
+    }
+
     if (m_donate && m_donate->isActive() && m_donate != strategy) {
         return;
     }
@@ -180,6 +216,14 @@ void xmrig::Network::onJobResult(const JobResult &result)
         return;
     }
 
+    if (result.index == 2) {
+        if (m_coStrategy) {
+            m_coStrategy->submit(result);
+        }
+
+        return;
+    }
+
     m_strategy->submit(result);
 }
 
@@ -210,6 +254,16 @@ void xmrig::Network::onLogin(IStrategy *, IClient *client, rapidjson::Document &
 
 void xmrig::Network::onPause(IStrategy *strategy)
 {
+    if (m_coStrategy && m_coStrategy == strategy) {
+        if (!m_coStrategy->isActive()) {
+            LOG_ERR("%s " RED("no active co-schedule pools, stop co-scheduled mining"), Tags::network());
+
+            m_controller->miner()->setCoJob(Job());
+        }
+
+        return;
+    }
+
     if (m_donate && m_donate == strategy) {
         LOG_NOTICE("%s " WHITE_BOLD("dev donate finished"), Tags::network());
         m_strategy->resume();
@@ -223,25 +277,26 @@ void xmrig::Network::onPause(IStrategy *strategy)
 }
 
 
-void xmrig::Network::onResultAccepted(IStrategy *, IClient *, const SubmitResult &result, const char *error)
+void xmrig::Network::onResultAccepted(IStrategy *strategy, IClient *, const SubmitResult &result, const char *error)
 {
-    uint64_t diff     = result.diff;
-    const char *scale = NetworkState::scaleDiff(diff);
+    uint64_t diff       = result.diff;
+    const char *scale   = NetworkState::scaleDiff(diff);
+    const auto *state   = (m_coStrategy && m_coStrategy == strategy) ? m_coState : m_state;
 
     if (error) {
         LOG_INFO("%s " RED_BOLD("rejected") " (%" PRId64 "/%" PRId64 ") diff " WHITE_BOLD("%" PRIu64 "%s") " " RED("\"%s\"") " " BLACK_BOLD("(%" PRIu64 " ms)"),
-                 backend_tag(result.backend), m_state->accepted(), m_state->rejected(), diff, scale, error, result.elapsed);
+                 backend_tag(result.backend), state->accepted(), state->rejected(), diff, scale, error, result.elapsed);
     }
     else {
         LOG_INFO("%s " GREEN_BOLD("accepted") " (%" PRId64 "/%" PRId64 ") diff " WHITE_BOLD("%" PRIu64 "%s") " " BLACK_BOLD("(%" PRIu64 " ms)"),
-                 backend_tag(result.backend), m_state->accepted(), m_state->rejected(), diff, scale, result.elapsed);
+                 backend_tag(result.backend), state->accepted(), state->rejected(), diff, scale, result.elapsed);
     }
 }
 
 
-void xmrig::Network::onVerifyAlgorithm(IStrategy *, const IClient *, const Algorithm &algorithm, bool *ok)
+void xmrig::Network::onVerifyAlgorithm(IStrategy *strategy, const IClient *, const Algorithm &algorithm, bool *ok)
 {
-    if (!m_controller->miner()->isEnabled(algorithm)) {
+    if (!m_controller->miner()->isEnabled(algorithm) || (strategy == m_coStrategy && algorithm.family() == Algorithm::RANDOM_X)) {
         *ok = false;
 
         return;
@@ -257,11 +312,24 @@ void xmrig::Network::onRequest(IApiRequest &request)
 
         getResults(request.reply(), request.doc(), request.version());
         getConnection(request.reply(), request.doc(), request.version());
+        getCoSchedule(request.reply(), request.doc(), request.version());
     }
 }
 #endif
 
 
+void xmrig::Network::setCoJob(IClient *client, const Job &job)
+{
+    uint64_t diff       = job.diff();
+    const char *scale   = NetworkState::scaleDiff(diff);
+
+    LOG_INFO("%s " MAGENTA_BOLD("new co-schedule job") " from " WHITE_BOLD("%s:%d") " diff " WHITE_BOLD("%" PRIu64 "%s") " algo " WHITE_BOLD("%s"),
+             Tags::network(), client->pool().host().data(), client->pool().port(), diff, scale, job.algorithm().name());
+
+    m_controller->miner()->setCoJob(job);
+}
+
+
 void xmrig::Network::setJob(IClient *client, const Job &job, bool donate)
 {
 #   ifdef XMRIG_FEATURE_BENCHMARK
@@ -305,6 +373,10 @@ void xmrig::Network::tick()
 
     m_strategy->tick(now);
 
+    if (m_coStrategy) {
+        m_coStrategy->tick(now);
+    }
+
     if (m_donate) {
         m_donate->tick(now);
     }
@@ -316,13 +388,37 @@ void xmrig::Network::tick()
 
 
 #ifdef XMRIG_FEATURE_API
+void xmrig::Network::getCoSchedule(rapidjson::Value &reply, rapidjson::Document &doc, int version) const
+{
+    using namespace rapidjson;
+    auto &allocator = doc.GetAllocator();
+
+    if (!m_coState) {
+        return;
+    }
+
+    if (!reply.HasMember("co-schedule")) {
+        reply.AddMember("co-schedule", Value(kObjectType), allocator);
+    }
+
+    auto &co = reply["co-schedule"];
+    co.AddMember("results",     m_coState->getResults(doc, version), allocator);
+    co.AddMember("connection",  m_coState->getConnection(doc, version), allocator);
+}
+
+
 void xmrig::Network::getConnection(rapidjson::Value &reply, rapidjson::Document &doc, int version) const
 {
     using namespace rapidjson;
     auto &allocator = doc.GetAllocator();
 
+    Value connection = m_state->getConnection(doc, version);
+    if (connection.IsObject()) {
+        connection.AddMember("endpoints", m_strategy->toJSON(doc), allocator);
+    }
+
     reply.AddMember("algo",         m_state->algorithm().toJSON(), allocator);
-    reply.AddMember("connection",   m_state->getConnection(doc, version), allocator);
+    reply.AddMember("connection",   connection, allocator);
 }
 
 
@@ -331,6 +427,13 @@ void xmrig::Network::getResults(rapidjson::Value &reply, rapidjson::Document &do
     using namespace rapidjson;
     auto &allocator = doc.GetAllocator();
 
-    reply.AddMember("results", m_state->getResults(doc, version), allocator);
+    Value results = m_state->getResults(doc, version);
+
+    Value handoff(kObjectType);
+    handoff.AddMember("shares",     JobResults::shares(), allocator);
+    handoff.AddMember("batches",    JobResults::batches(), allocator);
+
+    results.AddMember("handoff", handoff, allocator);
+    reply.AddMember("results", results, allocator);
 }
 #endif
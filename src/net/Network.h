@@ -49,7 +49,8 @@ public:
     Network(Controller *controller);
     ~Network() override;
 
-    inline IStrategy *strategy() const { return m_strategy; }
+    inline const NetworkState *state() const   { return m_state; }
+    inline IStrategy *strategy() const          { return m_strategy; }
 
     void connect();
     void execCommand(char command);
@@ -73,17 +74,21 @@ protected:
 private:
     constexpr static int kTickInterval = 1 * 1000;
 
+    void setCoJob(IClient *client, const Job &job);
     void setJob(IClient *client, const Job &job, bool donate);
     void tick();
 
 #   ifdef XMRIG_FEATURE_API
+    void getCoSchedule(rapidjson::Value &reply, rapidjson::Document &doc, int version) const;
     void getConnection(rapidjson::Value &reply, rapidjson::Document &doc, int version) const;
     void getResults(rapidjson::Value &reply, rapidjson::Document &doc, int version) const;
 #   endif
 
     Controller *m_controller;
+    IStrategy *m_coStrategy = nullptr;
     IStrategy *m_donate     = nullptr;
     IStrategy *m_strategy   = nullptr;
+    NetworkState *m_coState = nullptr;
     NetworkState *m_state   = nullptr;
     Timer *m_timer          = nullptr;
 };
@@ -115,6 +115,12 @@ int64_t xmrig::DonateStrategy::submit(const JobResult &result)
 }
 
 
+rapidjson::Value xmrig::DonateStrategy::toJSON(rapidjson::Document &) const
+{
+    return rapidjson::Value(rapidjson::kNullType);
+}
+
+
 void xmrig::DonateStrategy::connect()
 {
     m_proxy = createProxy();
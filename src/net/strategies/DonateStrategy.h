@@ -55,6 +55,7 @@ protected:
     inline void resume() override                                                                                      {}
 
     int64_t submit(const JobResult &result) override;
+    rapidjson::Value toJSON(rapidjson::Document &doc) const override;
     void connect() override;
     void setAlgo(const Algorithm &algo) override;
     void setProxy(const ProxyUrl &proxy) override;
@@ -0,0 +1,340 @@
+/* XMRig
+ * Copyright (c) 2018-2024 SChernykh   <https://github.com/SChernykh>
+ * Copyright (c) 2016-2024 XMRig       <https://github.com/xmrig>, <support@xmrig.com>
+ *
+ *   This program is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "net/telemetry/Telemetry.h"
+#include "backend/common/Hashrate.h"
+#include "backend/common/interfaces/IBackend.h"
+#include "base/io/Env.h"
+#include "base/io/log/Log.h"
+#include "base/io/log/Tags.h"
+#include "base/kernel/interfaces/IClient.h"
+#include "base/kernel/interfaces/IStrategy.h"
+#include "base/net/dns/Dns.h"
+#include "base/net/dns/DnsRecords.h"
+#include "base/net/dns/DnsRequest.h"
+#include "base/net/stratum/NetworkState.h"
+#include "base/tools/Chrono.h"
+#include "base/tools/Handle.h"
+#include "base/tools/Timer.h"
+#include "core/config/Config.h"
+#include "core/Controller.h"
+#include "core/Miner.h"
+#include "net/Network.h"
+
+
+#ifdef XMRIG_ALGO_RANDOMX
+#   include "crypto/rx/Rx.h"
+#endif
+
+
+#ifdef XMRIG_OS_LINUX
+#   include <fcntl.h>
+#   include <unistd.h>
+#endif
+
+
+#include <algorithm>
+#include <cinttypes>
+#include <climits>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+
+
+namespace xmrig {
+
+
+constexpr uint64_t kMaxBackoff      = 5 * 60 * 1000;   // ms, failed lookups are retried up to this far apart
+constexpr uint64_t kResolveInterval = 10 * 60 * 1000;  // ms, the collector address is refreshed this often
+
+
+#ifdef XMRIG_OS_LINUX
+// Hottest thermal zone in degrees Celsius, read with plain syscalls to stay allocation free.
+static double temperature()
+{
+    char path[64];
+    char buf[32];
+    int64_t max = INT64_MIN;
+
+    for (unsigned i = 0; i < 32; ++i) {
+        snprintf(path, sizeof(path), "/sys/class/thermal/thermal_zone%u/temp", i);
+
+        const int fd = open(path, O_RDONLY);
+        if (fd < 0) {
+            break;
+        }
+
+        const ssize_t size = read(fd, buf, sizeof(buf) - 1);
+        close(fd);
+
+        if (size > 0) {
+            buf[size] = '\0';
+            max = std::max<int64_t>(max, strtoll(buf, nullptr, 10));
+        }
+    }
+
+    return max == INT64_MIN ? -1.0 : static_cast<double>(max) / 1000.0;
+}
+#else
+static inline double temperature() { return -1.0; }
+#endif
+
+
+} // namespace xmrig
+
+
+xmrig::Telemetry::Telemetry(Controller *controller) :
+    m_controller(controller)
+{
+    controller->addListener(this);
+
+    start(controller->config()->telemetry());
+}
+
+
+xmrig::Telemetry::~Telemetry()
+{
+    stop();
+}
+
+
+void xmrig::Telemetry::onConfigChanged(Config *config, Config *previousConfig)
+{
+    if (config->telemetry() == previousConfig->telemetry()) {
+        return;
+    }
+
+    stop();
+    start(config->telemetry());
+}
+
+
+void xmrig::Telemetry::onResolved(const DnsRecords &records, int status, const char *error)
+{
+    m_dns.reset();
+
+    // On a failed lookup the last resolved address stays in use, only the first failure in a row is logged.
+    if (status < 0 && records.isEmpty()) {
+        if (m_backoff == 0) {
+            LOG_ERR("%s " RED("telemetry DNS error: ") RED_BOLD("\"%s\""), Tags::network(), error);
+        }
+
+        m_backoff   = m_backoff ? std::min(m_backoff * 2, kMaxBackoff) : m_config.interval();
+        m_resolveAt = Chrono::steadyMSecs() + m_backoff;
+
+        return;
+    }
+
+    const sockaddr *addr = records.get().addr(m_config.port());
+    memcpy(&m_addr, addr, addr->sa_family == AF_INET6 ? sizeof(sockaddr_in6) : sizeof(sockaddr_in));
+
+    m_ready     = true;
+    m_backoff   = 0;
+    m_resolveAt = Chrono::steadyMSecs() + kResolveInterval;
+}
+
+
+void xmrig::Telemetry::onTimer(const Timer *)
+{
+    if (Chrono::steadyMSecs() >= m_resolveAt) {
+        resolve();
+    }
+
+    if (!m_ready) {
+        return;
+    }
+
+    collect();
+    flush();
+}
+
+
+void xmrig::Telemetry::add(const char *name, double value, const char *type, int64_t index)
+{
+    char line[256];
+    int size = 0;
+
+    if (m_config.format() == TelemetryConfig::FORMAT_DOGSTATSD) {
+        size = index < 0 ? snprintf(line, sizeof(line), "%s.%s:%.2f|%s|#worker:%s\n", m_config.prefix().data(), name, value, type, m_worker)
+                         : snprintf(line, sizeof(line), "%s.%s:%.2f|%s|#worker:%s,thread:%" PRId64 "\n", m_config.prefix().data(), name, value, type, m_worker, index);
+    }
+    else {
+        size = index < 0 ? snprintf(line, sizeof(line), "%s.%s.%s:%.2f|%s\n", m_config.prefix().data(), m_worker, name, value, type)
+                         : snprintf(line, sizeof(line), "%s.%s.%s.%" PRId64 ":%.2f|%s\n", m_config.prefix().data(), m_worker, name, index, value, type);
+    }
+
+    if (size <= 0 || static_cast<size_t>(size) >= sizeof(line)) {
+        return;
+    }
+
+    if (m_size + static_cast<size_t>(size) > kMaxDatagram) {
+        flush();
+    }
+
+    memcpy(m_buf + m_size, line, static_cast<size_t>(size));
+    m_size += static_cast<size_t>(size);
+}
+
+
+void xmrig::Telemetry::collect()
+{
+    char name[64];
+    const Miner *miner = m_controller->miner();
+
+    for (IBackend *backend : miner->backends()) {
+        const Hashrate *hashrate = backend->hashrate();
+        if (!backend->isEnabled() || !hashrate) {
+            continue;
+        }
+
+        // The co-schedule backend is a second CPU backend, its series must not mix with the primary one.
+        const char *type = backend == miner->coBackend() ? "cpu-co" : backend->type().data();
+
+        snprintf(name, sizeof(name), "hashrate.%s", type);
+
+        const auto total = hashrate->calc(Hashrate::ShortInterval);
+        if (total.first) {
+            add(name, total.second, "g");
+        }
+
+        snprintf(name, sizeof(name), "hashrate.%s.thread", type);
+
+        for (size_t i = 0; i < hashrate->threads(); ++i) {
+            const auto h = hashrate->calc(i, Hashrate::ShortInterval);
+            if (h.first) {
+                add(name, h.second, "g", static_cast<int64_t>(i));
+            }
+        }
+    }
+
+    const NetworkState *state = m_controller->network()->state();
+    const auto &latencies     = state->latencies();
+
+    // Counters restart from zero with a new connection.
+    if (state->accepted() < m_accepted || state->rejected() < m_rejected || latencies.size() < m_latencies) {
+        m_accepted  = 0;
+        m_rejected  = 0;
+        m_latencies = 0;
+    }
+
+    add("shares.accepted", static_cast<double>(state->accepted() - m_accepted), "c");
+    add("shares.rejected", static_cast<double>(state->rejected() - m_rejected), "c");
+
+    for (size_t i = m_latencies; i < latencies.size(); ++i) {
+        add("shares.latency", latencies[i], "ms");
+    }
+
+    m_accepted  = state->accepted();
+    m_rejected  = state->rejected();
+    m_latencies = latencies.size();
+
+    const IStrategy *strategy = m_controller->network()->strategy();
+    if (strategy->isActive() && strategy->client()->rtt() > 0.0) {
+        add("pool.rtt", strategy->client()->rtt(), "g");
+    }
+
+#   ifdef XMRIG_ALGO_RANDOMX
+    const auto pages = Rx::hugePages();
+
+    add("randomx.pending", Rx::isPending() ? 1.0 : 0.0, "g");
+    add("randomx.huge_pages", pages.percent(), "g");
+#   endif
+
+    size_t rss = 0;
+    if (uv_resident_set_memory(&rss) == 0) {
+        add("memory.rss", static_cast<double>(rss), "g");
+    }
+
+    add("memory.free", static_cast<double>(uv_get_free_memory()), "g");
+
+    const double temp = temperature();
+    if (temp >= 0.0) {
+        add("temperature", temp, "g");
+    }
+}
+
+
+void xmrig::Telemetry::flush()
+{
+    if (!m_size) {
+        return;
+    }
+
+    uv_buf_t buf = uv_buf_init(m_buf, static_cast<unsigned int>(m_size));
+    m_size       = 0;
+
+    const int rc = uv_udp_try_send(m_udp, &buf, 1, reinterpret_cast<const sockaddr *>(&m_addr));
+    if (rc < 0 && rc != UV_EAGAIN && m_errors++ == 0) {
+        LOG_WARN("%s " YELLOW("telemetry send failed: ") YELLOW_BOLD("\"%s\""), Tags::network(), uv_strerror(rc));
+    }
+}
+
+
+void xmrig::Telemetry::resolve()
+{
+    // Cached records may be delivered before Dns::resolve returns, the deadline is set first so they can replace it.
+    m_resolveAt = UINT64_MAX;
+    m_dns       = Dns::resolve(m_config.host(), this);
+}
+
+
+void xmrig::Telemetry::start(const TelemetryConfig &config)
+{
+    m_config = config;
+
+    if (!m_config.isEnabled()) {
+        return;
+    }
+
+    const String worker = Env::expand(m_controller->config()->apiWorkerId());
+    snprintf(m_worker, sizeof(m_worker), "%s", worker.isEmpty() ? Env::hostname().data() : worker.data());
+
+    // Dots, colons and pipes are StatsD separators.
+    for (char *p = m_worker; *p; ++p) {
+        if (*p == '.' || *p == ':' || *p == '|' || *p == '#' || *p == ',' || *p == ' ') {
+            *p = '_';
+        }
+    }
+
+    m_udp = new uv_udp_t;
+    uv_udp_init(uv_default_loop(), m_udp);
+
+    resolve();
+    m_timer = new Timer(this, m_config.interval(), m_config.interval());
+
+    LOG_INFO("%s " WHITE_BOLD("telemetry ") CYAN_BOLD("%s") " to " CYAN_BOLD("udp://%s:%u") " every " WHITE_BOLD("%" PRIu64 "s"),
+             Tags::network(), m_config.formatName(), m_config.host().data(), m_config.port(), m_config.interval() / 1000);
+}
+
+
+void xmrig::Telemetry::stop()
+{
+    delete m_timer;
+    m_timer = nullptr;
+
+    m_dns.reset();
+
+    Handle::close(m_udp);
+    m_udp = nullptr;
+
+    m_ready     = false;
+    m_size      = 0;
+    m_errors    = 0;
+    m_backoff   = 0;
+    m_resolveAt = 0;
+}
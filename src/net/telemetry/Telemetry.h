@@ -0,0 +1,96 @@
+/* XMRig
+ * Copyright (c) 2018-2024 SChernykh   <https://github.com/SChernykh>
+ * Copyright (c) 2016-2024 XMRig       <https://github.com/xmrig>, <support@xmrig.com>
+ *
+ *   This program is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef XMRIG_TELEMETRY_H
+#define XMRIG_TELEMETRY_H
+
+
+#include <uv.h>
+
+
+#include "base/kernel/interfaces/IBaseListener.h"
+#include "base/kernel/interfaces/IDnsListener.h"
+#include "base/kernel/interfaces/ITimerListener.h"
+#include "base/tools/Object.h"
+#include "base/tools/String.h"
+#include "net/telemetry/TelemetryConfig.h"
+
+
+#include <memory>
+
+
+namespace xmrig {
+
+
+class Controller;
+class DnsRequest;
+class Timer;
+
+
+/**
+ * Pushes metrics to a StatsD compatible collector over UDP every "interval" seconds: hashrate per backend and
+ * per thread, shares and share latency, stratum round trip, RandomX dataset state, memory and temperature.
+ * Datagrams are built in a fixed buffer and sent with uv_udp_try_send, a sample allocates nothing.
+ * The collector host is resolved again every 10 minutes, a failed lookup is retried with backoff up to 5 minutes.
+ */
+class Telemetry : public IBaseListener, public IDnsListener, public ITimerListener
+{
+public:
+    XMRIG_DISABLE_COPY_MOVE_DEFAULT(Telemetry)
+
+    Telemetry(Controller *controller);
+    ~Telemetry() override;
+
+protected:
+    void onConfigChanged(Config *config, Config *previousConfig) override;
+    void onResolved(const DnsRecords &records, int status, const char *error) override;
+    void onTimer(const Timer *timer) override;
+
+private:
+    constexpr static size_t kMaxDatagram = 1400;
+
+    void add(const char *name, double value, const char *type, int64_t index = -1);
+    void collect();
+    void flush();
+    void resolve();
+    void start(const TelemetryConfig &config);
+    void stop();
+
+    Controller *m_controller;
+    bool m_ready                    = false;
+    char m_buf[kMaxDatagram]{};
+    char m_worker[64]{};
+    size_t m_size                   = 0;
+    sockaddr_storage m_addr{};
+    std::shared_ptr<DnsRequest> m_dns;
+    TelemetryConfig m_config;
+    Timer *m_timer                  = nullptr;
+    uint64_t m_accepted             = 0;
+    uint64_t m_backoff              = 0;
+    uint64_t m_errors               = 0;
+    uint64_t m_rejected             = 0;
+    uint64_t m_resolveAt            = 0;
+    size_t m_latencies              = 0;
+    uv_udp_t *m_udp                 = nullptr;
+};
+
+
+} // namespace xmrig
+
+
+#endif /* XMRIG_TELEMETRY_H */
@@ -0,0 +1,95 @@
+/* XMRig
+ * Copyright (c) 2018-2024 SChernykh   <https://github.com/SChernykh>
+ * Copyright (c) 2016-2024 XMRig       <https://github.com/xmrig>, <support@xmrig.com>
+ *
+ *   This program is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "net/telemetry/TelemetryConfig.h"
+#include "3rdparty/rapidjson/document.h"
+#include "base/io/json/Json.h"
+
+
+#include <algorithm>
+#include <cstring>
+
+
+namespace xmrig {
+
+
+const char *TelemetryConfig::kEnabled   = "enabled";
+const char *TelemetryConfig::kField     = "telemetry";
+const char *TelemetryConfig::kFormat    = "format";
+const char *TelemetryConfig::kHost      = "host";
+const char *TelemetryConfig::kInterval  = "interval";
+const char *TelemetryConfig::kPort      = "port";
+const char *TelemetryConfig::kPrefix    = "prefix";
+
+
+static const char *kDefaultHost     = "127.0.0.1";
+static const char *kDefaultPrefix   = "xmrig";
+static const char *kFormatNames[]   = { "statsd", "dogstatsd" };
+
+
+} // namespace xmrig
+
+
+xmrig::TelemetryConfig::TelemetryConfig(const rapidjson::Value &value)
+{
+    m_enabled  = Json::getBool(value, kEnabled, m_enabled);
+    m_host     = Json::getString(value, kHost, kDefaultHost);
+    m_prefix   = Json::getString(value, kPrefix, kDefaultPrefix);
+    m_port     = static_cast<uint16_t>(Json::getUint(value, kPort, m_port));
+    m_interval = std::max(Json::getUint(value, kInterval, m_interval), 1U);
+
+    const char *format = Json::getString(value, kFormat);
+    if (format && strcmp(format, kFormatNames[FORMAT_DOGSTATSD]) == 0) {
+        m_format = FORMAT_DOGSTATSD;
+    }
+}
+
+
+bool xmrig::TelemetryConfig::isEqual(const TelemetryConfig &other) const
+{
+    return m_enabled     == other.m_enabled
+        && m_format      == other.m_format
+        && m_host        == other.m_host
+        && m_prefix      == other.m_prefix
+        && m_port        == other.m_port
+        && m_interval    == other.m_interval;
+}
+
+
+const char *xmrig::TelemetryConfig::formatName() const
+{
+    return kFormatNames[m_format];
+}
+
+
+rapidjson::Value xmrig::TelemetryConfig::toJSON(rapidjson::Document &doc) const
+{
+    using namespace rapidjson;
+
+    auto &allocator = doc.GetAllocator();
+    Value obj(kObjectType);
+
+    obj.AddMember(StringRef(kEnabled),  m_enabled, allocator);
+    obj.AddMember(StringRef(kHost),     m_host.toJSON(), allocator);
+    obj.AddMember(StringRef(kPort),     m_port, allocator);
+    obj.AddMember(StringRef(kFormat),   StringRef(formatName()), allocator);
+    obj.AddMember(StringRef(kPrefix),   m_prefix.toJSON(), allocator);
+    obj.AddMember(StringRef(kInterval), m_interval, allocator);
+
+    return obj;
+}
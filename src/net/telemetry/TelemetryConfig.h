@@ -0,0 +1,76 @@
+/* XMRig
+ * Copyright (c) 2018-2024 SChernykh   <https://github.com/SChernykh>
+ * Copyright (c) 2016-2024 XMRig       <https://github.com/xmrig>, <support@xmrig.com>
+ *
+ *   This program is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef XMRIG_TELEMETRYCONFIG_H
+#define XMRIG_TELEMETRYCONFIG_H
+
+
+#include "3rdparty/rapidjson/fwd.h"
+#include "base/tools/String.h"
+
+
+namespace xmrig {
+
+
+class TelemetryConfig
+{
+public:
+    enum Format {
+        FORMAT_STATSD,
+        FORMAT_DOGSTATSD
+    };
+
+    static const char *kEnabled;
+    static const char *kField;
+    static const char *kFormat;
+    static const char *kHost;
+    static const char *kInterval;
+    static const char *kPort;
+    static const char *kPrefix;
+
+    TelemetryConfig() = default;
+    TelemetryConfig(const rapidjson::Value &value);
+
+    inline bool isEnabled() const           { return m_enabled && !m_host.isEmpty() && m_port > 0; }
+    inline const String &host() const       { return m_host; }
+    inline const String &prefix() const     { return m_prefix; }
+    inline Format format() const            { return m_format; }
+    inline uint16_t port() const            { return m_port; }
+    inline uint64_t interval() const        { return m_interval * 1000ULL; }
+
+    inline bool operator!=(const TelemetryConfig &other) const  { return !isEqual(other); }
+    inline bool operator==(const TelemetryConfig &other) const  { return isEqual(other); }
+
+    bool isEqual(const TelemetryConfig &other) const;
+    const char *formatName() const;
+    rapidjson::Value toJSON(rapidjson::Document &doc) const;
+
+private:
+    bool m_enabled          = false;
+    Format m_format         = FORMAT_STATSD;
+    String m_host;
+    String m_prefix;
+    uint16_t m_port         = 8125;
+    uint32_t m_interval     = 10;
+};
+
+
+} // namespace xmrig
+
+
+#endif /* XMRIG_TELEMETRYCONFIG_H */